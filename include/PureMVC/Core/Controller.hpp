@@ -19,16 +19,8 @@
 #define __PUREMVC_INCLUDE__
 #include "../PureMVC.hpp"
 #endif /* __PUREMVC_HPP__ */
-#if defined(PUREMVC_USES_TR1)
-#if defined(__GNUC__) || defined(__MINGW32__)
-#include <tr1/unordered_map>
-#else
-#include <unordered_map>
-#endif
-#else
-#include <map>
-#endif
 
+#include "FlatHashMap.hpp"
 #include "../Interfaces/IModel.hpp"
 #include "../Interfaces/ICommand.hpp"
 #include "../Interfaces/IObserver.hpp"
@@ -80,11 +72,7 @@ namespace PureMVC
         class PUREMVC_API Controller : public virtual IController
         {
         protected:
-#if defined(PUREMVC_USES_TR1)
-            typedef std::tr1::unordered_map<std::string, ICommand*> CommandMap;
-#else
-            typedef std::map<std::string, ICommand*> CommandMap;
-#endif
+            typedef FlatHashMap<ICommand*> CommandMap;
         protected:
             /**
              * Define iterator converter for getting notification name only.
@@ -152,10 +140,12 @@ namespace PureMVC
              * passing the unique key for this instance
              * <code>Controller::getInstance( key )</code>
              *
+             * @param key the Multiton key.
+             * @param capacity the expected sizes of the tables.
              * @throws Error Error if instance for this Multiton key has already been constructed
              *
              */
-            explicit Controller(std::string const& key = Controller::DEFAULT_KEY);
+            explicit Controller(std::string const& key = Controller::DEFAULT_KEY, CoreCapacity const& capacity = CoreCapacity());
 
         protected:
             // Support call virtual method in constructor of base class (Controller).
@@ -186,13 +176,14 @@ namespace PureMVC
              *
              */
             template<typename _DerivedType>
-            explicit Controller(_DerivedType* instance, std::string const& key = Controller::DEFAULT_KEY)
+            explicit Controller(_DerivedType* instance, std::string const& key = Controller::DEFAULT_KEY, CoreCapacity const& capacity = CoreCapacity())
                 : _multiton_key(key)
                 , _view(NULL)
             {
                 if (find(_multiton_key))
                     throw std::runtime_error(MULTITON_MSG);
                 insert(_multiton_key, this);
+                Controller::reserveCommands(capacity.commands);
                 instance->_DerivedType::initializeController();
             }
 
@@ -222,9 +213,12 @@ namespace PureMVC
             /**
              * <code>Controller</code> Multiton Factory method.
              *
+             * <P>
+             * An existing instance is grown to <code>capacity</code>.</P>
+             *
              * @return the Multiton instance of <code>Controller</code>
              */
-            static IController& getInstance(std::string const& key = Controller::DEFAULT_KEY);
+            static IController& getInstance(std::string const& key = Controller::DEFAULT_KEY, CoreCapacity const& capacity = CoreCapacity());
 
             /**
              * If an <code>ICommand</code> has previously been registered
@@ -251,6 +245,24 @@ namespace PureMVC
              */
             virtual void registerCommand(std::string const& notification_name, ICommand* command);
 
+            /**
+             * Register many <code>ICommand</code> instances under one lock.
+             *
+             * <P>
+             * The observers of the notification names without a command yet
+             * are registered with the <code>View</code> in one call.</P>
+             *
+             * @param notification_names the names of the <code>INotifications</code>, one per command.
+             * @param commands the <code>ICommand</code> instances.
+             * @param count the number of commands.
+             */
+            virtual void registerCommands(std::string const* notification_names, ICommand* const* commands, std::size_t count);
+
+            /**
+             * Grow the command table to hold <code>count</code> notification names.
+             */
+            virtual void reserveCommands(std::size_t count);
+
             /**
              * Check if a Command is registered for a given Notification
              *
@@ -275,6 +287,22 @@ namespace PureMVC
              */
             virtual ICommand& retrieveCommand(std::string const& notification_name);
 
+            /**
+             * Retrieve an <code>ICommand</code> instance from the <code>Controller</code> without throwing.
+             *
+             * @param notification_name the name of the <code>INotification</code>
+             * @return the <code>ICommand</code> instance, or <code>NULL</code> if none is registered.
+             */
+            virtual ICommand const* tryRetrieveCommand(std::string const& notification_name) const;
+
+            /**
+             * Retrieve an <code>ICommand</code> instance from the <code>Controller</code> without throwing.
+             *
+             * @param notification_name the name of the <code>INotification</code>
+             * @return the <code>ICommand</code> instance, or <code>NULL</code> if none is registered.
+             */
+            virtual ICommand* tryRetrieveCommand(std::string const& notification_name);
+
             /**
              * Remove a previously registered <code>ICommand</code> to <code>INotification</code> mapping.
              *
@@ -0,0 +1,283 @@
+//  FlatHashMap.hpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PUREMVC_CORE_FLAT_HASH_MAP_HPP__)
+#define __PUREMVC_CORE_FLAT_HASH_MAP_HPP__
+
+// STL include
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+// PureMVC include
+#if !defined(__PUREMVC_HPP__)
+#define __PUREMVC_INCLUDE__
+#include "../PureMVC.hpp"
+#endif /* __PUREMVC_HPP__ */
+
+namespace PureMVC
+{
+    namespace Core
+    {
+        /**
+         * Open addressing hash map from strings to values, holding the tables
+         * of the <code>Model</code>, <code>View</code> and <code>Controller</code>.
+         *
+         * <P>
+         * Node based maps allocate every entry apart and follow pointers on
+         * lookup. A <code>FlatHashMap</code> stores its entries back to back in
+         * a vector, indexed by a table of 8 byte slots holding 32 bits of the
+         * hash and the position of the entry. Slots are probed linearly, so a
+         * lookup reads one or two cache lines of slots, then the entry whose
+         * hash matches.</P>
+         *
+         * <P>
+         * Keys are looked up as <code>std::string</code> or as characters and
+         * a length, without building a string. Erasing moves the last entry
+         * into the hole and shifts the following slots back, so the table
+         * keeps no tombstones. Iterators walk the entries in insertion order
+         * until the first erase; inserting or erasing invalidates them.</P>
+         */
+        template<typename _Value>
+        class FlatHashMap
+        {
+        public:
+            typedef std::string key_type;
+            typedef _Value mapped_type;
+            typedef std::pair<std::string, _Value> value_type;
+            typedef typename std::vector<value_type>::iterator iterator;
+            typedef typename std::vector<value_type>::const_iterator const_iterator;
+        private:
+            // index is the position of the entry plus one, 0 for an empty slot
+            struct Slot
+            {
+                unsigned int hash;
+                unsigned int index;
+            };
+
+            enum { MIN_SLOTS = 8 };
+        private:
+            std::vector<value_type> _entries;
+            std::vector<Slot> _slots;
+            std::size_t _mask;
+        public:
+            /**
+             * Default constructor, allocates nothing.
+             */
+            FlatHashMap(void)
+                : _mask(0)
+            { }
+
+        public:
+            iterator begin(void)
+            {
+                return _entries.begin();
+            }
+
+            const_iterator begin(void) const
+            {
+                return _entries.begin();
+            }
+
+            iterator end(void)
+            {
+                return _entries.end();
+            }
+
+            const_iterator end(void) const
+            {
+                return _entries.end();
+            }
+
+            std::size_t size(void) const
+            {
+                return _entries.size();
+            }
+
+            bool empty(void) const
+            {
+                return _entries.empty();
+            }
+
+            /**
+             * Get number of slots.
+             */
+            std::size_t bucket_count(void) const
+            {
+                return _slots.size();
+            }
+
+            iterator find(std::string const& key)
+            {
+                return find(key.data(), key.size());
+            }
+
+            const_iterator find(std::string const& key) const
+            {
+                return find(key.data(), key.size());
+            }
+
+            iterator find(char const* key, std::size_t length)
+            {
+                std::size_t position = lookup(key, length, hashOf(key, length));
+                return position == notFound() ? _entries.end() : _entries.begin() + (_slots[position].index - 1);
+            }
+
+            const_iterator find(char const* key, std::size_t length) const
+            {
+                std::size_t position = lookup(key, length, hashOf(key, length));
+                return position == notFound() ? _entries.end() : _entries.begin() + (_slots[position].index - 1);
+            }
+
+            /**
+             * Insert an entry unless its key is present.
+             *
+             * @return the entry with the key, and true if it was inserted.
+             */
+            std::pair<iterator, bool> insert(value_type const& item)
+            {
+                unsigned int hash = hashOf(item.first.data(), item.first.size());
+                std::size_t position = lookup(item.first.data(), item.first.size(), hash);
+                if (position != notFound())
+                    return std::make_pair(_entries.begin() + (_slots[position].index - 1), false);
+                if ((_entries.size() + 1) * 4 > _slots.size() * 3)
+                    rehash(slotCount(_entries.size() + 1));
+                _entries.push_back(item);
+                place(hash, _entries.size());
+                return std::make_pair(_entries.end() - 1, true);
+            }
+
+            /**
+             * Get the value of the key, inserting a default one if absent.
+             */
+            _Value& operator[](std::string const& key)
+            {
+                iterator result = find(key);
+                if (result != _entries.end())
+                    return result->second;
+                return insert(value_type(key, _Value())).first->second;
+            }
+
+            void erase(iterator where)
+            {
+                std::size_t index = (std::size_t)(where - _entries.begin());
+                std::size_t last = _entries.size() - 1;
+                removeSlot(lookup(where->first.data(), where->first.size(), hashOf(where->first.data(), where->first.size())));
+                if (index != last)
+                {
+                    value_type& moved = _entries[last];
+                    std::size_t position = lookup(moved.first.data(), moved.first.size(), hashOf(moved.first.data(), moved.first.size()));
+                    _slots[position].index = (unsigned int)(index + 1);
+                    where->first.swap(moved.first);
+                    std::swap(where->second, moved.second);
+                }
+                _entries.pop_back();
+            }
+
+            void clear(void)
+            {
+                _entries.clear();
+                std::fill(_slots.begin(), _slots.end(), Slot());
+            }
+
+            /**
+             * Grow the table to hold <code>count</code> entries without rehashing.
+             */
+            void reserve(std::size_t count)
+            {
+                _entries.reserve(count);
+                std::size_t slots = slotCount(count);
+                if (slots > _slots.size())
+                    rehash(slots);
+            }
+        private:
+            static std::size_t notFound(void)
+            {
+                return ~(std::size_t)0;
+            }
+
+            // FNV-1a, with the high bits folded into the ones used as slot
+            static unsigned int hashOf(char const* key, std::size_t length)
+            {
+                unsigned int result = 2166136261U;
+                for (std::size_t i = 0; i < length; ++i)
+                {
+                    result ^= (unsigned char)key[i];
+                    result *= 16777619U;
+                }
+                return result ^ (result >> 16);
+            }
+
+            // Smallest power of two keeping the load under 3/4.
+            static std::size_t slotCount(std::size_t count)
+            {
+                std::size_t result = MIN_SLOTS;
+                while (result * 3 < count * 4)
+                    result *= 2;
+                return result;
+            }
+
+            std::size_t lookup(char const* key, std::size_t length, unsigned int hash) const
+            {
+                if (_slots.empty())
+                    return notFound();
+                for (std::size_t position = hash & _mask;; position = (position + 1) & _mask)
+                {
+                    Slot const& slot = _slots[position];
+                    if (slot.index == 0)
+                        return notFound();
+                    if (slot.hash != hash)
+                        continue;
+                    std::string const& candidate = _entries[slot.index - 1].first;
+                    if (candidate.size() == length && std::memcmp(candidate.data(), key, length) == 0)
+                        return position;
+                }
+            }
+
+            void place(unsigned int hash, std::size_t index)
+            {
+                std::size_t position = hash & _mask;
+                while (_slots[position].index != 0)
+                    position = (position + 1) & _mask;
+                _slots[position].hash = hash;
+                _slots[position].index = (unsigned int)index;
+            }
+
+            // Shifts back the slots probed past the removed one.
+            void removeSlot(std::size_t hole)
+            {
+                for (std::size_t next = (hole + 1) & _mask;; next = (next + 1) & _mask)
+                {
+                    Slot const& slot = _slots[next];
+                    if (slot.index == 0)
+                        break;
+                    std::size_t home = slot.hash & _mask;
+                    if (((next - home) & _mask) >= ((next - hole) & _mask))
+                    {
+                        _slots[hole] = slot;
+                        hole = next;
+                    }
+                }
+                _slots[hole] = Slot();
+            }
+
+            void rehash(std::size_t count)
+            {
+                std::vector<Slot> slots(count, Slot());
+                _slots.swap(slots);
+                _mask = count - 1;
+                for (std::size_t i = 0; i < _entries.size(); ++i)
+                    place(hashOf(_entries[i].first.data(), _entries[i].first.size()), i + 1);
+            }
+        };
+    }
+}
+
+#endif /* __PUREMVC_CORE_FLAT_HASH_MAP_HPP__ */
@@ -14,6 +14,8 @@
 #include <exception>
 #include <stdexcept>
 #include <cassert>
+#include <cstddef>
+#include <list>
 // PureMVC include
 #if !defined(__PUREMVC_HPP__)
 #define __PUREMVC_INCLUDE__
@@ -29,8 +31,11 @@
 #include <map>
 #endif
 
+#include "FlatHashMap.hpp"
 #include "../Interfaces/IModel.hpp"
 #include "../Interfaces/IProxy.hpp"
+#include "../Interfaces/IProxyFactory.hpp"
+#include "../Interfaces/IEvictable.hpp"
 #include "../Patterns/Iterator/Iterator.hpp"
 
 namespace PureMVC
@@ -39,6 +44,8 @@ namespace PureMVC
     {
         using Interfaces::IModel;
         using Interfaces::IProxy;
+        using Interfaces::IProxyFactory;
+        using Interfaces::IEvictable;
         using Interfaces::IAggregate;
         using Interfaces::IIterator;
 
@@ -71,10 +78,64 @@ namespace PureMVC
         class PUREMVC_API Model : public virtual IModel
         {
         protected:
+            // Names of the built evictable proxies, swept by the clock hand
+            typedef std::list<std::string> EvictionRing;
+            /**
+             * Build of a proxy by its factory, signalled when it ends.
+             *
+             * <P>
+             * Held by the building thread and by the threads waiting for it,
+             * as the factory may be removed meanwhile.</P>
+             */
+            struct ProxyBuild
+            {
+                Event done;
+                long volatile references;
+
+                ProxyBuild(void)
+                    : done(false)
+                    , references(1)
+                { }
+
+                void release(void)
+                {
+                    if (atomicDecrement(&references) == 0)
+                        delete this;
+                }
+            };
+            /**
+             * Factory waiting for the first use of its proxy.
+             */
+            struct ProxyFactoryEntry
+            {
+                IProxyFactory* factory;
+                // Id of the thread building the proxy, empty when idle
+                std::string builder;
+                // Build running, NULL when idle
+                ProxyBuild* build;
+                // Kept after the build to rebuild an evicted proxy
+                bool evictable;
+                // Evictable proxy registered, at position in the eviction ring
+                bool built;
+                // Used since the clock hand last passed
+                mutable bool referenced;
+                std::size_t memory_usage;
+                EvictionRing::iterator position;
+
+                ProxyFactoryEntry(void)
+                    : factory(NULL)
+                    , build(NULL)
+                    , evictable(false)
+                    , built(false)
+                    , referenced(false)
+                    , memory_usage(0)
+                { }
+            };
+            typedef FlatHashMap<IProxy*> ProxyMap;
 #if defined(PUREMVC_USES_TR1)
-            typedef std::tr1::unordered_map<std::string, IProxy*> ProxyMap;
+            typedef std::tr1::unordered_map<std::string, ProxyFactoryEntry> ProxyFactoryMap;
 #else
-            typedef std::map<std::string, IProxy*> ProxyMap;
+            typedef std::map<std::string, ProxyFactoryEntry> ProxyFactoryMap;
 #endif
         protected:
             /**
@@ -119,6 +180,15 @@ namespace PureMVC
             std::string const _multiton_key;
             // Mapping of proxyNames to IProxy instances
             ProxyMap _proxy_map;
+            // Mapping of proxyNames to factories of proxies not built yet
+            ProxyFactoryMap _proxy_factory_map;
+            // Changed every time a proxy is removed
+            long volatile _generation;
+            // Built evictable proxies in clock order
+            EvictionRing _eviction_ring;
+            EvictionRing::iterator _eviction_hand;
+            std::size_t _memory_usage;
+            std::size_t _memory_budget;
             // Synchronous access
             mutable FastMutex _synchronous_access;
         private:
@@ -139,10 +209,12 @@ namespace PureMVC
              * directly, but instead call the static Multiton
              * Factory method <code>Model.getInstance( multitonKey )</code>
              *
+             * @param key the Multiton key.
+             * @param capacity the expected sizes of the tables.
              * @throws Error Error if instance for this Multiton key instance has already been constructed
              *
              */
-            explicit Model(std::string const& key = PureMVC::Core::Model::DEFAULT_KEY);
+            explicit Model(std::string const& key = PureMVC::Core::Model::DEFAULT_KEY, CoreCapacity const& capacity = CoreCapacity());
 
         protected:
             /**
@@ -169,12 +241,17 @@ namespace PureMVC
              *
              */
             template<typename _DerivedType>
-            explicit Model(_DerivedType* instance, std::string const& key = PureMVC::Core::Model::DEFAULT_KEY)
+            explicit Model(_DerivedType* instance, std::string const& key = PureMVC::Core::Model::DEFAULT_KEY, CoreCapacity const& capacity = CoreCapacity())
                 : _multiton_key(key)
+                , _generation(0)
+                , _eviction_hand(_eviction_ring.end())
+                , _memory_usage(0)
+                , _memory_budget(~(std::size_t)0)
             {
                 if (find(key))
                     throw std::runtime_error(MULTITON_MSG);
                 insert(_multiton_key, this);
+                Model::reserveProxies(capacity.proxies);
                 instance->_DerivedType::initializeModel();
             }
 
@@ -195,9 +272,12 @@ namespace PureMVC
             /**
              * <code>Model</code> Multiton Factory method.
              *
+             * <P>
+             * An existing instance is grown to <code>capacity</code>.</P>
+             *
              * @return the instance for this Multiton key
              */
-            static IModel& getInstance(std::string const& key = PureMVC::Core::Model::DEFAULT_KEY);
+            static IModel& getInstance(std::string const& key = PureMVC::Core::Model::DEFAULT_KEY, CoreCapacity const& capacity = CoreCapacity());
 
             /**
              * Register an <code>IProxy</code> with the <code>Model</code>.
@@ -206,6 +286,70 @@ namespace PureMVC
              */
             virtual void registerProxy(IProxy* proxy);
 
+            /**
+             * Register many <code>IProxy</code> instances under one lock.
+             *
+             * @param proxies the <code>IProxy</code> instances to be held by the <code>Model</code>.
+             * @param count the number of proxies.
+             */
+            virtual void registerProxies(IProxy* const* proxies, std::size_t count);
+
+            /**
+             * Grow the proxy table to hold <code>count</code> proxies.
+             */
+            virtual void reserveProxies(std::size_t count);
+
+            /**
+             * Register an <code>IProxyFactory</code> building an <code>IProxy</code>
+             * on first use.
+             *
+             * <P>
+             * The first <code>retrieveProxy</code> or <code>tryRetrieveProxy</code>
+             * with <code>proxy_name</code> creates the proxy, registers it and
+             * deletes the factory. Concurrent callers wait until it is registered,
+             * so the proxy is created only once. <code>hasProxy</code> is true
+             * for the name but does not build the proxy. The factory is ignored
+             * if a proxy with this name is already registered, and replaces a
+             * factory registered earlier.</P>
+             *
+             * <P>
+             * Proxies not built yet are not listed by <code>listProxyNames</code>.
+             * <code>removeProxy</code> deletes the factory of a proxy not built yet
+             * and returns <code>NULL</code>.</P>
+             *
+             * @param proxy_name the name of the proxy built by the factory.
+             * @param factory the <code>IProxyFactory</code> to be held by the <code>Model</code>.
+             */
+            virtual void registerProxyFactory(std::string const& proxy_name, IProxyFactory* factory);
+
+            /**
+             * Register an <code>IProxyFactory</code> building an <code>IProxy</code>
+             * the <code>Model</code> may evict.
+             *
+             * <P>
+             * The proxy is built on first use like with
+             * <code>registerProxyFactory</code>, and the memory reported by its
+             * <code>IEvictable::getMemoryUsage</code> is charged to the memory
+             * budget. When the budget is exceeded, evictable proxies are chosen
+             * with the CLOCK approximation of LRU: a retrieval only marks the
+             * proxy as used, and the clock hand evicts the first proxy not used
+             * since its last pass. Evicted proxies are removed, receive
+             * <code>onRemove</code> and are deleted; the factory builds them again
+             * on the next access.</P>
+             *
+             * <P>
+             * The <code>Model</code> owns the evictable proxies, except the ones
+             * returned by <code>removeProxy</code>. Eviction deletes the proxy and
+             * changes the generation: a pointer to an evictable proxy is only
+             * valid while the generation is unchanged, which <code>ProxyRef</code>
+             * checks. Registering an <code>IProxy</code> with the same name drops
+             * the factory, then removes and deletes the proxy it built.</P>
+             *
+             * @param proxy_name the name of the proxy built by the factory.
+             * @param factory the <code>IProxyFactory</code> to be held by the <code>Model</code>.
+             */
+            virtual void registerEvictableProxyFactory(std::string const& proxy_name, IProxyFactory* factory);
+
             /**
              * Retrieve an <code>IProxy</code> from the <code>Model</code>.
              *
@@ -222,6 +366,31 @@ namespace PureMVC
              */
             virtual IProxy& retrieveProxy(std::string const& proxy_name);
 
+            /**
+             * Retrieve an <code>IProxy</code> instance from the <code>Model</code> without throwing.
+             *
+             * @param proxy_name the name of the <code>IProxy</code> instance to be retrieved.
+             * @return the <code>IProxy</code> instance, or <code>NULL</code> if none is registered.
+             */
+            virtual IProxy const* tryRetrieveProxy(std::string const& proxy_name) const;
+
+            /**
+             * Retrieve an <code>IProxy</code> instance from the <code>Model</code> without throwing.
+             *
+             * @param proxy_name the name of the <code>IProxy</code> instance to be retrieved.
+             * @return the <code>IProxy</code> instance, or <code>NULL</code> if none is registered.
+             */
+            virtual IProxy* tryRetrieveProxy(std::string const& proxy_name);
+
+            /**
+             * Retrieve an <code>IProxy</code> instance only if it is built,
+             * without building it nor marking it as used.
+             *
+             * @param proxy_name the name of the <code>IProxy</code> instance to be retrieved.
+             * @return the <code>IProxy</code> instance, or <code>NULL</code> if none is built.
+             */
+            virtual IProxy const* tryRetrieveBuiltProxy(std::string const& proxy_name) const;
+
             /**
              * Check if a Proxy is registered
              *
@@ -230,6 +399,30 @@ namespace PureMVC
              */
             virtual bool hasProxy(std::string const& proxy_name) const;
 
+            /**
+             * Get the generation of the <code>Model</code>, changed every time an
+             * <code>IProxy</code> is removed.
+             *
+             * @return the current generation.
+             */
+            virtual long getGeneration(void) const;
+
+            /**
+             * Set the memory budget of the evictable proxies in bytes, unlimited
+             * by default. Proxies are evicted until it is met.
+             */
+            virtual void setMemoryBudget(std::size_t budget);
+
+            /**
+             * Get the memory budget of the evictable proxies in bytes.
+             */
+            virtual std::size_t getMemoryBudget(void) const;
+
+            /**
+             * Get the memory charged by the evictable proxies in bytes.
+             */
+            virtual std::size_t getMemoryUsage(void) const;
+
             /**
              * Remove an <code>IProxy</code> from the <code>Model</code>.
              *
@@ -256,6 +449,12 @@ namespace PureMVC
              * Virtual destructor.
              */
             virtual ~Model(void);
+        private:
+            IProxy* createProxy(std::string const& proxy_name);
+            void dropProxyFactory(ProxyFactoryMap::iterator const& result);
+            IProxy* replaceProxyFactory(std::string const& proxy_name);
+            void addProxyFactory(std::string const& proxy_name, IProxyFactory* factory, bool evictable);
+            void evictProxies(std::string const* kept_name);
         };
     }
 }
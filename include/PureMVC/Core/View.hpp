@@ -14,21 +14,14 @@
 #include <exception>
 #include <cassert>
 #include <stdexcept>
+#include <vector>
 // PureMVC include
 #if !defined(__PUREMVC_HPP__)
 #define __PUREMVC_INCLUDE__
 #include "../PureMVC.hpp"
 #endif /* __PUREMVC_HPP__ */
-#if defined(PUREMVC_USES_TR1)
-#if defined(__GNUC__) || defined(__MINGW32__)
-#include <tr1/unordered_map>
-#else
-#include <unordered_map>
-#endif
-#else
-#include <map>
-#endif
 
+#include "FlatHashMap.hpp"
 #include "../Interfaces/IView.hpp"
 #include "../Interfaces/IObserver.hpp"
 #include "../Interfaces/INotification.hpp"
@@ -70,13 +63,10 @@ namespace PureMVC
         class PUREMVC_API View : public virtual IView
         {
         protected:
-#if defined(PUREMVC_USES_TR1)
-            typedef std::tr1::unordered_map<std::string, IMediator*> MediatorMap;
-            typedef std::tr1::unordered_multimap<std::string, IObserver*> ObserverMap;
-#else
-            typedef std::map<std::string, IMediator*> MediatorMap;
-            typedef std::multimap<std::string, IObserver*> ObserverMap;
-#endif
+            typedef FlatHashMap<IMediator*> MediatorMap;
+            // Observers of a notification name, in registration order
+            typedef std::vector<IObserver*> ObserverList;
+            typedef FlatHashMap<ObserverList> ObserverMap;
         protected:
             /*
              * Define iterator converter for getting mediator name only.
@@ -123,8 +113,14 @@ namespace PureMVC
             MediatorMap _mediator_map;
             // Mapping of Notification names to Observer lists
             ObserverMap _observer_map;
+            // Observers removed while notifications are dispatched
+            ObserverList _retired_observers;
+            // Number of notifications being dispatched
+            std::size_t _dispatch_count;
             // Synchronous access
             mutable FastMutex _synchronous_access;
+        private:
+            void endDispatch(void);
         private:
             View(View const&);
             View(IView const&);
@@ -143,10 +139,12 @@ namespace PureMVC
              * directly, but instead call the static Multiton
              * Factory method <code>View::getInstance(key)</code>
              *
+             * @param key the Multiton key.
+             * @param capacity the expected sizes of the tables.
              * @throws Error Error if instance for this Multiton key has already been constructed
              *
              */
-            explicit View(std::string const& key = PureMVC::Core::View::DEFAULT_KEY);
+            explicit View(std::string const& key = PureMVC::Core::View::DEFAULT_KEY, CoreCapacity const& capacity = CoreCapacity());
         protected:
             /**
              * Constructor.
@@ -172,12 +170,15 @@ namespace PureMVC
              *
              */
             template<typename _DerivedType>
-            explicit View(_DerivedType* instance, std::string const& key = PureMVC::Core::View::DEFAULT_KEY)
+            explicit View(_DerivedType* instance, std::string const& key = PureMVC::Core::View::DEFAULT_KEY, CoreCapacity const& capacity = CoreCapacity())
                 : _multiton_key(key)
+                , _dispatch_count(0)
             {
                 if (find(key))
                     throw std::runtime_error(MULTITON_MSG);
                 insert(_multiton_key, this);
+                View::reserveMediators(capacity.mediators);
+                View::reserveObservers(capacity.notifications);
                 instance->_DerivedType::initializeView();
             }
 
@@ -198,9 +199,12 @@ namespace PureMVC
             /**
              * View Singleton Factory method.
              *
+             * <P>
+             * An existing instance is grown to <code>capacity</code>.</P>
+             *
              * @return the Singleton instance of <code>View</code>
              */
-            static IView& getInstance(std::string const& key = PureMVC::Core::View::DEFAULT_KEY);
+            static IView& getInstance(std::string const& key = PureMVC::Core::View::DEFAULT_KEY, CoreCapacity const& capacity = CoreCapacity());
 
             /**
              * Register an <code>IObserver</code> to be notified
@@ -211,6 +215,20 @@ namespace PureMVC
              */
             virtual void registerObserver (std::string const& notification_name, IObserver* observer);
 
+            /**
+             * Register many <code>IObservers</code> under one lock.
+             *
+             * @param notification_names the names of the <code>INotifications</code>, one per observer.
+             * @param observers the <code>IObservers</code> to register.
+             * @param count the number of observers.
+             */
+            virtual void registerObservers(std::string const* notification_names, IObserver* const* observers, std::size_t count);
+
+            /**
+             * Grow the observer table to hold <code>count</code> notification names.
+             */
+            virtual void reserveObservers(std::size_t count);
+
             /**
              * Notify the <code>IObservers</code> for a particular <code>INotification</code>.
              *
@@ -249,6 +267,24 @@ namespace PureMVC
              */
             virtual void registerMediator(IMediator* mediator);
 
+            /**
+             * Register many <code>IMediator</code> instances.
+             *
+             * <P>
+             * The mediators are inserted under one lock, then the observers of
+             * all their interests under another. Mediators already registered
+             * by name are skipped.</P>
+             *
+             * @param mediators the <code>IMediator</code> instances.
+             * @param count the number of mediators.
+             */
+            virtual void registerMediators(IMediator* const* mediators, std::size_t count);
+
+            /**
+             * Grow the mediator table to hold <code>count</code> mediators.
+             */
+            virtual void reserveMediators(std::size_t count);
+
             /**
              * Retrieve an <code>IMediator</code> from the <code>View</code>.
              *
@@ -265,6 +301,22 @@ namespace PureMVC
              */
             virtual IMediator& retrieveMediator(std::string const& mediator_name);
 
+            /**
+             * Retrieve an <code>IMediator</code> instance from the <code>View</code> without throwing.
+             *
+             * @param mediator_name the name of the <code>IMediator</code> instance to retrieve.
+             * @return the <code>IMediator</code> instance, or <code>NULL</code> if none is registered.
+             */
+            virtual IMediator const* tryRetrieveMediator(std::string const& mediator_name) const;
+
+            /**
+             * Retrieve an <code>IMediator</code> instance from the <code>View</code> without throwing.
+             *
+             * @param mediator_name the name of the <code>IMediator</code> instance to retrieve.
+             * @return the <code>IMediator</code> instance, or <code>NULL</code> if none is registered.
+             */
+            virtual IMediator* tryRetrieveMediator(std::string const& mediator_name);
+
             /**
              * Remove an <code>IMediator</code> from the <code>View</code>.
              *
@@ -295,6 +347,22 @@ namespace PureMVC
              */
             static void removeView(std::string const& key);
 
+            /**
+             * Register an <code>IObserver</code> owned by the <code>IView</code>.
+             *
+             * <P>
+             * Like the observers created for mediators, the observer is deleted
+             * when it is removed, or with the <code>View</code> if it is still
+             * registered then. An observer removed while a notification is
+             * dispatched, even by its own <code>notifyObserver</code>, is
+             * deleted once no dispatch is in progress.</P>
+             *
+             * @param view the <code>IView</code> to register with.
+             * @param notification_name the name of the <code>INotifications</code> to notify this <code>IObserver</code> of
+             * @param observer the <code>IObserver</code> to register, created with <code>new</code>.
+             */
+            static void registerOwnedObserver(IView& view, std::string const& notification_name, IObserver* observer);
+
             /**
              * Virtual destructor.
              */
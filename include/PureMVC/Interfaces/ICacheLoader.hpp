@@ -0,0 +1,52 @@
+//  ICacheLoader.hpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PUREMVC_INTERFACES_ICACHE_LOADER_HPP__)
+#define __PUREMVC_INTERFACES_ICACHE_LOADER_HPP__
+
+// PureMVC include
+#if !defined(__PUREMVC_HPP__)
+#define __PUREMVC_INCLUDE__
+#include "../PureMVC.hpp"
+#endif /* __PUREMVC_HPP__ */
+
+namespace PureMVC
+{
+    namespace Interfaces
+    {
+        /**
+         * The interface definition for the backend of a <code>CachingProxy</code>.
+         *
+         * @see Patterns/Proxy/CachingProxy.hpp PureMVC::Patterns::CachingProxy
+         */
+        template<typename _Key, typename _Value>
+        struct ICacheLoader
+        {
+            /**
+             * Read the value of a key from the backend.
+             *
+             * <P>
+             * Called without lock, possibly from several threads for different
+             * keys. An exception is not cached: it is thrown to the caller
+             * which started the load.</P>
+             *
+             * @param key the key to read.
+             * @param value default constructed, set to the value read.
+             * @return false if the backend has no value for the key.
+             */
+            virtual bool load(_Key const& key, _Value& value) = 0;
+
+            /**
+             * Virtual destructor.
+             */
+            virtual ~ICacheLoader(void) { };
+        };
+    }
+}
+
+#endif /* __PUREMVC_INTERFACES_ICACHE_LOADER_HPP__ */
@@ -11,6 +11,7 @@
 
 // STL include
 #include <string>
+#include <cstddef>
 // PureMVC include
 #if !defined(__PUREMVC_HPP__)
 #define __PUREMVC_INCLUDE__
@@ -66,6 +67,25 @@ namespace PureMVC
              */
             virtual void registerCommand(std::string const& notification_name, ICommand* command) = 0;
 
+            /**
+             * Register many <code>ICommand</code> instances under one lock.
+             *
+             * <P>
+             * Same as calling <code>registerCommand</code> for each pair, the
+             * observers of the new notification names are registered with the
+             * <code>View</code> at once.</P>
+             *
+             * @param notification_names the names of the <code>INotifications</code>, one per command.
+             * @param commands the <code>ICommand</code> instances.
+             * @param count the number of commands.
+             */
+            virtual void registerCommands(std::string const* notification_names, ICommand* const* commands, std::size_t count) = 0;
+
+            /**
+             * Grow the command table to hold <code>count</code> notification names without rehashing.
+             */
+            virtual void reserveCommands(std::size_t count) = 0;
+
             /**
              * Execute the <code>ICommand</code> previously registered as the
              * handler for <code>INotification</code>s with the given notification name.
@@ -90,6 +110,27 @@ namespace PureMVC
              */
             virtual ICommand& retrieveCommand(std::string const& notification_name) = 0;
 
+            /**
+             * Retrieve an <code>ICommand</code> instance from the <code>Controller</code> without throwing.
+             *
+             * <P>
+             * Like <code>IView::tryRetrieveMediator</code>, it replaces
+             * <code>hasCommand</code> followed by <code>retrieveCommand</code>
+             * with one lookup under the lock.</P>
+             *
+             * @param notification_name the name of the <code>INotification</code>
+             * @return the <code>ICommand</code> instance, or <code>NULL</code> if none is registered.
+             */
+            virtual ICommand const* tryRetrieveCommand(std::string const& notification_name) const = 0;
+
+            /**
+             * Retrieve an <code>ICommand</code> instance from the <code>Controller</code> without throwing.
+             *
+             * @param notification_name the name of the <code>INotification</code>
+             * @return the <code>ICommand</code> instance, or <code>NULL</code> if none is registered.
+             */
+            virtual ICommand* tryRetrieveCommand(std::string const& notification_name) = 0;
+
             /**
              * Remove a previously registered <code>ICommand</code> to <code>INotification</code> mapping.
              *
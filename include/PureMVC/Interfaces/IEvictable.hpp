@@ -0,0 +1,50 @@
+//  IEvictable.hpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PUREMVC_INTERFACES_IEVICTABLE_HPP__)
+#define __PUREMVC_INTERFACES_IEVICTABLE_HPP__
+
+// STL include
+#include <cstddef>
+// PureMVC include
+#if !defined(__PUREMVC_HPP__)
+#define __PUREMVC_INCLUDE__
+#include "../PureMVC.hpp"
+#endif /* __PUREMVC_HPP__ */
+
+namespace PureMVC
+{
+    namespace Interfaces
+    {
+        /**
+         * The interface definition for a proxy the <code>IModel</code> may evict.
+         *
+         * <P>
+         * Proxies built by a factory registered with
+         * <code>IModel::registerEvictableProxyFactory</code> implement it, so
+         * the <code>IModel</code> can keep them within its memory budget.</P>
+         *
+         * @see Interfaces/IModel.hpp PureMVC::Interfaces::IModel
+         */
+        struct PUREMVC_API IEvictable
+        {
+            /**
+             * Get the memory held by the proxy in bytes, charged to the
+             * memory budget of the <code>IModel</code> when the proxy is built.
+             */
+            virtual std::size_t getMemoryUsage(void) const = 0;
+
+            /**
+             * Virtual destructor.
+             */
+            virtual ~IEvictable(void);
+        };
+    }
+}
+
+#endif /* __PUREMVC_INTERFACES_IEVICTABLE_HPP__ */
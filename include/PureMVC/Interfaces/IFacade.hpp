@@ -11,6 +11,7 @@
 
 // STL include
 #include <string>
+#include <cstddef>
 // PureMVC include
 #if !defined(__PUREMVC_HPP__)
 #define __PUREMVC_INCLUDE__
@@ -19,6 +20,7 @@
 
 #include "INotifier.hpp"
 #include "IProxy.hpp"
+#include "IProxyFactory.hpp"
 #include "ICommand.hpp"
 #include "IMediator.hpp"
 
@@ -54,6 +56,40 @@ namespace PureMVC
              */
             virtual void registerProxy(IProxy* proxy) = 0;
 
+            /**
+             * Register many <code>IProxy</code> instances with the <code>Model</code> at once.
+             *
+             * @param proxies the <code>IProxy</code> instances.
+             * @param count the number of proxies.
+             */
+            virtual void registerProxies(IProxy* const* proxies, std::size_t count) = 0;
+
+            /**
+             * Grow the tables of the <code>Model</code>, <code>View</code> and
+             * <code>Controller</code> to the given capacity.
+             *
+             * @param capacity the expected sizes of the tables.
+             */
+            virtual void reserve(CoreCapacity const& capacity) = 0;
+
+            /**
+             * Register an <code>IProxyFactory</code> with the <code>Model</code>,
+             * the proxy is built on first use.
+             *
+             * @param proxy_name the name of the proxy built by the factory.
+             * @param factory the <code>IProxyFactory</code> to be held by the <code>Model</code>.
+             */
+            virtual void registerProxyFactory(std::string const& proxy_name, IProxyFactory* factory) = 0;
+
+            /**
+             * Register an <code>IProxyFactory</code> with the <code>Model</code>,
+             * the proxy is built on first use and may be evicted.
+             *
+             * @param proxy_name the name of the proxy built by the factory.
+             * @param factory the <code>IProxyFactory</code> to be held by the <code>Model</code>.
+             */
+            virtual void registerEvictableProxyFactory(std::string const& proxy_name, IProxyFactory* factory) = 0;
+
             /**
              * Retrieve a <code>IProxy</code> from the <code>Model</code> by name.
              *
@@ -70,6 +106,22 @@ namespace PureMVC
              */
             virtual IProxy& retrieveProxy(std::string const& proxy_name) = 0;
 
+            /**
+             * Retrieve an <code>IProxy</code> instance from the <code>Model</code> without throwing.
+             *
+             * @param proxy_name the name of the <code>IProxy</code> instance to be retrieved.
+             * @return the <code>IProxy</code> instance, or <code>NULL</code> if none is registered.
+             */
+            virtual IProxy const* tryRetrieveProxy(std::string const& proxy_name) const = 0;
+
+            /**
+             * Retrieve an <code>IProxy</code> instance from the <code>Model</code> without throwing.
+             *
+             * @param proxy_name the name of the <code>IProxy</code> instance to be retrieved.
+             * @return the <code>IProxy</code> instance, or <code>NULL</code> if none is registered.
+             */
+            virtual IProxy* tryRetrieveProxy(std::string const& proxy_name) = 0;
+
             /**
              * Remove an <code>IProxy</code> instance from the <code>Model</code> by name.
              *
@@ -94,6 +146,15 @@ namespace PureMVC
              */
             virtual void registerCommand(std::string const& notification_name, ICommand* command) = 0;
 
+            /**
+             * Register many <code>ICommand</code> instances with the <code>Controller</code> at once.
+             *
+             * @param notification_names the names of the <code>INotifications</code>, one per command.
+             * @param commands the <code>ICommand</code> instances.
+             * @param count the number of commands.
+             */
+            virtual void registerCommands(std::string const* notification_names, ICommand* const* commands, std::size_t count) = 0;
+
             /**
              * Retrieve an <code>ICommand</code> instance from the Controller.
              *
@@ -110,6 +171,22 @@ namespace PureMVC
              */
             virtual ICommand& retrieveCommand(std::string const& notification_name) = 0;
 
+            /**
+             * Retrieve an <code>ICommand</code> instance from the <code>Controller</code> without throwing.
+             *
+             * @param notification_name the name of the <code>INotification</code>
+             * @return the <code>ICommand</code> instance, or <code>NULL</code> if none is registered.
+             */
+            virtual ICommand const* tryRetrieveCommand(std::string const& notification_name) const = 0;
+
+            /**
+             * Retrieve an <code>ICommand</code> instance from the <code>Controller</code> without throwing.
+             *
+             * @param notification_name the name of the <code>INotification</code>
+             * @return the <code>ICommand</code> instance, or <code>NULL</code> if none is registered.
+             */
+            virtual ICommand* tryRetrieveCommand(std::string const& notification_name) = 0;
+
             /**
              * Remove a previously registered <code>ICommand</code> to <code>INotification</code> mapping from the Controller.
              *
@@ -133,6 +210,14 @@ namespace PureMVC
              */
             virtual void registerMediator(IMediator* mediator) = 0;
 
+            /**
+             * Register many <code>IMediator</code> instances with the <code>View</code> at once.
+             *
+             * @param mediators the <code>IMediator</code> instances.
+             * @param count the number of mediators.
+             */
+            virtual void registerMediators(IMediator* const* mediators, std::size_t count) = 0;
+
             /**
              * Retrieve an <code>IMediator</code> instance from the <code>View</code>.
              *
@@ -149,6 +234,22 @@ namespace PureMVC
              */
             virtual IMediator& retrieveMediator(std::string const& mediator_name) = 0;
 
+            /**
+             * Retrieve an <code>IMediator</code> instance from the <code>View</code> without throwing.
+             *
+             * @param mediator_name the name of the <code>IMediator</code> instance to retrieve.
+             * @return the <code>IMediator</code> instance, or <code>NULL</code> if none is registered.
+             */
+            virtual IMediator const* tryRetrieveMediator(std::string const& mediator_name) const = 0;
+
+            /**
+             * Retrieve an <code>IMediator</code> instance from the <code>View</code> without throwing.
+             *
+             * @param mediator_name the name of the <code>IMediator</code> instance to retrieve.
+             * @return the <code>IMediator</code> instance, or <code>NULL</code> if none is registered.
+             */
+            virtual IMediator* tryRetrieveMediator(std::string const& mediator_name) = 0;
+
             /**
              * Remove a <code>IMediator</code> instance from the <code>View</code>.
              *
@@ -180,6 +281,37 @@ namespace PureMVC
              */
             virtual void notifyObservers(INotification const& notification) = 0;
 
+            /**
+             * Create and send an <code>INotification</code> after a delay.
+             *
+             * @param delay the number of milliseconds to wait.
+             * @param notification_name the name of the notification to send
+             * @param body the body of the notification (optional)
+             * @param type the type of the notification (optional)
+             * @return the identifier to give to <code>cancelNotification</code>.
+             */
+            virtual unsigned long sendNotificationAfter(long delay, std::string const& notification_name, void const* body = NULL, std::string const& type = "") = 0;
+
+            /**
+             * Create and send an <code>INotification</code> periodically.
+             *
+             * @param period the number of milliseconds between two notifications.
+             * @param notification_name the name of the notification to send
+             * @param body the body of the notification (optional)
+             * @param type the type of the notification (optional)
+             * @return the identifier to give to <code>cancelNotification</code>.
+             */
+            virtual unsigned long sendNotificationEvery(long period, std::string const& notification_name, void const* body = NULL, std::string const& type = "") = 0;
+
+            /**
+             * Cancel a delayed or periodic notification.
+             *
+             * @param timer_id the identifier returned by <code>sendNotificationAfter</code>
+             * or <code>sendNotificationEvery</code>.
+             * @return whether the notification was pending.
+             */
+            virtual bool cancelNotification(unsigned long timer_id) = 0;
+
             /**
              * Virtual destructor.
              */
@@ -11,6 +11,7 @@
 
 // STL include
 #include <string>
+#include <cstddef>
 // PureMVC include
 #if !defined(__PUREMVC_HPP__)
 #define __PUREMVC_INCLUDE__
@@ -96,6 +97,21 @@ namespace PureMVC
              */
             virtual NotificationNames listNotificationInterests(void) const = 0;
 
+            /**
+             * Get the <code>INotification</code> interests as a static array.
+             *
+             * <P>
+             * Used by the <code>IView</code> instead of
+             * <code>listNotificationInterests</code> when not <code>NULL</code>:
+             * walking the array allocates nothing. The array must stay unchanged
+             * while the <code>IMediator</code> is registered. The default
+             * returns <code>NULL</code>.</P>
+             *
+             * @param count set to the number of names in the array.
+             * @return the names, or <code>NULL</code> to use <code>listNotificationInterests</code>.
+             */
+            virtual std::string const* getNotificationInterests(std::size_t& count) const;
+
             /**
              * Handle an <code>INotification</code>.
              *
@@ -11,6 +11,7 @@
 
 // STL include
 #include <string>
+#include <cstddef>
 // PureMVC include
 #if !defined(__PUREMVC_HPP__)
 #define __PUREMVC_INCLUDE__
@@ -18,6 +19,8 @@
 #endif /* __PUREMVC_HPP__ */
 
 #include "IProxy.hpp"
+#include "IProxyFactory.hpp"
+#include "IEvictable.hpp"
 #include "IAggregate.hpp"
 
 namespace PureMVC
@@ -57,6 +60,58 @@ namespace PureMVC
              */
             virtual void registerProxy(IProxy* proxy) = 0;
 
+            /**
+             * Register many <code>IProxy</code> instances with the <code>Model</code>.
+             *
+             * <P>
+             * Same as calling <code>registerProxy</code> for each proxy, but
+             * the <code>Model</code> is locked and grown once for the whole
+             * range. <code>onRegister</code> is called after all the proxies
+             * are registered, in order.</P>
+             *
+             * @param proxies the proxies to be held by the <code>Model</code>.
+             * @param count the number of proxies.
+             */
+            virtual void registerProxies(IProxy* const* proxies, std::size_t count) = 0;
+
+            /**
+             * Grow the proxy table to hold <code>count</code> proxies without rehashing.
+             */
+            virtual void reserveProxies(std::size_t count) = 0;
+
+            /**
+             * Register an <code>IProxyFactory</code> building an <code>IProxy</code>
+             * on first use.
+             *
+             * <P>
+             * The proxy is created and registered by the first
+             * <code>retrieveProxy</code> or <code>tryRetrieveProxy</code> with its
+             * name; <code>hasProxy</code> does not build it. The
+             * <code>IModel</code> takes ownership of the factory.</P>
+             *
+             * @param proxy_name the name of the proxy built by the factory.
+             * @param factory the <code>IProxyFactory</code> to be held by the <code>Model</code>.
+             */
+            virtual void registerProxyFactory(std::string const& proxy_name, IProxyFactory* factory) = 0;
+
+            /**
+             * Register an <code>IProxyFactory</code> building an <code>IProxy</code>
+             * the <code>IModel</code> may evict.
+             *
+             * <P>
+             * Like <code>registerProxyFactory</code>, the proxy is built on first
+             * use, but the <code>IModel</code> keeps the factory and owns the
+             * proxy. The proxy must implement <code>IEvictable</code>. When the
+             * memory used by the evictable proxies exceeds the memory budget,
+             * the least recently used ones are removed, receive
+             * <code>onRemove</code> and are deleted. They are built again on the
+             * next access.</P>
+             *
+             * @param proxy_name the name of the proxy built by the factory.
+             * @param factory the <code>IProxyFactory</code> to be held by the <code>Model</code>.
+             */
+            virtual void registerEvictableProxyFactory(std::string const& proxy_name, IProxyFactory* factory) = 0;
+
             /**
              * Retrieve an <code>IProxy</code> instance from the Model.
              *
@@ -73,6 +128,42 @@ namespace PureMVC
              */
             virtual IProxy& retrieveProxy(std::string const& proxy_name) = 0;
 
+            /**
+             * Retrieve an <code>IProxy</code> instance from the <code>Model</code> without throwing.
+             *
+             * <P>
+             * Prefer it to <code>hasProxy</code> followed by
+             * <code>retrieveProxy</code>, which throws if another thread removes
+             * the proxy in between. A registered proxy is found with one lookup
+             * under the lock, but a proxy whose factory was not used yet is built
+             * by this call outside the lock, or waited for if another thread is
+             * building it; <code>tryRetrieveBuiltProxy</code> never builds.</P>
+             *
+             * @param proxy_name the name of the <code>IProxy</code> instance to be retrieved.
+             * @return the <code>IProxy</code> instance, or <code>NULL</code> if none is registered.
+             */
+            virtual IProxy const* tryRetrieveProxy(std::string const& proxy_name) const = 0;
+
+            /**
+             * Retrieve an <code>IProxy</code> instance from the <code>Model</code> without throwing.
+             *
+             * @param proxy_name the name of the <code>IProxy</code> instance to be retrieved.
+             * @return the <code>IProxy</code> instance, or <code>NULL</code> if none is registered.
+             */
+            virtual IProxy* tryRetrieveProxy(std::string const& proxy_name) = 0;
+
+            /**
+             * Retrieve an <code>IProxy</code> instance only if it is built.
+             *
+             * <P>
+             * Unlike <code>tryRetrieveProxy</code>, it neither builds a proxy whose
+             * factory was not used yet nor marks an evictable proxy as used.</P>
+             *
+             * @param proxy_name the name of the <code>IProxy</code> instance to be retrieved.
+             * @return the <code>IProxy</code> instance, or <code>NULL</code> if none is built.
+             */
+            virtual IProxy const* tryRetrieveBuiltProxy(std::string const& proxy_name) const = 0;
+
             /**
              * Remove an <code>IProxy</code> instance from the Model.
              *
@@ -89,6 +180,34 @@ namespace PureMVC
              */
             virtual bool hasProxy(std::string const& proxy_name) const = 0;
 
+            /**
+             * Get the generation of the <code>Model</code>.
+             *
+             * <P>
+             * The generation changes every time an <code>IProxy</code> is removed,
+             * so a pointer retrieved earlier is still registered as long as the
+             * generation is unchanged.</P>
+             *
+             * @return the current generation.
+             */
+            virtual long getGeneration(void) const = 0;
+
+            /**
+             * Set the memory budget of the evictable proxies in bytes, evicting
+             * proxies until it is met.
+             */
+            virtual void setMemoryBudget(std::size_t budget) = 0;
+
+            /**
+             * Get the memory budget of the evictable proxies in bytes.
+             */
+            virtual std::size_t getMemoryBudget(void) const = 0;
+
+            /**
+             * Get the memory used by the evictable proxies in bytes.
+             */
+            virtual std::size_t getMemoryUsage(void) const = 0;
+
             /**
              * Fetch all names of proxy
              *
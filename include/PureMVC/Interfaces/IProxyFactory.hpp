@@ -0,0 +1,53 @@
+//  IProxyFactory.hpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PUREMVC_INTERFACES_IPROXY_FACTORY_HPP__)
+#define __PUREMVC_INTERFACES_IPROXY_FACTORY_HPP__
+
+// STL include
+#include <string>
+// PureMVC include
+#if !defined(__PUREMVC_HPP__)
+#define __PUREMVC_INCLUDE__
+#include "../PureMVC.hpp"
+#endif /* __PUREMVC_HPP__ */
+
+#include "IProxy.hpp"
+
+namespace PureMVC
+{
+    namespace Interfaces
+    {
+        /**
+         * The interface definition for a factory of PureMVC Proxies.
+         *
+         * <P>
+         * Registered with <code>IModel::registerProxyFactory</code>, it
+         * builds the <code>IProxy</code> when it is first needed.</P>
+         *
+         * @see Interfaces/IModel.hpp PureMVC::Interfaces::IModel
+         */
+        struct PUREMVC_API IProxyFactory
+        {
+            /**
+             * Create the <code>IProxy</code>.
+             *
+             * @param proxy_name the name the proxy is registered with.
+             * @return the new <code>IProxy</code>, its name must be <code>proxy_name</code>.
+             */
+            virtual IProxy* createProxy(std::string const& proxy_name) = 0;
+
+            /**
+             * Virtual destructor.
+             */
+            virtual ~IProxyFactory(void);
+        };
+    }
+}
+
+#endif /* __PUREMVC_INTERFACES_IPROXY_FACTORY_HPP__ */
@@ -0,0 +1,70 @@
+//  ISerializable.hpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PUREMVC_INTERFACES_ISERIALIZABLE_HPP__)
+#define __PUREMVC_INTERFACES_ISERIALIZABLE_HPP__
+
+// STL include
+#include <cstddef>
+// PureMVC include
+#if !defined(__PUREMVC_HPP__)
+#define __PUREMVC_INCLUDE__
+#include "../PureMVC.hpp"
+#endif /* __PUREMVC_HPP__ */
+
+namespace PureMVC
+{
+    namespace Interfaces
+    {
+        /**
+         * The interface definition for an object saved to a binary image.
+         *
+         * <P>
+         * Implemented by the proxies taking part in a
+         * <code>ProxySnapshot</code>. The image is written and read on the same
+         * platform: it may hold native integers and POD records.</P>
+         *
+         * @see Patterns/Proxy/ProxySnapshot.hpp PureMVC::Patterns::ProxySnapshot
+         */
+        struct PUREMVC_API ISerializable
+        {
+            /**
+             * Get the tag of the image format, used to find the factory
+             * rebuilding the object.
+             */
+            virtual unsigned int getSerialType(void) const = 0;
+
+            /**
+             * Get the size of the image in bytes.
+             */
+            virtual std::size_t getSerializedSize(void) const = 0;
+
+            /**
+             * Write the image.
+             *
+             * @param buffer <code>getSerializedSize</code> bytes, aligned to 8 bytes.
+             */
+            virtual void serialize(void* buffer) const = 0;
+
+            /**
+             * Read the image written by <code>serialize</code>.
+             *
+             * @param data the image, aligned to 8 bytes.
+             * @param size the size of the image in bytes.
+             */
+            virtual void deserialize(void const* data, std::size_t size) = 0;
+
+            /**
+             * Virtual destructor.
+             */
+            virtual ~ISerializable(void);
+        };
+    }
+}
+
+#endif /* __PUREMVC_INTERFACES_ISERIALIZABLE_HPP__ */
@@ -11,6 +11,7 @@
 
 // STL include
 #include <string>
+#include <cstddef>
 // PureMVC include
 #if !defined(__PUREMVC_HPP__)
 #define __PUREMVC_INCLUDE__
@@ -66,6 +67,20 @@ namespace PureMVC
              */
             virtual void registerObserver(std::string const& notification_name, IObserver* observer) = 0;
 
+            /**
+             * Register many <code>IObservers</code> under one lock.
+             *
+             * @param notification_names the names of the <code>INotifications</code>, one per observer.
+             * @param observers the <code>IObservers</code> to register.
+             * @param count the number of observers.
+             */
+            virtual void registerObservers(std::string const* notification_names, IObserver* const* observers, std::size_t count) = 0;
+
+            /**
+             * Grow the observer table to hold <code>count</code> notification names without rehashing.
+             */
+            virtual void reserveObservers(std::size_t count) = 0;
+
             /**
              * Remove a group of observers from the observer list for a given Notification name.
              * <P>
@@ -104,6 +119,26 @@ namespace PureMVC
              */
             virtual void registerMediator(IMediator* mediator) = 0;
 
+            /**
+             * Register many <code>IMediator</code> instances with the <code>View</code>.
+             *
+             * <P>
+             * Same as calling <code>registerMediator</code> for each mediator,
+             * but the mediators and the observers of their interests are each
+             * inserted under one lock. Mediators already registered by name
+             * are skipped. <code>onRegister</code> is called after all the
+             * mediators are registered, in order.</P>
+             *
+             * @param mediators the <code>IMediator</code> instances.
+             * @param count the number of mediators.
+             */
+            virtual void registerMediators(IMediator* const* mediators, std::size_t count) = 0;
+
+            /**
+             * Grow the mediator table to hold <code>count</code> mediators without rehashing.
+             */
+            virtual void reserveMediators(std::size_t count) = 0;
+
             /**
              * Retrieve an <code>IMediator</code> from the <code>View</code>.
              *
@@ -120,6 +155,27 @@ namespace PureMVC
              */
             virtual IMediator& retrieveMediator(std::string const& mediator_name) = 0;
 
+            /**
+             * Retrieve an <code>IMediator</code> instance from the <code>View</code> without throwing.
+             *
+             * <P>
+             * The mediator is looked up once under the lock, so it cannot be
+             * removed by another thread between a <code>hasMediator</code> and a
+             * <code>retrieveMediator</code>.</P>
+             *
+             * @param mediator_name the name of the <code>IMediator</code> instance to retrieve.
+             * @return the <code>IMediator</code> instance, or <code>NULL</code> if none is registered.
+             */
+            virtual IMediator const* tryRetrieveMediator(std::string const& mediator_name) const = 0;
+
+            /**
+             * Retrieve an <code>IMediator</code> instance from the <code>View</code> without throwing.
+             *
+             * @param mediator_name the name of the <code>IMediator</code> instance to retrieve.
+             * @return the <code>IMediator</code> instance, or <code>NULL</code> if none is registered.
+             */
+            virtual IMediator* tryRetrieveMediator(std::string const& mediator_name) = 0;
+
             /**
              * Remove an <code>IMediator</code> from the <code>View</code>.
              *
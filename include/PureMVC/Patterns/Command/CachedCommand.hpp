@@ -0,0 +1,218 @@
+//  CachedCommand.hpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PUREMVC_PATTERNS_COMMAND_CACHED_COMMAND_HPP__)
+#define __PUREMVC_PATTERNS_COMMAND_CACHED_COMMAND_HPP__
+
+// STL include
+#include <string>
+#include <list>
+#include <map>
+#include <utility>
+#include <cstddef>
+// PureMVC include
+#if !defined(__PUREMVC_HPP__)
+#define __PUREMVC_INCLUDE__
+#include "../../PureMVC.hpp"
+#endif /* __PUREMVC_HPP__ */
+
+#include "../../Interfaces/ICommand.hpp"
+#include "../Observer/Notifier.hpp"
+
+namespace PureMVC
+{
+    namespace Patterns
+    {
+        using Interfaces::ICommand;
+        using Interfaces::INotifier;
+        using Interfaces::INotification;
+
+        /**
+         * An <code>ICommand</code> memoizing a pure computation on the notification.
+         *
+         * <P>
+         * Some commands only depend on the name, type and body of their notification
+         * and answer with a result notification. A <code>CachedCommand</code> extracts a
+         * key from the notification, looks it up in a bounded LRU cache and only runs the
+         * computation on a miss. Hit or miss, the result is sent as the notification
+         * <code>result_name</code> with a pointer to the result as body; the pointer is
+         * valid while the notification is dispatched.</P>
+         *
+         * <P>
+         * <code>_KeyExtractor</code> and <code>_Compute</code> are functors taking an
+         * <code>INotification const&amp;</code>. Both declare their return type as
+         * <code>result_type</code>; the key type needs <code>operator&lt;</code>, the
+         * result type must be default constructible and copyable.</P>
+         *
+         * <P>
+         * Usage:
+         * <code>
+         *     controller.registerCommand("Price", createCachedCommand(PriceKey(), ComputePrice(), "PriceResult"));
+         * </code>
+         *
+         * @see Patterns/Command/DelegateCommand.hpp PureMVC::Patterns::DelegateCommand
+         */
+        template<typename _KeyExtractor, typename _Compute>
+        class CachedCommand
+            : public virtual ICommand
+            , public virtual INotifier
+            , public Notifier
+        {
+        public:
+            enum { DEFAULT_CAPACITY = 64 };
+            typedef typename _KeyExtractor::result_type key_type;
+            typedef typename _Compute::result_type result_type;
+        private:
+            typedef std::pair<key_type, result_type> Entry;
+            typedef std::list<Entry> EntryList;
+            typedef std::map<key_type, typename EntryList::iterator> EntryMap;
+        protected:
+            _KeyExtractor _key_extractor;
+            _Compute _compute;
+            std::string _result_name;
+            std::string _result_type;
+            std::size_t _capacity;
+            EntryList _entries;
+            EntryMap _entry_map;
+            std::size_t _hit_count;
+            std::size_t _miss_count;
+            mutable FastMutex _synchronous_access;
+        private:
+            CachedCommand(CachedCommand const&);
+            CachedCommand& operator=(CachedCommand const&);
+        public:
+            /**
+             * Constructor.
+             *
+             * @param key_extractor the functor computing the cache key of a notification.
+             * @param compute the functor computing the result of a notification.
+             * @param result_name the name of the result notification.
+             * @param result_type the type of the result notification.
+             * @param capacity the maximum number of cached results.
+             */
+            CachedCommand(_KeyExtractor key_extractor,
+                          _Compute compute,
+                          std::string const& result_name,
+                          std::string const& result_type = "",
+                          std::size_t capacity = DEFAULT_CAPACITY)
+                : INotifier()
+                , ICommand()
+                , Notifier()
+                , _key_extractor(key_extractor)
+                , _compute(compute)
+                , _result_name(result_name)
+                , _result_type(result_type)
+                , _capacity(capacity == 0 ? 1 : capacity)
+                , _hit_count(0)
+                , _miss_count(0)
+            { }
+
+        public:
+            /**
+             * Send the result of the notification, computing it on a cache miss.
+             *
+             * @param notification the <code>INotification</code> to handle.
+             */
+            virtual void execute(INotification const& notification)
+            {
+                key_type key = _key_extractor(notification);
+                result_type value;
+                bool hit = false;
+                do
+                {
+                    FastMutex::ScopedLock lock(_synchronous_access);
+                    typename EntryMap::iterator result = _entry_map.find(key);
+                    if (result == _entry_map.end())
+                        break;
+                    ++_hit_count;
+                    _entries.splice(_entries.begin(), _entries, result->second);
+                    value = result->second->second;
+                    hit = true;
+                } while (false);
+
+                if (!hit)
+                {
+                    // Compute outside the lock, concurrent misses on one key may compute twice.
+                    value = _compute(notification);
+
+                    FastMutex::ScopedLock lock(_synchronous_access);
+                    ++_miss_count;
+                    if (_entry_map.find(key) == _entry_map.end())
+                    {
+                        _entries.push_front(Entry(key, value));
+                        _entry_map.insert(std::make_pair(key, _entries.begin()));
+                        if (_entries.size() > _capacity)
+                        {
+                            _entry_map.erase(_entries.back().first);
+                            _entries.pop_back();
+                        }
+                    }
+                }
+                sendNotification(_result_name, &value, _result_type);
+            }
+
+            /**
+             * Remove all cached results.
+             */
+            void clear(void)
+            {
+                FastMutex::ScopedLock lock(_synchronous_access);
+                _entry_map.clear();
+                _entries.clear();
+            }
+
+            /**
+             * Get number of cached results.
+             */
+            std::size_t getSize(void) const
+            {
+                FastMutex::ScopedLock lock(_synchronous_access);
+                return _entries.size();
+            }
+
+            /**
+             * Get number of executions answered from the cache.
+             */
+            std::size_t getHitCount(void) const
+            {
+                FastMutex::ScopedLock lock(_synchronous_access);
+                return _hit_count;
+            }
+
+            /**
+             * Get number of executions which ran the computation.
+             */
+            std::size_t getMissCount(void) const
+            {
+                FastMutex::ScopedLock lock(_synchronous_access);
+                return _miss_count;
+            }
+
+            /**
+             * Virtual destructor.
+             */
+            virtual ~CachedCommand(void)
+            { }
+        };
+
+        /**
+         * Create new cached command.
+         */
+        template<typename _KeyExtractor, typename _Compute>
+        inline ICommand* createCachedCommand(_KeyExtractor key_extractor,
+                                             _Compute compute,
+                                             std::string const& result_name,
+                                             std::string const& result_type = "",
+                                             std::size_t capacity = CachedCommand<_KeyExtractor, _Compute>::DEFAULT_CAPACITY)
+        {
+            return new CachedCommand<_KeyExtractor, _Compute>(key_extractor, compute, result_name, result_type, capacity);
+        }
+    }
+}
+
+#endif /* __PUREMVC_PATTERNS_COMMAND_CACHED_COMMAND_HPP__ */
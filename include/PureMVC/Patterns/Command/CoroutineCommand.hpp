@@ -0,0 +1,324 @@
+//  CoroutineCommand.hpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PUREMVC_PATTERNS_COMMAND_COROUTINE_COMMAND_HPP__)
+#define __PUREMVC_PATTERNS_COMMAND_COROUTINE_COMMAND_HPP__
+
+// PureMVC include
+#if !defined(__PUREMVC_HPP__)
+#define __PUREMVC_INCLUDE__
+#include "../../PureMVC.hpp"
+#endif /* __PUREMVC_HPP__ */
+
+#if defined(PUREMVC_USES_COROUTINE)
+
+// STL include
+#include <string>
+#include <exception>
+#include <iostream>
+#include <coroutine>
+
+#include "../../Interfaces/ICommand.hpp"
+#include "../../Interfaces/IObserver.hpp"
+#include "../../Interfaces/IView.hpp"
+#include "../../Core/View.hpp"
+#include "SimpleCommand.hpp"
+
+namespace PureMVC
+{
+    namespace Patterns
+    {
+        using Interfaces::IView;
+        using Interfaces::IObserver;
+        using Interfaces::INotifier;
+        using Interfaces::INotification;
+
+        /**
+         * Return type of coroutines started by <code>CoroutineCommand</code>
+         * or by any <code>INotifier</code>.
+         *
+         * <P>
+         * The coroutine starts immediately and runs until its first
+         * <code>co_await</code>. Its frame destroys itself when it completes. An
+         * exception escaping the coroutine is reported on <code>std::cerr</code>,
+         * like an exception escaping a <code>Thread</code>.</P>
+         */
+        struct CoroutineTask
+        {
+            struct promise_type
+            {
+                CoroutineTask get_return_object(void) noexcept
+                {
+                    return CoroutineTask();
+                }
+
+                std::suspend_never initial_suspend(void) noexcept
+                {
+                    return std::suspend_never();
+                }
+
+                std::suspend_never final_suspend(void) noexcept
+                {
+                    return std::suspend_never();
+                }
+
+                void return_void(void) noexcept
+                { }
+
+                void unhandled_exception(void) noexcept
+                {
+                    try
+                    {
+                        throw;
+                    }
+                    catch(std::exception const& ex)
+                    {
+                        std::cerr << ex.what() << std::endl;
+                    }
+                    catch(...)
+                    {
+                        std::cerr << "Cannot handle exception from coroutine." << std::endl;
+                    }
+                }
+            };
+        };
+
+        /**
+         * Awaiter suspending a coroutine until the <code>View</code> of a core
+         * dispatches a notification with the given name.
+         *
+         * <P>
+         * While suspended, the awaiter is registered as a one-shot
+         * <code>IObserver</code>: no thread is blocked. The coroutine is resumed
+         * once, on the first thread dispatching the notification, after the
+         * observer has been removed. The observer is owned by the
+         * <code>View</code>. If the <code>View</code> is deleted first, deleting
+         * the observer destroys the suspended coroutine, with the objects its
+         * frame holds. The <code>INotification</code> returned by <code>co_await</code>
+         * is only valid until the coroutine suspends again; copy what is needed
+         * beyond that point.</P>
+         *
+         * @see PureMVC::Patterns::nextNotification
+         */
+        class NotificationAwaiter
+        {
+        private:
+            class ResumeObserver : public IObserver
+            {
+            private:
+                NotificationAwaiter* _awaiter;
+                long volatile _claimed;
+            public:
+                explicit ResumeObserver(NotificationAwaiter* awaiter)
+                    : IObserver()
+                    , _awaiter(awaiter)
+                    , _claimed(0)
+                { }
+
+                // Only the first caller may resume or destroy the coroutine.
+                bool claim(void)
+                {
+                    return atomicCompareExchange(&_claimed, 1, 0) == 0;
+                }
+
+                virtual void notifyObserver(INotification const& notification)
+                {
+                    // concurrent or nested dispatches of the name still reach the observer
+                    if (!claim())
+                        return;
+                    NotificationAwaiter* awaiter = _awaiter;
+                    awaiter->_notification = &notification;
+                    awaiter->_registered = false;
+                    // The View deletes this observer once the dispatch ends.
+                    awaiter->_view.removeObserver(awaiter->_notification_name, awaiter);
+                    awaiter->_handle.resume();
+                }
+
+                virtual bool compareNotifyContext(void const* object) const
+                {
+                    return _awaiter == object;
+                }
+
+                // Deleted before a notification came: the View is deleted.
+                virtual ~ResumeObserver(void)
+                {
+                    if (!claim())
+                        return;
+                    _awaiter->_registered = false;
+                    _awaiter->_handle.destroy();
+                }
+            };
+        private:
+            IView& _view;
+            std::string _notification_name;
+            std::coroutine_handle<> _handle;
+            ResumeObserver* _observer;
+            INotification const* _notification;
+            bool _registered;
+        private:
+            NotificationAwaiter& operator=(NotificationAwaiter const&);
+        public:
+            /**
+             * Constructor.
+             *
+             * @param view the <code>IView</code> dispatching the notification.
+             * @param notification_name the name of the notification to wait for.
+             */
+            NotificationAwaiter(IView& view, std::string const& notification_name)
+                : _view(view)
+                , _notification_name(notification_name)
+                , _observer(NULL)
+                , _notification(NULL)
+                , _registered(false)
+            { }
+
+            /**
+             * Copy constructor.
+             */
+            NotificationAwaiter(NotificationAwaiter const& arg)
+                : _view(arg._view)
+                , _notification_name(arg._notification_name)
+                , _observer(NULL)
+                , _notification(NULL)
+                , _registered(false)
+            { }
+
+            bool await_ready(void) const noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> handle)
+            {
+                _handle = handle;
+                _registered = true;
+                _observer = new ResumeObserver(this);
+                Core::View::registerOwnedObserver(_view, _notification_name, _observer);
+            }
+
+            INotification const& await_resume(void) const noexcept
+            {
+                return *_notification;
+            }
+
+            /**
+             * Destructor.
+             *
+             * <P>
+             * Removes the observer when the coroutine is destroyed by its owner
+             * while it is still suspended.</P>
+             */
+            ~NotificationAwaiter(void)
+            {
+                if (_registered && _observer->claim())
+                    _view.removeObserver(_notification_name, this);
+            }
+        };
+
+        /**
+         * Create an awaiter resuming on the next notification with the given name
+         * sent in the core of <code>notifier</code>.
+         *
+         * <P>
+         * Usage:
+         * <code>
+         *     INotification const& note = co_await nextNotification(facade, "Name");
+         * </code>
+         *
+         * @param notifier the <code>IFacade</code>, <code>IMediator</code>, <code>IProxy</code>
+         * or <code>ICommand</code> providing the multiton key.
+         * @param notification_name the name of the notification to wait for.
+         */
+        inline NotificationAwaiter nextNotification(INotifier const& notifier, std::string const& notification_name)
+        {
+            return NotificationAwaiter(Core::View::getInstance(notifier.getMultitonKey()), notification_name);
+        }
+
+        /**
+         * A base <code>ICommand</code> implementation running its work as a coroutine.
+         *
+         * <P>
+         * <code>ICommand::execute</code> cannot return a coroutine without breaking
+         * every other command, so <code>execute</code> starts
+         * <code>executeCoroutine</code> instead. The coroutine may suspend on
+         * <code>co_await nextNotification(name)</code> and is resumed by the
+         * <code>View</code>, which allows a workflow spanning several notifications
+         * to stay in one function.</P>
+         *
+         * <P>
+         * The <code>notification</code> argument is a reference: it is only valid
+         * until the first suspension. The command must outlive the coroutines it
+         * started.</P>
+         *
+         * <P>
+         * Requires C++20 coroutines (<code>PUREMVC_USES_COROUTINE</code>).</P>
+         *
+         * @see Patterns/Command/SimpleCommand.hpp PureMVC::Patterns::SimpleCommand
+         */
+        class CoroutineCommand : public SimpleCommand
+        {
+        public:
+            /**
+             * Constructor.
+             */
+            CoroutineCommand(void)
+                : INotifier()
+                , ICommand()
+                , SimpleCommand()
+            { }
+
+            /**
+             * Copy constructor.
+             */
+            explicit CoroutineCommand(CoroutineCommand const& arg)
+                : INotifier()
+                , ICommand()
+                , SimpleCommand(arg)
+            { }
+
+        public:
+            /**
+             * Start <code>executeCoroutine</code> with the notification.
+             *
+             * @param notification the <code>INotification</code> to handle.
+             */
+            virtual void execute(INotification const& notification)
+            {
+                executeCoroutine(notification);
+            }
+
+            /**
+             * The coroutine handling the notification.
+             *
+             * @param notification the <code>INotification</code> to handle.
+             */
+            virtual CoroutineTask executeCoroutine(INotification const& notification) = 0;
+
+            /**
+             * Virtual destructor.
+             */
+            virtual ~CoroutineCommand(void)
+            { }
+        protected:
+            /**
+             * Create an awaiter resuming on the next notification with the
+             * given name sent in this command's core.
+             *
+             * @param notification_name the name of the notification to wait for.
+             */
+            NotificationAwaiter nextNotification(std::string const& notification_name) const
+            {
+                return Patterns::nextNotification(*this, notification_name);
+            }
+        };
+    }
+}
+
+#endif /* PUREMVC_USES_COROUTINE */
+
+#endif /* __PUREMVC_PATTERNS_COMMAND_COROUTINE_COMMAND_HPP__ */
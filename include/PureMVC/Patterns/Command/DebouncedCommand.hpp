@@ -0,0 +1,120 @@
+//  DebouncedCommand.hpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PUREMVC_PATTERNS_COMMAND_DEBOUNCED_COMMAND_HPP__)
+#define __PUREMVC_PATTERNS_COMMAND_DEBOUNCED_COMMAND_HPP__
+
+// STL include
+#include <string>
+// PureMVC include
+#if !defined(__PUREMVC_HPP__)
+#define __PUREMVC_INCLUDE__
+#include "../../PureMVC.hpp"
+#endif /* __PUREMVC_HPP__ */
+
+#include "../../Interfaces/ICommand.hpp"
+#include "../Observer/Notifier.hpp"
+#include "SimpleCommand.hpp"
+
+namespace PureMVC
+{
+    namespace Patterns
+    {
+        using Interfaces::ICommand;
+        using Interfaces::INotifier;
+        using Interfaces::INotification;
+
+        /**
+         * An <code>ICommand</code> executing another <code>ICommand</code> once
+         * notifications stopped arriving for a quiet period.
+         *
+         * <P>
+         * Every notification restarts the quiet period and replaces the kept one. When
+         * the period elapses, the shared <code>Timer</code> executes the command with the
+         * latest notification on the timer thread. A timer superseded by a later
+         * notification drops its own, even when it was already due.</P>
+         *
+         * <P>
+         * Usage:
+         * <code>
+         *     controller.registerCommand("Name", createDebouncedCommand(&command, 200));
+         * </code>
+         *
+         * @see PureMVC::Timer
+         * @see Patterns/Command/ThrottledCommand.hpp PureMVC::Patterns::ThrottledCommand
+         */
+        class PUREMVC_API DebouncedCommand
+            : public virtual ICommand
+            , public virtual INotifier
+            , public Notifier
+        {
+        private:
+            class Trailing : public SimpleCommand
+            {
+            private:
+                DebouncedCommand* _owner;
+            public:
+                explicit Trailing(DebouncedCommand* owner);
+                virtual void execute(INotification const& notification);
+            };
+            friend class Trailing;
+        protected:
+            ICommand* _command;
+            long _quiet_period;
+            unsigned long _timer_id;
+            INotification const* _pending;
+            Trailing _trailing;
+            FastMutex _synchronous_access;
+        private:
+            DebouncedCommand(DebouncedCommand const&);
+            DebouncedCommand& operator=(DebouncedCommand const&);
+        public:
+            /**
+             * Constructor.
+             *
+             * @param command the debounced <code>ICommand</code>, not owned.
+             * @param quiet_period the number of milliseconds without notification
+             * before executing.
+             */
+            DebouncedCommand(ICommand* command, long quiet_period);
+
+        public:
+            /**
+             * Initialize this command and the debounced one with the multiton key.
+             *
+             * @param key the multitonKey for this INotifier to use.
+             */
+            virtual void initializeNotifier(std::string const& key);
+
+            /**
+             * Keep the notification and restart the quiet period.
+             *
+             * @param notification the <code>INotification</code> to handle.
+             */
+            virtual void execute(INotification const& notification);
+
+            /**
+             * Virtual destructor.
+             *
+             * <P>
+             * A kept notification is dropped.</P>
+             */
+            virtual ~DebouncedCommand(void);
+        };
+
+        /**
+         * Create new debounced command.
+         */
+        inline ICommand* createDebouncedCommand(ICommand* command, long quiet_period)
+        {
+            return new DebouncedCommand(command, quiet_period);
+        }
+    }
+}
+
+#endif /* __PUREMVC_PATTERNS_COMMAND_DEBOUNCED_COMMAND_HPP__ */
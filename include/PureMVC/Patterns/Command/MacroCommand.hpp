@@ -12,6 +12,7 @@
 // STL include
 #include <string>
 #include <list>
+#include <vector>
 // PureMVC include
 #if !defined(__PUREMVC_HPP__)
 #define __PUREMVC_INCLUDE__
@@ -43,6 +44,14 @@ namespace PureMVC
          * <code>execute</code> method.</P>
          *
          * <P>
+         * The <i>SubCommands</i> are kept in a contiguous array and receive
+         * their multiton key once, when the <code>MacroCommand</code> itself
+         * is initialized by the <code>Controller</code>. Executing does not
+         * modify the <i>SubCommand</i> list, so a registered <code>MacroCommand</code>
+         * may be executed any number of times, and concurrently for different
+         * notifications as long as its <i>SubCommands</i> are stateless.</P>
+         *
+         * <P>
          * Unlike <code>SimpleCommand</code>, your subclass
          * should not override <code>execute</code>, but instead, should
          * override the <code>initializeMacroCommand</code> method,
@@ -131,6 +140,14 @@ namespace PureMVC
             virtual void addSubCommand(ICommand* command);
 
         public:
+            /**
+             * Initialize this <code>MacroCommand</code> and all of its <i>SubCommands</i>
+             * with the multiton key.
+             *
+             * @param key the multitonKey for this INotifier to use.
+             */
+            virtual void initializeNotifier(std::string const& key);
+
             /**
              * Execute this <code>MacroCommand</code>'s <i>SubCommands</i>.
              *
@@ -152,7 +169,7 @@ namespace PureMVC
              */
             virtual ~MacroCommand(void);
         private:
-            typedef std::list<ICommand*> CommandList;
+            typedef std::vector<ICommand*> CommandList;
             CommandList _sub_commands;
         };
     }
@@ -0,0 +1,185 @@
+//  PipelineCommand.hpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PUREMVC_PATTERNS_COMMAND_PIPELINE_COMMAND_HPP__)
+#define __PUREMVC_PATTERNS_COMMAND_PIPELINE_COMMAND_HPP__
+
+// STL include
+#include <string>
+#include <vector>
+#include <cstddef>
+// PureMVC include
+#if !defined(__PUREMVC_HPP__)
+#define __PUREMVC_INCLUDE__
+#include "../../PureMVC.hpp"
+#endif /* __PUREMVC_HPP__ */
+
+#include "../../Interfaces/ICommand.hpp"
+#include "../Observer/Notifier.hpp"
+
+namespace PureMVC
+{
+    class Thread;
+
+    namespace Patterns
+    {
+        using Interfaces::ICommand;
+        using Interfaces::INotifier;
+        using Interfaces::INotification;
+
+        /**
+         * An <code>ICommand</code> that runs a chain of <i>stage</i> commands,
+         * each one on its own worker thread.
+         *
+         * <P>
+         * <code>MacroCommand</code> runs its <i>SubCommands</i> one after another on the
+         * caller's thread. A <code>PipelineCommand</code> instead connects its stages with
+         * bounded lock-free queues: <code>execute</code> copies the notification into the
+         * queue of the first stage and returns, each stage worker executes its command and
+         * hands the notification to the next queue, and the last stage destroys it. While
+         * stage <i>n</i> handles one notification, stage <i>n + 1</i> handles the previous
+         * one, so consecutive notifications are processed overlapped.</P>
+         *
+         * <P>
+         * Queues are bounded by the capacity given at construction. When a queue is full,
+         * the thread feeding it waits until the next stage takes an item, so a slow stage
+         * slows down its producers instead of growing memory (backpressure). This also
+         * applies to the caller of <code>execute</code>.</P>
+         *
+         * <P>
+         * Notes:
+         * <UL>
+         * <LI>Notifications are copied, the body is not: it must stay valid until the
+         * last stage has handled it.</LI>
+         * <LI>Each stage command is executed by one thread only, but stages run
+         * concurrently with each other and with the caller.</LI>
+         * <LI>An exception thrown by a stage is reported on <code>std::cerr</code> and
+         * the notification is dropped.</LI>
+         * <LI>Stage commands are not owned by the pipeline, like <i>SubCommands</i> of
+         * <code>MacroCommand</code>.</LI>
+         * </UL></P>
+         *
+         * <P>
+         * Usage:
+         * <code>
+         *     PipelineCommand* pipeline = new PipelineCommand();
+         *     pipeline->addStage(&parse_command);
+         *     pipeline->addStage(&validate_command);
+         *     pipeline->addStage(&persist_command);
+         *     controller.registerCommand("Ingest", pipeline);
+         * </code>
+         *
+         * @see Patterns/Command/MacroCommand.hpp PureMVC::Patterns::MacroCommand
+         */
+        class PUREMVC_API PipelineCommand
+            : public virtual ICommand
+            , public virtual INotifier
+            , public Notifier
+        {
+        public:
+            enum { DEFAULT_CAPACITY = 64 };
+        private:
+            class Queue;
+            class Stage;
+            friend class Stage;
+            typedef std::vector<Stage*> StageList;
+        protected:
+            StageList _stages;
+            std::size_t _capacity;
+            long volatile _submitted;
+            long volatile _completed;
+            long volatile _running;
+            long volatile _flush_waiting;
+            FastMutex _mutex;
+            FastMutex _flush_mutex;
+            Event _flushed;
+        private:
+            PipelineCommand(PipelineCommand const&);
+            PipelineCommand& operator=(PipelineCommand const&);
+        public:
+            /**
+             * Constructor.
+             *
+             * @param capacity the number of notifications each queue can hold.
+             */
+            explicit PipelineCommand(std::size_t capacity = DEFAULT_CAPACITY);
+
+            /**
+             * Constructor.
+             *
+             * @param stages the stage commands, in order.
+             * @param count the number of stage commands.
+             * @param capacity the number of notifications each queue can hold.
+             */
+            PipelineCommand(ICommand* const* stages, std::size_t count, std::size_t capacity = DEFAULT_CAPACITY);
+
+        public:
+            /**
+             * Add a stage to the end of the pipeline.
+             *
+             * <P>
+             * Stages cannot be added while workers are running, call <code>stop</code>
+             * first.</P>
+             *
+             * @param command a reference to the stage <code>ICommand</code>.
+             */
+            virtual void addStage(ICommand* command);
+
+            /**
+             * Initialize this <code>PipelineCommand</code> and its stages with the
+             * multiton key.
+             *
+             * @param key the multitonKey for this INotifier to use.
+             */
+            virtual void initializeNotifier(std::string const& key);
+
+            /**
+             * Hand the notification to the first stage.
+             *
+             * <P>
+             * Workers are started by the first call. Blocks while the first
+             * queue is full.</P>
+             *
+             * @param notification the <code>INotification</code> to handle.
+             */
+            virtual void execute(INotification const& notification);
+
+            /**
+             * Wait until every submitted notification went through all stages.
+             */
+            virtual void flush(void);
+
+            /**
+             * Drain the pipeline and stop the workers.
+             *
+             * <P>
+             * The next call of <code>execute</code> starts them again.</P>
+             */
+            virtual void stop(void);
+
+            /**
+             * Get number of stages.
+             */
+            std::size_t getStageCount(void) const;
+
+            /**
+             * Get number of notifications which went through all stages.
+             */
+            std::size_t getCompletedCount(void) const;
+
+            /**
+             * Virtual destructor.
+             */
+            virtual ~PipelineCommand(void);
+        private:
+            void start(void);
+        };
+    }
+}
+
+#endif /* __PUREMVC_PATTERNS_COMMAND_PIPELINE_COMMAND_HPP__ */
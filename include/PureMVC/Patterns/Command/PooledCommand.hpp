@@ -0,0 +1,278 @@
+//  PooledCommand.hpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PUREMVC_PATTERNS_COMMAND_POOLED_COMMAND_HPP__)
+#define __PUREMVC_PATTERNS_COMMAND_POOLED_COMMAND_HPP__
+
+// STL include
+#include <string>
+#include <cstddef>
+// PureMVC include
+#if !defined(__PUREMVC_HPP__)
+#define __PUREMVC_INCLUDE__
+#include "../../PureMVC.hpp"
+#endif /* __PUREMVC_HPP__ */
+
+#include "../../Interfaces/ICommand.hpp"
+#include "../Observer/Notifier.hpp"
+
+namespace PureMVC
+{
+    namespace Patterns
+    {
+        using Interfaces::ICommand;
+        using Interfaces::INotifier;
+        using Interfaces::INotification;
+
+        /**
+         * Command factory creating instances by default constructor.
+         */
+        template<typename _Command>
+        struct DefaultCommandFactory
+        {
+            /**
+             * Create new command.
+             */
+            inline ICommand* operator()(void) const
+            {
+                return new _Command();
+            }
+        };
+
+        /**
+         * Command factory creating instances by copying a prototype.
+         */
+        template<typename _Command>
+        class PrototypeCommandFactory
+        {
+        private:
+            _Command _prototype;
+        public:
+            /**
+             * Constructor.
+             *
+             * @param prototype the command to copy.
+             */
+            explicit PrototypeCommandFactory(_Command const& prototype)
+                : _prototype(prototype)
+            { }
+
+            /**
+             * Copy constructor.
+             */
+            PrototypeCommandFactory(PrototypeCommandFactory const& arg)
+                : _prototype(arg._prototype)
+            { }
+
+            /**
+             * Create new command.
+             */
+            inline ICommand* operator()(void) const
+            {
+                return new _Command(_prototype);
+            }
+        };
+
+        /**
+         * An <code>ICommand</code> that executes every <code>INotification</code>
+         * with its own command instance.
+         *
+         * <P>
+         * <code>Controller</code> reuses the registered <code>ICommand</code> for every
+         * notification. When the command keeps state, register a <code>PooledCommand</code>
+         * instead: each execution borrows an instance from a fixed array of slots,
+         * claimed with an atomic compare-and-swap, and gives it back afterwards.
+         * Instances are created by the factory on first use and kept for the life
+         * of the <code>PooledCommand</code>. When every slot is busy, a temporary
+         * instance is created and destroyed for that execution only.</P>
+         *
+         * <P>
+         * Usage:
+         * <code>
+         *     controller.registerCommand("Name", createPooledCommand<MyCommand>());
+         *     controller.registerCommand("Name", createPooledCommand(prototype));
+         * </code>
+         *
+         * @see Patterns/Command/DelegateCommand.hpp PureMVC::Patterns::DelegateCommand
+         */
+        template<typename _Factory>
+        class PooledCommand
+            : public virtual ICommand
+            , public virtual INotifier
+            , public Notifier
+        {
+        public:
+            enum { DEFAULT_CAPACITY = 16 };
+        private:
+            enum { SLOT_FREE = 0, SLOT_BUSY = 1 };
+            struct Slot
+            {
+                long volatile state;
+                long generation;
+                ICommand* command;
+            };
+            class SlotGuard
+            {
+            private:
+                Slot* _slot;
+                ICommand* _transient;
+                SlotGuard(SlotGuard const&);
+                SlotGuard& operator=(SlotGuard const&);
+            public:
+                SlotGuard(Slot* slot, ICommand* transient)
+                    : _slot(slot)
+                    , _transient(transient)
+                { }
+                ~SlotGuard(void)
+                {
+                    if (_slot != NULL)
+                        atomicExchange(&_slot->state, SLOT_FREE);
+                    else
+                        delete _transient;
+                }
+            };
+        protected:
+            _Factory _factory;
+            std::size_t _capacity;
+            Slot* _slots;
+            long volatile _generation;
+        private:
+            PooledCommand(PooledCommand const&);
+            PooledCommand& operator=(PooledCommand const&);
+        public:
+            /**
+             * Constructor.
+             *
+             * @param factory the functor creating new <code>ICommand</code> instances.
+             * @param capacity the number of pooled instances.
+             */
+            explicit PooledCommand(_Factory factory, std::size_t capacity = DEFAULT_CAPACITY)
+                : INotifier()
+                , ICommand()
+                , Notifier()
+                , _factory(factory)
+                , _capacity(capacity == 0 ? 1 : capacity)
+                , _slots(new Slot[capacity == 0 ? 1 : capacity])
+                , _generation(0)
+            {
+                for (std::size_t i = 0; i < _capacity; ++i)
+                {
+                    _slots[i].state = SLOT_FREE;
+                    _slots[i].generation = 0;
+                    _slots[i].command = NULL;
+                }
+            }
+
+        public:
+            /**
+             * Initialize this <code>PooledCommand</code> with the multiton key.
+             *
+             * <P>
+             * Pooled instances pick up the new key the next time they are borrowed.</P>
+             *
+             * @param key the multitonKey for this INotifier to use.
+             */
+            virtual void initializeNotifier(std::string const& key)
+            {
+                Notifier::initializeNotifier(key);
+                atomicIncrement(&_generation);
+            }
+
+            /**
+             * Execute the notification with a pooled <code>ICommand</code> instance.
+             *
+             * @param notification the <code>INotification</code> to handle.
+             */
+            virtual void execute(INotification const& notification)
+            {
+                Slot* slot = _slots;
+                Slot* end = _slots + _capacity;
+                for (; slot != end; ++slot)
+                {
+                    if (slot->state == SLOT_FREE &&
+                        atomicCompareExchange(&slot->state, SLOT_BUSY, SLOT_FREE) == SLOT_FREE)
+                        break;
+                }
+                if (slot == end)
+                {
+                    ICommand* command = createCommand();
+                    SlotGuard guard(NULL, command);
+                    command->execute(notification);
+                    return;
+                }
+                SlotGuard guard(slot, NULL);
+                if (slot->command == NULL)
+                {
+                    slot->command = createCommand();
+                    slot->generation = _generation;
+                }
+                else if (slot->generation != _generation)
+                {
+                    slot->generation = _generation;
+                    slot->command->initializeNotifier(_multiton_key);
+                }
+                slot->command->execute(notification);
+            }
+
+            /**
+             * Get number of pooled instances.
+             */
+            std::size_t getCapacity(void) const
+            {
+                return _capacity;
+            }
+
+            /**
+             * Virtual destructor.
+             */
+            virtual ~PooledCommand(void)
+            {
+                for (std::size_t i = 0; i < _capacity; ++i)
+                    delete _slots[i].command;
+                delete[] _slots;
+            }
+        private:
+            inline ICommand* createCommand(void)
+            {
+                ICommand* command = _factory();
+                if (!_multiton_key.empty())
+                    command->initializeNotifier(_multiton_key);
+                return command;
+            }
+        };
+
+        /**
+         * Create new pooled command with a factory functor.
+         */
+        template<typename _Factory>
+        inline ICommand* createPooledCommand(_Factory factory, std::size_t capacity)
+        {
+            return new PooledCommand<_Factory>(factory, capacity);
+        }
+
+        /**
+         * Create new pooled command of default constructed instances.
+         */
+        template<typename _Command>
+        inline ICommand* createPooledCommand(std::size_t capacity = PooledCommand<DefaultCommandFactory<_Command> >::DEFAULT_CAPACITY)
+        {
+            return new PooledCommand<DefaultCommandFactory<_Command> >(DefaultCommandFactory<_Command>(), capacity);
+        }
+
+        /**
+         * Create new pooled command of instances copied from the prototype.
+         */
+        template<typename _Command>
+        inline ICommand* createPooledCommand(_Command const& prototype)
+        {
+            return new PooledCommand<PrototypeCommandFactory<_Command> >(PrototypeCommandFactory<_Command>(prototype));
+        }
+    }
+}
+
+#endif /* __PUREMVC_PATTERNS_COMMAND_POOLED_COMMAND_HPP__ */
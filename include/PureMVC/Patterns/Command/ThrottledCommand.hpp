@@ -0,0 +1,128 @@
+//  ThrottledCommand.hpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PUREMVC_PATTERNS_COMMAND_THROTTLED_COMMAND_HPP__)
+#define __PUREMVC_PATTERNS_COMMAND_THROTTLED_COMMAND_HPP__
+
+// STL include
+#include <string>
+#include <cstddef>
+// PureMVC include
+#if !defined(__PUREMVC_HPP__)
+#define __PUREMVC_INCLUDE__
+#include "../../PureMVC.hpp"
+#endif /* __PUREMVC_HPP__ */
+
+#include "../../Interfaces/ICommand.hpp"
+#include "../Observer/Notifier.hpp"
+#include "SimpleCommand.hpp"
+
+namespace PureMVC
+{
+    namespace Patterns
+    {
+        using Interfaces::ICommand;
+        using Interfaces::INotifier;
+        using Interfaces::INotification;
+
+        /**
+         * An <code>ICommand</code> executing another <code>ICommand</code> at most
+         * <code>limit</code> times per <code>interval</code>.
+         *
+         * <P>
+         * Within an interval, the first <code>limit</code> notifications are executed
+         * immediately on the caller's thread. Later ones are not executed, but the
+         * latest of them is kept and executed by the shared <code>Timer</code> when the
+         * interval ends, so the last state is never lost. That execution counts toward
+         * the next interval.</P>
+         *
+         * <P>
+         * Usage:
+         * <code>
+         *     controller.registerCommand("Name", createThrottledCommand(&command, 10, 1000));
+         * </code>
+         *
+         * @see PureMVC::Timer
+         * @see Patterns/Command/DebouncedCommand.hpp PureMVC::Patterns::DebouncedCommand
+         */
+        class PUREMVC_API ThrottledCommand
+            : public virtual ICommand
+            , public virtual INotifier
+            , public Notifier
+        {
+        private:
+            class Trailing : public SimpleCommand
+            {
+            private:
+                ThrottledCommand* _owner;
+            public:
+                explicit Trailing(ThrottledCommand* owner);
+                virtual void execute(INotification const& notification);
+            };
+            friend class Trailing;
+        protected:
+            ICommand* _command;
+            std::size_t _limit;
+            long _interval;
+            unsigned long _window_start;
+            std::size_t _count;
+            unsigned long _timer_id;
+            INotification const* _pending;
+            Trailing _trailing;
+            FastMutex _synchronous_access;
+        private:
+            ThrottledCommand(ThrottledCommand const&);
+            ThrottledCommand& operator=(ThrottledCommand const&);
+        public:
+            /**
+             * Constructor.
+             *
+             * @param command the throttled <code>ICommand</code>, not owned.
+             * @param limit the maximum number of executions per interval.
+             * @param interval the length of an interval in milliseconds.
+             */
+            ThrottledCommand(ICommand* command, std::size_t limit, long interval);
+
+        public:
+            /**
+             * Initialize this command and the throttled one with the multiton key.
+             *
+             * @param key the multitonKey for this INotifier to use.
+             */
+            virtual void initializeNotifier(std::string const& key);
+
+            /**
+             * Execute the throttled command now, or keep the notification
+             * for the end of the interval.
+             *
+             * @param notification the <code>INotification</code> to handle.
+             */
+            virtual void execute(INotification const& notification);
+
+            /**
+             * Virtual destructor.
+             *
+             * <P>
+             * A kept notification is dropped.</P>
+             */
+            virtual ~ThrottledCommand(void);
+        private:
+            bool acquire(void);
+        };
+
+        /**
+         * Create new throttled command.
+         */
+        inline ICommand* createThrottledCommand(ICommand* command, std::size_t limit, long interval)
+        {
+            return new ThrottledCommand(command, limit, interval);
+        }
+    }
+}
+
+#endif /* __PUREMVC_PATTERNS_COMMAND_THROTTLED_COMMAND_HPP__ */
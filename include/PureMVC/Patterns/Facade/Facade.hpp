@@ -41,6 +41,7 @@ namespace PureMVC
         using Interfaces::IController;
         using Interfaces::IMediator;
         using Interfaces::IProxy;
+        using Interfaces::IProxyFactory;
         using Interfaces::IAggregate;
 
         /**
@@ -79,10 +80,13 @@ namespace PureMVC
              * passing the unique key for this instance
              * <code>Facade.getInstance( multitonKey )</code>
              *
+             * @param key the Multiton key.
+             * @param capacity the expected sizes of the tables of the core,
+             * passed to the <code>Model</code>, <code>View</code> and <code>Controller</code>.
              * @throws Error Error if instance for this Multiton key has already been constructed
              *
              */
-            explicit Facade(std::string const& key = Facade::DEFAULT_KEY);
+            explicit Facade(std::string const& key = Facade::DEFAULT_KEY, CoreCapacity const& capacity = CoreCapacity());
 
         protected:
             /**
@@ -110,10 +114,12 @@ namespace PureMVC
              *
              */
             template<typename _DerivedType>
-            explicit Facade(_DerivedType* instance, std::string const& key = Facade::DEFAULT_KEY)
+            explicit Facade(_DerivedType* instance, std::string const& key = Facade::DEFAULT_KEY, CoreCapacity const& capacity = CoreCapacity())
                 : _controller(NULL)
                 , _model(NULL)
                 , _view(NULL)
+                , _timer_command(NULL)
+                , _capacity(capacity)
             {
                 if (find(key))
                     throw std::runtime_error(MULTITON_MSG);
@@ -136,9 +142,12 @@ namespace PureMVC
             /**
              * Facade Multiton Factory method
              *
+             * <P>
+             * An existing instance is grown to <code>capacity</code>.</P>
+             *
              * @return the Multiton instance of the Facade
              */
-            static IFacade& getInstance(std::string const& key = Facade::DEFAULT_KEY);
+            static IFacade& getInstance(std::string const& key = Facade::DEFAULT_KEY, CoreCapacity const& capacity = CoreCapacity());
 
         protected:
             /**
@@ -217,6 +226,15 @@ namespace PureMVC
              */
             virtual void registerCommand(std::string const& notification_name, ICommand* command);
 
+            /**
+             * Register many <code>ICommands</code> with the <code>Controller</code> by Notification name.
+             *
+             * @param notification_names the names of the <code>INotifications</code>, one per command.
+             * @param commands the <code>ICommand</code> instances.
+             * @param count the number of commands.
+             */
+            virtual void registerCommands(std::string const* notification_names, ICommand* const* commands, std::size_t count);
+
             /**
              * Remove a previously registered <code>ICommand</code> to <code>INotification</code> mapping from the Controller.
              *
@@ -241,6 +259,22 @@ namespace PureMVC
              */
             virtual ICommand& retrieveCommand(std::string const& notification_name);
 
+            /**
+             * Retrieve an <code>ICommand</code> instance from the <code>Controller</code> without throwing.
+             *
+             * @param notification_name the name of the <code>INotification</code>
+             * @return the <code>ICommand</code> instance, or <code>NULL</code> if none is registered.
+             */
+            virtual ICommand const* tryRetrieveCommand(std::string const& notification_name) const;
+
+            /**
+             * Retrieve an <code>ICommand</code> instance from the <code>Controller</code> without throwing.
+             *
+             * @param notification_name the name of the <code>INotification</code>
+             * @return the <code>ICommand</code> instance, or <code>NULL</code> if none is registered.
+             */
+            virtual ICommand* tryRetrieveCommand(std::string const& notification_name);
+
             /**
              * Check if a Command is registered for a given Notification
              *
@@ -257,6 +291,40 @@ namespace PureMVC
              */
             virtual void registerProxy (IProxy* proxy);
 
+            /**
+             * Register many <code>IProxy</code> instances with the <code>Model</code>.
+             *
+             * @param proxies the <code>IProxy</code> instances.
+             * @param count the number of proxies.
+             */
+            virtual void registerProxies(IProxy* const* proxies, std::size_t count);
+
+            /**
+             * Grow the tables of the <code>Model</code>, <code>View</code> and
+             * <code>Controller</code> to the given capacity.
+             *
+             * @param capacity the expected sizes of the tables.
+             */
+            virtual void reserve(CoreCapacity const& capacity);
+
+            /**
+             * Register an <code>IProxyFactory</code> with the <code>Model</code>,
+             * the proxy is built on first use.
+             *
+             * @param proxy_name the name of the proxy built by the factory.
+             * @param factory the <code>IProxyFactory</code> to be held by the <code>Model</code>.
+             */
+            virtual void registerProxyFactory(std::string const& proxy_name, IProxyFactory* factory);
+
+            /**
+             * Register an <code>IProxyFactory</code> with the <code>Model</code>,
+             * the proxy is built on first use and may be evicted.
+             *
+             * @param proxy_name the name of the proxy built by the factory.
+             * @param factory the <code>IProxyFactory</code> to be held by the <code>Model</code>.
+             */
+            virtual void registerEvictableProxyFactory(std::string const& proxy_name, IProxyFactory* factory);
+
             /**
              * Retrieve an <code>IProxy</code> from the <code>Model</code> by name.
              *
@@ -273,6 +341,22 @@ namespace PureMVC
              */
             virtual IProxy& retrieveProxy (std::string const& proxy_name);
 
+            /**
+             * Retrieve an <code>IProxy</code> instance from the <code>Model</code> without throwing.
+             *
+             * @param proxy_name the name of the <code>IProxy</code> instance to be retrieved.
+             * @return the <code>IProxy</code> instance, or <code>NULL</code> if none is registered.
+             */
+            virtual IProxy const* tryRetrieveProxy(std::string const& proxy_name) const;
+
+            /**
+             * Retrieve an <code>IProxy</code> instance from the <code>Model</code> without throwing.
+             *
+             * @param proxy_name the name of the <code>IProxy</code> instance to be retrieved.
+             * @return the <code>IProxy</code> instance, or <code>NULL</code> if none is registered.
+             */
+            virtual IProxy* tryRetrieveProxy(std::string const& proxy_name);
+
             /**
              * Remove an <code>IProxy</code> from the <code>Model</code> by name.
              *
@@ -296,6 +380,14 @@ namespace PureMVC
              */
             virtual void registerMediator(IMediator* mediator);
 
+            /**
+             * Register many <code>IMediators</code> with the <code>View</code>.
+             *
+             * @param mediators the <code>IMediator</code> instances.
+             * @param count the number of mediators.
+             */
+            virtual void registerMediators(IMediator* const* mediators, std::size_t count);
+
             /**
              * Retrieve an <code>IMediator</code> from the <code>View</code>.
              *
@@ -312,6 +404,22 @@ namespace PureMVC
              */
             virtual IMediator& retrieveMediator(std::string const& mediator_name);
 
+            /**
+             * Retrieve an <code>IMediator</code> instance from the <code>View</code> without throwing.
+             *
+             * @param mediator_name the name of the <code>IMediator</code> instance to retrieve.
+             * @return the <code>IMediator</code> instance, or <code>NULL</code> if none is registered.
+             */
+            virtual IMediator const* tryRetrieveMediator(std::string const& mediator_name) const;
+
+            /**
+             * Retrieve an <code>IMediator</code> instance from the <code>View</code> without throwing.
+             *
+             * @param mediator_name the name of the <code>IMediator</code> instance to retrieve.
+             * @return the <code>IMediator</code> instance, or <code>NULL</code> if none is registered.
+             */
+            virtual IMediator* tryRetrieveMediator(std::string const& mediator_name);
+
             /**
              * Remove an <code>IMediator</code> from the <code>View</code>.
              *
@@ -355,6 +463,45 @@ namespace PureMVC
              */
             virtual void notifyObservers(INotification const& notification);
 
+            /**
+             * Create and send an <code>INotification</code> after a delay.
+             *
+             * <P>
+             * The notification is sent from the thread of the shared <code>Timer</code>;
+             * the body must stay valid until then.</P>
+             *
+             * @param delay the number of milliseconds to wait.
+             * @param notification_name the name of the notification to send
+             * @param body the body of the notification (optional)
+             * @param type the type of the notification (optional)
+             * @return the identifier to give to <code>cancelNotification</code>.
+             */
+            virtual unsigned long sendNotificationAfter(long delay, std::string const& notification_name, void const* body = NULL, std::string const& type = "");
+
+            /**
+             * Create and send an <code>INotification</code> periodically.
+             *
+             * <P>
+             * The notification is sent from the thread of the shared <code>Timer</code>
+             * until cancelled or until the core is removed.</P>
+             *
+             * @param period the number of milliseconds between two notifications.
+             * @param notification_name the name of the notification to send
+             * @param body the body of the notification (optional)
+             * @param type the type of the notification (optional)
+             * @return the identifier to give to <code>cancelNotification</code>.
+             */
+            virtual unsigned long sendNotificationEvery(long period, std::string const& notification_name, void const* body = NULL, std::string const& type = "");
+
+            /**
+             * Cancel a delayed or periodic notification.
+             *
+             * @param timer_id the identifier returned by <code>sendNotificationAfter</code>
+             * or <code>sendNotificationEvery</code>.
+             * @return whether the notification was pending.
+             */
+            virtual bool cancelNotification(unsigned long timer_id);
+
             /**
              * Check if a Core is registered or not
              *
@@ -406,8 +553,14 @@ namespace PureMVC
             IController* _controller;
             IModel* _model;
             IView* _view;
+            // Sends the delayed notifications of this core
+            ICommand* _timer_command;
+            // Expected sizes of the tables, used by the initialize methods
+            CoreCapacity _capacity;
             // Message Constants
             static char const* const MULTITON_MSG;
+        private:
+            unsigned long scheduleNotification(long delay, long period, std::string const& notification_name, void const* body, std::string const& type);
         };
     }
 }
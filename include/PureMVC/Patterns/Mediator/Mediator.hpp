@@ -11,6 +11,7 @@
 
 // STL include
 #include <string>
+#include <cstddef>
 // PureMVC include
 #if !defined(__PUREMVC_HPP__)
 #define __PUREMVC_INCLUDE__
@@ -81,6 +82,14 @@ namespace PureMVC
              */
             virtual Mediator::NotificationNames listNotificationInterests(void) const;
 
+            /**
+             * Get the interests set by <code>setNotificationInterests</code>.
+             *
+             * @param count set to the number of names.
+             * @return the names, or <code>NULL</code> if none were set.
+             */
+            virtual std::string const* getNotificationInterests(std::size_t& count) const;
+
             /**
              * Handle <code>INotification</code>s.
              *
@@ -110,6 +119,37 @@ namespace PureMVC
              * Virtual destructor.
              */
             virtual ~Mediator(void);
+        protected:
+            /**
+             * Declare the <code>INotification</code> interests as a static array.
+             *
+             * <P>
+             * Mediators created and destroyed often declare their interests once,
+             * instead of building a list on every registration and removal:
+             * <code>
+             *     static std::string const INTERESTS[] = { "ItemChanged", "ItemRemoved" };
+             *
+             *     ItemMediator::ItemMediator(std::string const& name)
+             *         : Mediator(name)
+             *     {
+             *         setNotificationInterests(INTERESTS);
+             *     }
+             * </code>
+             * The array is not copied and must outlive the registration.</P>
+             *
+             * @param names the names, <code>NULL</code> to use <code>listNotificationInterests</code>.
+             * @param count the number of names.
+             */
+            void setNotificationInterests(std::string const* names, std::size_t count);
+
+            /**
+             * Declare the <code>INotification</code> interests as a static array.
+             */
+            template<std::size_t _Count>
+            void setNotificationInterests(std::string const (&names)[_Count])
+            {
+                setNotificationInterests(names, _Count);
+            }
 
             /**
              * The name of the <code>Mediator</code>.
@@ -124,6 +164,9 @@ namespace PureMVC
             std::string _mediator_name;
             // The view component
             void const* _view_component;
+            // The static interests, NULL if listed by listNotificationInterests
+            std::string const* _notification_interests;
+            std::size_t _notification_interest_count;
         public:
             static char const* const NAME;
         };
@@ -0,0 +1,182 @@
+//  AsyncProxy.hpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PUREMVC_PATTERNS_PROXY_ASYNC_PROXY_HPP__)
+#define __PUREMVC_PATTERNS_PROXY_ASYNC_PROXY_HPP__
+
+// STL include
+#include <string>
+#include <cstddef>
+// PureMVC include
+#if !defined(__PUREMVC_HPP__)
+#define __PUREMVC_INCLUDE__
+#include "../../PureMVC.hpp"
+#endif /* __PUREMVC_HPP__ */
+
+#include "Proxy.hpp"
+
+namespace PureMVC
+{
+    namespace Patterns
+    {
+        /**
+         * A <code>Proxy</code> loading its data on a background thread.
+         *
+         * <P>
+         * <code>onRegister</code> is called by <code>Model::registerProxy</code> on
+         * the registering thread, so a proxy reading its data there blocks the
+         * startup. An <code>AsyncProxy</code> instead queues its <code>load</code>
+         * on a shared pool of loader threads when it is registered and returns at
+         * once: many proxies load in parallel. Until <code>load</code> returns,
+         * <code>getLoadState</code> is <code>LOADING</code>; then the proxy sends
+         * <code>loaded_name</code> (or <code>failed_name</code> if <code>load</code>
+         * threw) with the proxy as body and its name as type.</P>
+         *
+         * <P>
+         * Notes:
+         * <UL>
+         * <LI>The completion notification is sent on the loader thread, its
+         * observers must be thread safe.</LI>
+         * <LI>Data set by <code>load</code> is visible to the threads which saw
+         * the <code>LOADED</code> state.</LI>
+         * <LI><code>onRemove</code> drops a load still queued and waits for a load
+         * already running. Subclasses destroyed without being removed must call
+         * <code>cancelLoad</code> in their destructor.</LI>
+         * </UL></P>
+         *
+         * <P>
+         * Usage:
+         * <code>
+         *     struct CatalogProxy : public AsyncProxy
+         *     {
+         *         CatalogProxy() : AsyncProxy("Catalog", "CatalogLoaded", "CatalogFailed") { }
+         *
+         *         virtual void load(void)
+         *         {
+         *             setData(readCatalog("catalog.dat"));
+         *         }
+         *     };
+         * </code>
+         *
+         * @see Patterns/Proxy/Proxy.hpp PureMVC::Patterns::Proxy
+         */
+        class PUREMVC_API AsyncProxy : public Proxy
+        {
+        public:
+            enum LoadState
+            {
+                UNLOADED,
+                QUEUED,
+                LOADING,
+                LOADED,
+                FAILED
+            };
+
+            enum { DEFAULT_POOL_SIZE = 4 };
+        private:
+            class Worker;
+            friend class Worker;
+        protected:
+            std::string _loaded_name;
+            std::string _failed_name;
+            std::string _error;
+            long volatile _load_state;
+            // Signaled while no load is queued or running.
+            mutable Event _idle;
+            mutable FastMutex _synchronous_access;
+        private:
+            AsyncProxy(AsyncProxy const&);
+            AsyncProxy& operator=(AsyncProxy const&);
+        public:
+            /**
+             * Constructor.
+             *
+             * @param proxy_name the name of the proxy.
+             * @param loaded_name the notification sent when the data is loaded,
+             * none if empty.
+             * @param failed_name the notification sent when the load failed,
+             * none if empty.
+             */
+            explicit AsyncProxy(std::string const& proxy_name = Proxy::NAME,
+                                std::string const& loaded_name = "",
+                                std::string const& failed_name = "");
+
+        public:
+            /**
+             * Queue the load.
+             */
+            virtual void onRegister(void);
+
+            /**
+             * Drop the queued load or wait for the running one.
+             */
+            virtual void onRemove(void);
+
+            /**
+             * Queue the load on the loader pool.
+             *
+             * @return false if the load is already queued or running.
+             */
+            bool startLoad(void);
+
+            /**
+             * Drop the load if it is still queued, else wait for it to finish.
+             */
+            void cancelLoad(void);
+
+            /**
+             * Get the state of the load.
+             */
+            LoadState getLoadState(void) const;
+
+            /**
+             * Check whether the data is loaded.
+             */
+            bool isLoaded(void) const;
+
+            /**
+             * Wait until the load and its notification are done.
+             *
+             * @param milliseconds the maximum time to wait, negative to wait
+             * forever.
+             * @return false on timeout.
+             */
+            bool waitLoad(long milliseconds = -1) const;
+
+            /**
+             * Get the message of the exception thrown by the failed load.
+             */
+            std::string getError(void) const;
+
+            /**
+             * Set the number of loader threads, <code>DEFAULT_POOL_SIZE</code>
+             * by default.
+             */
+            static void setPoolSize(std::size_t size);
+
+            /**
+             * Get the number of loader threads.
+             */
+            static std::size_t getPoolSize(void);
+
+            /**
+             * Virtual destructor.
+             */
+            virtual ~AsyncProxy(void);
+        protected:
+            /**
+             * Load the data, called on a loader thread.
+             */
+            virtual void load(void) = 0;
+        private:
+            void runLoad(void);
+        };
+    }
+}
+
+#endif /* __PUREMVC_PATTERNS_PROXY_ASYNC_PROXY_HPP__ */
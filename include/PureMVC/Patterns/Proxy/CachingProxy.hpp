@@ -0,0 +1,438 @@
+//  CachingProxy.hpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PUREMVC_PATTERNS_PROXY_CACHING_PROXY_HPP__)
+#define __PUREMVC_PATTERNS_PROXY_CACHING_PROXY_HPP__
+
+// STL include
+#include <string>
+#include <list>
+#include <map>
+#include <cstddef>
+// PureMVC include
+#if !defined(__PUREMVC_HPP__)
+#define __PUREMVC_INCLUDE__
+#include "../../PureMVC.hpp"
+#endif /* __PUREMVC_HPP__ */
+
+#include "../../Interfaces/ICacheLoader.hpp"
+#include "Proxy.hpp"
+
+namespace PureMVC
+{
+    namespace Patterns
+    {
+        using Interfaces::ICacheLoader;
+
+        /**
+         * Clock of <code>CachingProxy</code>.
+         */
+        struct PUREMVC_API CacheClock
+        {
+            /**
+             * Get the time in milliseconds, from <code>Timer::getTickCount</code>.
+             */
+            static unsigned long getTime(void);
+        };
+
+        /**
+         * An <code>ICacheLoader</code> delegating to a loader functor.
+         *
+         * <P>
+         * <code>_Loader</code> is a function or functor with the signature of
+         * <code>ICacheLoader::load</code>.</P>
+         */
+        template<typename _Key, typename _Value, typename _Loader>
+        class CacheLoader : public virtual ICacheLoader<_Key, _Value>
+        {
+        protected:
+            _Loader _loader;
+        public:
+            /**
+             * Constructor.
+             *
+             * @param loader the functor reading the values.
+             */
+            explicit CacheLoader(_Loader loader)
+                : ICacheLoader<_Key, _Value>()
+                , _loader(loader)
+            { }
+
+        public:
+            /**
+             * Read the value with the loader.
+             */
+            virtual bool load(_Key const& key, _Value& value)
+            {
+                return _loader(key, value);
+            }
+
+            /**
+             * Virtual destructor.
+             */
+            virtual ~CacheLoader(void)
+            { }
+        };
+
+        /**
+         * Create new cache loader with a loader functor.
+         */
+        template<typename _Key, typename _Value, typename _Loader>
+        inline ICacheLoader<_Key, _Value>* createCacheLoader(_Loader loader)
+        {
+            return new CacheLoader<_Key, _Value, _Loader>(loader);
+        }
+
+        /**
+         * A <code>Proxy</code> caching the values read from a slow backend.
+         *
+         * <P>
+         * <code>get</code> returns the cached value of a key, or reads it with
+         * the <code>ICacheLoader</code> on a miss. Concurrent misses on the same
+         * key are served by one load: the first caller reads the value without
+         * holding the lock, and the others block until it stores its result or
+         * fails instead of loading it again.</P>
+         *
+         * <P>
+         * Values expire <code>time_to_live</code> milliseconds after their load,
+         * never if it is negative. Keys the backend has no value for are cached
+         * as well for <code>negative_time_to_live</code> milliseconds, so
+         * repeated lookups of a missing key do not reach the backend; 0 disables
+         * it. Beyond <code>capacity</code> keys, the least recently used are
+         * evicted. A load that throws is not cached.</P>
+         *
+         * <P>
+         * <code>_Key</code> must be comparable with <code>operator&lt;</code>,
+         * <code>_Value</code> default constructible and copyable. A
+         * <code>CachingProxy</code> is synchronized, and its revision changes
+         * with every value stored.</P>
+         *
+         * <P>
+         * Usage:
+         * <code>
+         *     bool readCustomer(long const& id, Customer& customer);
+         *     ...
+         *     CachingProxy<long, Customer> customers("Customers",
+         *         createCacheLoader<long, Customer>(&readCustomer), 4096, 60000, 5000);
+         *     Customer customer;
+         *     if (customers.get(id, customer))
+         *         ...
+         * </code>
+         *
+         * @see Interfaces/ICacheLoader.hpp PureMVC::Interfaces::ICacheLoader
+         */
+        template<typename _Key, typename _Value>
+        class CachingProxy : public Proxy
+        {
+        public:
+            enum { DEFAULT_CAPACITY = 1024 };
+        protected:
+            // Keys of the loaded values, most recently used first
+            typedef std::list<_Key> UsageList;
+            // A running load, signalled when it ends, held by the loading caller
+            // and its waiters as the entry may be dropped meanwhile
+            struct Load
+            {
+                Event done;
+                long volatile references;
+
+                Load(void)
+                    : done(false)
+                    , references(1)
+                { }
+            };
+            struct Entry
+            {
+                _Value value;
+                bool found;
+                bool loading;
+                // Identifies the load storing the value
+                unsigned long ticket;
+                unsigned long loaded_at;
+                Load* pending;
+                typename UsageList::iterator position;
+
+                Entry(void)
+                    : value()
+                    , found(false)
+                    , loading(true)
+                    , ticket(0)
+                    , loaded_at(0)
+                    , pending(NULL)
+                { }
+            };
+            typedef std::map<_Key, Entry> EntryMap;
+        protected:
+            ICacheLoader<_Key, _Value>* _loader;
+            std::size_t _capacity;
+            long _time_to_live;
+            long _negative_time_to_live;
+            EntryMap _entry_map;
+            UsageList _usage_list;
+            unsigned long _ticket;
+            std::size_t _hit_count;
+            std::size_t _miss_count;
+            std::size_t _load_count;
+            mutable FastMutex _synchronous_access;
+        private:
+            CachingProxy(CachingProxy const&);
+            CachingProxy& operator=(CachingProxy const&);
+        public:
+            /**
+             * Constructor.
+             *
+             * @param proxy_name the name of the proxy.
+             * @param loader the backend, held by the proxy.
+             * @param capacity the maximum number of cached keys.
+             * @param time_to_live the lifetime of a value in milliseconds,
+             * negative for no expiry.
+             * @param negative_time_to_live the lifetime of a missing key in
+             * milliseconds, negative for no expiry, 0 to not cache them.
+             */
+            CachingProxy(std::string const& proxy_name,
+                         ICacheLoader<_Key, _Value>* loader,
+                         std::size_t capacity = DEFAULT_CAPACITY,
+                         long time_to_live = -1,
+                         long negative_time_to_live = 0)
+                : INotifier()
+                , IProxy()
+                , Proxy(proxy_name)
+                , _loader(loader)
+                , _capacity(capacity == 0 ? 1 : capacity)
+                , _time_to_live(time_to_live)
+                , _negative_time_to_live(negative_time_to_live)
+                , _ticket(0)
+                , _hit_count(0)
+                , _miss_count(0)
+                , _load_count(0)
+            { }
+
+        public:
+            /**
+             * Get the value of a key, loading it on a miss.
+             *
+             * @param key the key to look up.
+             * @param value set to the value if the key has one.
+             * @return false if the backend has no value for the key.
+             * @throws the exception of the loader if the load failed.
+             */
+            bool get(_Key const& key, _Value& value)
+            {
+                bool waited = false;
+                for (;;)
+                {
+                    unsigned long ticket = 0;
+                    Load* pending = NULL;
+                    do
+                    {
+                        FastMutex::ScopedLock lock(_synchronous_access);
+                        typename EntryMap::iterator result = _entry_map.find(key);
+                        if (result == _entry_map.end())
+                        {
+                            ++_miss_count;
+                            result = _entry_map.insert(std::make_pair(key, Entry())).first;
+                            result->second.ticket = ticket = ++_ticket;
+                            result->second.pending = pending = new Load();
+                            break;
+                        }
+                        Entry& entry = result->second;
+                        if (entry.loading)
+                        {
+                            pending = entry.pending;
+                            atomicIncrement(&pending->references);
+                            break;
+                        }
+                        // A caller which waited for a load takes its result even if it expired.
+                        if (waited || isFresh(entry))
+                        {
+                            ++_hit_count;
+                            _usage_list.splice(_usage_list.begin(), _usage_list, entry.position);
+                            if (entry.found)
+                                value = entry.value;
+                            return entry.found;
+                        }
+                        ++_miss_count;
+                        _usage_list.erase(entry.position);
+                        entry.loading = true;
+                        entry.ticket = ticket = ++_ticket;
+                        entry.pending = pending = new Load();
+                    } while (false);
+
+                    if (ticket != 0)
+                        return load(key, ticket, pending, value);
+                    waited = true;
+                    pending->done.wait();
+                    release(pending);
+                }
+            }
+
+            /**
+             * Check whether a key has a value or a missing mark which did not
+             * expire, without loading it.
+             */
+            bool contains(_Key const& key) const
+            {
+                FastMutex::ScopedLock lock(_synchronous_access);
+                typename EntryMap::const_iterator result = _entry_map.find(key);
+                return result != _entry_map.end() && !result->second.loading && isFresh(result->second);
+            }
+
+            /**
+             * Drop the cached value of a key. A load running for the key is not
+             * stored.
+             *
+             * @return true if the key was cached.
+             */
+            bool invalidate(_Key const& key)
+            {
+                FastMutex::ScopedLock lock(_synchronous_access);
+                typename EntryMap::iterator result = _entry_map.find(key);
+                if (result == _entry_map.end())
+                    return false;
+                if (!result->second.loading)
+                    _usage_list.erase(result->second.position);
+                _entry_map.erase(result);
+                return true;
+            }
+
+            /**
+             * Drop every cached value. The loads running are not stored.
+             */
+            void clear(void)
+            {
+                FastMutex::ScopedLock lock(_synchronous_access);
+                _entry_map.clear();
+                _usage_list.clear();
+            }
+
+            /**
+             * Get number of cached keys, loading ones included.
+             */
+            std::size_t getSize(void) const
+            {
+                FastMutex::ScopedLock lock(_synchronous_access);
+                return _entry_map.size();
+            }
+
+            /**
+             * Get the maximum number of cached keys.
+             */
+            std::size_t getCapacity(void) const
+            {
+                return _capacity;
+            }
+
+            /**
+             * Get number of <code>get</code> served from the cache, or by the
+             * load of another caller.
+             */
+            std::size_t getHitCount(void) const
+            {
+                FastMutex::ScopedLock lock(_synchronous_access);
+                return _hit_count;
+            }
+
+            /**
+             * Get number of <code>get</code> which started a load.
+             */
+            std::size_t getMissCount(void) const
+            {
+                FastMutex::ScopedLock lock(_synchronous_access);
+                return _miss_count;
+            }
+
+            /**
+             * Get number of loads which returned.
+             */
+            std::size_t getLoadCount(void) const
+            {
+                FastMutex::ScopedLock lock(_synchronous_access);
+                return _load_count;
+            }
+
+            /**
+             * Virtual destructor.
+             */
+            virtual ~CachingProxy(void)
+            {
+                delete _loader;
+            }
+        private:
+            bool isFresh(Entry const& entry) const
+            {
+                long time_to_live = entry.found ? _time_to_live : _negative_time_to_live;
+                return time_to_live < 0 || (long)(CacheClock::getTime() - entry.loaded_at) < time_to_live;
+            }
+
+            static void release(Load* pending)
+            {
+                if (atomicDecrement(&pending->references) == 0)
+                    delete pending;
+            }
+
+            bool load(_Key const& key, unsigned long ticket, Load* pending, _Value& value)
+            {
+                _Value loaded = _Value();
+                bool found;
+                try
+                {
+                    found = _loader->load(key, loaded);
+                }
+                catch (...)
+                {
+                    // Waiters find no entry and load the key themselves.
+                    do
+                    {
+                        FastMutex::ScopedLock lock(_synchronous_access);
+                        typename EntryMap::iterator result = _entry_map.find(key);
+                        if (result != _entry_map.end() && result->second.ticket == ticket)
+                            _entry_map.erase(result);
+                    } while (false);
+                    pending->done.set();
+                    release(pending);
+                    throw;
+                }
+                if (found)
+                    value = loaded;
+
+                do
+                {
+                    FastMutex::ScopedLock lock(_synchronous_access);
+                    ++_load_count;
+                    typename EntryMap::iterator result = _entry_map.find(key);
+                    // Invalidated while loading.
+                    if (result == _entry_map.end() || result->second.ticket != ticket)
+                        break;
+                    store(result->second, key, loaded, found);
+                } while (false);
+                pending->done.set();
+                release(pending);
+                return found;
+            }
+
+            void store(Entry& entry, _Key const& key, _Value const& loaded, bool found)
+            {
+                entry.value = loaded;
+                entry.found = found;
+                entry.loading = false;
+                entry.pending = NULL;
+                entry.loaded_at = CacheClock::getTime();
+                _usage_list.push_front(key);
+                entry.position = _usage_list.begin();
+                while (_entry_map.size() > _capacity && &_usage_list.back() != &_usage_list.front())
+                {
+                    _entry_map.erase(_usage_list.back());
+                    _usage_list.pop_back();
+                }
+                incrementRevision();
+            }
+        };
+    }
+}
+
+#endif /* __PUREMVC_PATTERNS_PROXY_CACHING_PROXY_HPP__ */
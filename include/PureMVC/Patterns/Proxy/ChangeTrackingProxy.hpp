@@ -0,0 +1,153 @@
+//  ChangeTrackingProxy.hpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PUREMVC_PATTERNS_PROXY_CHANGE_TRACKING_PROXY_HPP__)
+#define __PUREMVC_PATTERNS_PROXY_CHANGE_TRACKING_PROXY_HPP__
+
+// STL include
+#include <string>
+#include <vector>
+#include <cstddef>
+// PureMVC include
+#if !defined(__PUREMVC_HPP__)
+#define __PUREMVC_INCLUDE__
+#include "../../PureMVC.hpp"
+#endif /* __PUREMVC_HPP__ */
+
+#include "Proxy.hpp"
+
+namespace PureMVC
+{
+    namespace Patterns
+    {
+        /**
+         * A <code>Proxy</code> collecting its changes into one notification.
+         *
+         * <P>
+         * Instead of sending a notification for every mutation, a subclass marks
+         * what changed: fields by index with <code>markChanged</code> and records
+         * by id with <code>markRecordChanged</code>. Marks are gathered into a
+         * pending <code>ChangeSet</code>, which is sent as the body of a single
+         * notification:
+         * <UL>
+         * <LI>by the <code>commitChanges</code> closing the outermost
+         * <code>beginChanges</code>, for changes made in a transaction;</LI>
+         * <LI>by <code>flushChanges</code> otherwise, which the application calls
+         * once per tick.</LI>
+         * </UL></P>
+         *
+         * <P>
+         * The notification has the change name given at construction and the proxy
+         * name as type. The <code>ChangeSet</code> is only valid while the
+         * notification is dispatched. Marking is thread safe, notifications are sent
+         * on the thread calling <code>commitChanges</code> or
+         * <code>flushChanges</code>.</P>
+         *
+         * <P>
+         * Usage:
+         * <code>
+         *     proxy.beginChanges();
+         *     for (...) proxy.markRecordChanged(id);
+         *     proxy.commitChanges();
+         * </code>
+         *
+         * @see Patterns/Proxy/Proxy.hpp PureMVC::Patterns::Proxy
+         */
+        class PUREMVC_API ChangeTrackingProxy : public Proxy
+        {
+        public:
+            /**
+             * Changes sent by one notification.
+             */
+            struct PUREMVC_API ChangeSet
+            {
+                // Bit <i>n</i> is set when field <i>n</i> changed
+                unsigned long fields;
+                // Ids of changed records, sorted and unique
+                std::vector<unsigned long> records;
+
+                /**
+                 * Check whether the field changed.
+                 */
+                bool hasField(std::size_t field) const;
+
+                /**
+                 * Check whether the record changed.
+                 */
+                bool hasRecord(unsigned long id) const;
+            };
+            enum { FIELD_COUNT = sizeof(unsigned long) * 8 };
+        protected:
+            std::string _change_name;
+            ChangeSet _pending;
+            std::size_t _depth;
+            mutable FastMutex _synchronous_access;
+        private:
+            ChangeTrackingProxy(ChangeTrackingProxy const&);
+            ChangeTrackingProxy& operator=(ChangeTrackingProxy const&);
+        public:
+            /**
+             * Constructor.
+             *
+             * @param proxy_name the name of the proxy.
+             * @param change_name the name of the change notification.
+             * @param data the data object.
+             */
+            ChangeTrackingProxy(std::string const& proxy_name, std::string const& change_name, void const* data = NULL);
+
+        public:
+            /**
+             * Open a transaction, transactions can be nested.
+             */
+            virtual void beginChanges(void);
+
+            /**
+             * Close a transaction, the outermost one sends the pending changes.
+             */
+            virtual void commitChanges(void);
+
+            /**
+             * Send the pending changes, unless a transaction is open.
+             *
+             * @return whether a notification was sent.
+             */
+            virtual bool flushChanges(void);
+
+            /**
+             * Mark a field as changed.
+             *
+             * @param field the index of the field, lower than <code>FIELD_COUNT</code>.
+             */
+            void markChanged(std::size_t field);
+
+            /**
+             * Mark a record as changed.
+             *
+             * @param id the id of the record.
+             */
+            void markRecordChanged(unsigned long id);
+
+            /**
+             * Check whether changes are pending.
+             */
+            bool hasChanges(void) const;
+
+            /**
+             * Get the name of the change notification.
+             */
+            std::string const& getChangeName(void) const;
+
+            /**
+             * Virtual destructor.
+             */
+            virtual ~ChangeTrackingProxy(void);
+        };
+    }
+}
+
+#endif /* __PUREMVC_PATTERNS_PROXY_CHANGE_TRACKING_PROXY_HPP__ */
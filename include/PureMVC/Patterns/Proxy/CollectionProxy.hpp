@@ -0,0 +1,837 @@
+//  CollectionProxy.hpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PUREMVC_PATTERNS_PROXY_COLLECTION_PROXY_HPP__)
+#define __PUREMVC_PATTERNS_PROXY_COLLECTION_PROXY_HPP__
+
+// STL include
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#if defined(PUREMVC_USES_UNORDERED)
+#include <unordered_map>
+#elif defined(PUREMVC_USES_TR1)
+#if defined(__GNUC__) || defined(__MINGW32__)
+#include <tr1/unordered_map>
+#else
+#include <unordered_map>
+#endif
+#endif
+// PureMVC include
+#if !defined(__PUREMVC_HPP__)
+#define __PUREMVC_INCLUDE__
+#include "../../PureMVC.hpp"
+#endif /* __PUREMVC_HPP__ */
+
+#include "Proxy.hpp"
+
+namespace PureMVC
+{
+    namespace Patterns
+    {
+        /**
+         * Scan kernels over one column of values.
+         *
+         * <P>
+         * The kernels for <code>int</code>, <code>float</code> and <code>double</code>
+         * are vectorized with SSE2, or AVX (<code>int</code>: AVX2) when the library is
+         * built with it enabled, and fall back to scalar loops on other targets.
+         * Results on columns holding NaN are unspecified.</P>
+         */
+        struct PUREMVC_API ColumnKernels
+        {
+            /**
+             * Comparison of a value with the operand of <code>count</code>
+             * and <code>filter</code>.
+             */
+            enum Comparison
+            {
+                LESS,
+                LESS_EQUAL,
+                GREATER,
+                GREATER_EQUAL,
+                EQUAL,
+                NOT_EQUAL
+            };
+
+            /**
+             * Get the name of the instruction set used by the kernels.
+             */
+            static char const* getInstructionSet(void);
+
+            /**
+             * Sum the values.
+             */
+            static int sum(int const* values, std::size_t count);
+            static float sum(float const* values, std::size_t count);
+            static double sum(double const* values, std::size_t count);
+
+            /**
+             * Get the smallest value, <code>count</code> must not be zero.
+             */
+            static int minimum(int const* values, std::size_t count);
+            static float minimum(float const* values, std::size_t count);
+            static double minimum(double const* values, std::size_t count);
+
+            /**
+             * Get the largest value, <code>count</code> must not be zero.
+             */
+            static int maximum(int const* values, std::size_t count);
+            static float maximum(float const* values, std::size_t count);
+            static double maximum(double const* values, std::size_t count);
+
+            /**
+             * Count the values satisfying <code>value op operand</code>.
+             */
+            static std::size_t count(int const* values, std::size_t count, Comparison op, int operand);
+            static std::size_t count(float const* values, std::size_t count, Comparison op, float operand);
+            static std::size_t count(double const* values, std::size_t count, Comparison op, double operand);
+
+            /**
+             * Write the indices of the values satisfying <code>value op operand</code>.
+             *
+             * @param indices the output, room for <code>count</code> indices.
+             * @return the number of indices written.
+             */
+            static std::size_t filter(int const* values, std::size_t count, Comparison op, int operand, std::size_t* indices);
+            static std::size_t filter(float const* values, std::size_t count, Comparison op, float operand, std::size_t* indices);
+            static std::size_t filter(double const* values, std::size_t count, Comparison op, double operand, std::size_t* indices);
+        };
+
+        /**
+         * Scalar scan kernels, used for column types without vectorized kernels.
+         */
+        template<typename _Type>
+        struct ScalarColumnOperations
+        {
+            static _Type sum(_Type const* values, std::size_t count)
+            {
+                _Type result = _Type();
+                for (std::size_t i = 0; i < count; ++i)
+                    result += values[i];
+                return result;
+            }
+
+            static _Type minimum(_Type const* values, std::size_t count)
+            {
+                _Type result = values[0];
+                for (std::size_t i = 1; i < count; ++i)
+                    if (values[i] < result)
+                        result = values[i];
+                return result;
+            }
+
+            static _Type maximum(_Type const* values, std::size_t count)
+            {
+                _Type result = values[0];
+                for (std::size_t i = 1; i < count; ++i)
+                    if (result < values[i])
+                        result = values[i];
+                return result;
+            }
+
+            static bool compare(_Type value, ColumnKernels::Comparison op, _Type operand)
+            {
+                switch (op)
+                {
+                case ColumnKernels::LESS: return value < operand;
+                case ColumnKernels::LESS_EQUAL: return value <= operand;
+                case ColumnKernels::GREATER: return value > operand;
+                case ColumnKernels::GREATER_EQUAL: return value >= operand;
+                case ColumnKernels::EQUAL: return value == operand;
+                default: return value != operand;
+                }
+            }
+
+            static std::size_t count(_Type const* values, std::size_t count, ColumnKernels::Comparison op, _Type operand)
+            {
+                std::size_t result = 0;
+                for (std::size_t i = 0; i < count; ++i)
+                    if (compare(values[i], op, operand))
+                        ++result;
+                return result;
+            }
+
+            static std::size_t filter(_Type const* values, std::size_t count, ColumnKernels::Comparison op, _Type operand, std::size_t* indices)
+            {
+                std::size_t result = 0;
+                for (std::size_t i = 0; i < count; ++i)
+                    if (compare(values[i], op, operand))
+                        indices[result++] = i;
+                return result;
+            }
+        };
+
+        /**
+         * Scan kernels for a column type.
+         */
+        template<typename _Type>
+        struct ColumnOperations : public ScalarColumnOperations<_Type>
+        { };
+
+        /**
+         * Scan kernels forwarding to the vectorized <code>ColumnKernels</code>.
+         */
+        template<typename _Type>
+        struct VectorizedColumnOperations
+        {
+            static _Type sum(_Type const* values, std::size_t count)
+            {
+                return ColumnKernels::sum(values, count);
+            }
+
+            static _Type minimum(_Type const* values, std::size_t count)
+            {
+                return ColumnKernels::minimum(values, count);
+            }
+
+            static _Type maximum(_Type const* values, std::size_t count)
+            {
+                return ColumnKernels::maximum(values, count);
+            }
+
+            static std::size_t count(_Type const* values, std::size_t count, ColumnKernels::Comparison op, _Type operand)
+            {
+                return ColumnKernels::count(values, count, op, operand);
+            }
+
+            static std::size_t filter(_Type const* values, std::size_t count, ColumnKernels::Comparison op, _Type operand, std::size_t* indices)
+            {
+                return ColumnKernels::filter(values, count, op, operand, indices);
+            }
+        };
+
+        template<>
+        struct ColumnOperations<int> : public VectorizedColumnOperations<int>
+        { };
+
+        template<>
+        struct ColumnOperations<float> : public VectorizedColumnOperations<float>
+        { };
+
+        template<>
+        struct ColumnOperations<double> : public VectorizedColumnOperations<double>
+        { };
+
+        /**
+         * A <code>Proxy</code> storing records column by column.
+         *
+         * <P>
+         * A <code>std::vector</code> of structs behind <code>Proxy::getData</code>
+         * forces every scan to walk whole records. A <code>CollectionProxy</code>
+         * keeps one contiguous array per field instead (structure of arrays), so a
+         * scan of one field only reads that field, with the vectorized kernels of
+         * <code>ColumnKernels</code> for <code>int</code>, <code>float</code> and
+         * <code>double</code> fields.</P>
+         *
+         * <P>
+         * <code>_Schema</code> is the record type. It lists its columns in a static
+         * function template:
+         * <code>
+         *     struct Quote
+         *     {
+         *         double price;
+         *         int volume;
+         *
+         *         template<typename _Visitor>
+         *         static void describe(_Visitor& visitor)
+         *         {
+         *             visitor(&Quote::price);
+         *             visitor(&Quote::volume);
+         *         }
+         *     };
+         *
+         *     CollectionProxy<Quote> quotes("Quotes");
+         *     quotes.addRecord(quote);
+         *     double total = quotes.sum(&Quote::price);
+         *     quotes.filter(&Quote::volume, ColumnKernels::GREATER, 100, indices);
+         * </code></P>
+         *
+         * <P>
+         * Lookups by field value scan the column unless the field has a secondary
+         * index. <code>createIndex</code> declares a hash index, for point lookups
+         * in constant time, or a sorted index, which also answers range queries in
+         * logarithmic time. Indexes are kept up to date on every
+         * <code>addRecord</code>, <code>setRecord</code> and
+         * <code>removeRecordUnordered</code>; <code>removeRecord</code> also
+         * renumbers the records after the removed one, which is linear in the
+         * size of each index.
+         * <code>
+         *     quotes.createIndex(&Quote::volume, CollectionProxy<Quote>::SORTED_INDEX);
+         *     quotes.findRecords(&Quote::volume, 100, indices);
+         *     quotes.findRecordsInRange(&Quote::volume, 100, 200, indices);
+         * </code></P>
+         *
+         * <P>
+         * Columns are addressed by member pointer. Like <code>Proxy</code>, a
+         * <code>CollectionProxy</code> is not synchronized.</P>
+         *
+         * @see Patterns/Proxy/Proxy.hpp PureMVC::Patterns::Proxy
+         */
+        template<typename _Schema>
+        class CollectionProxy : public Proxy
+        {
+        public:
+            /**
+             * Kind of secondary index.
+             */
+            enum IndexKind
+            {
+                HASH_INDEX,
+                SORTED_INDEX
+            };
+        private:
+            struct ColumnBase
+            {
+                virtual void add(_Schema const& record) = 0;
+                virtual void assign(std::size_t index, _Schema const& record) = 0;
+                virtual void fetch(std::size_t index, _Schema& record) const = 0;
+                virtual void remove(std::size_t index) = 0;
+                virtual void removeUnordered(std::size_t index) = 0;
+                virtual void reserve(std::size_t capacity) = 0;
+                virtual void clear(void) = 0;
+                virtual ~ColumnBase(void)
+                { }
+            };
+
+            template<typename _Type>
+            struct Column : public ColumnBase
+            {
+                _Type _Schema::* member;
+                std::vector<_Type> values;
+
+                explicit Column(_Type _Schema::* member)
+                    : member(member)
+                { }
+
+                virtual void add(_Schema const& record)
+                {
+                    values.push_back(record.*member);
+                }
+
+                virtual void assign(std::size_t index, _Schema const& record)
+                {
+                    values[index] = record.*member;
+                }
+
+                virtual void fetch(std::size_t index, _Schema& record) const
+                {
+                    record.*member = values[index];
+                }
+
+                virtual void remove(std::size_t index)
+                {
+                    values.erase(values.begin() + index);
+                }
+
+                virtual void removeUnordered(std::size_t index)
+                {
+                    values[index] = values.back();
+                    values.pop_back();
+                }
+
+                virtual void reserve(std::size_t capacity)
+                {
+                    values.reserve(capacity);
+                }
+
+                virtual void clear(void)
+                {
+                    values.clear();
+                }
+            };
+
+            struct ColumnBuilder
+            {
+                std::vector<ColumnBase*>& columns;
+
+                explicit ColumnBuilder(std::vector<ColumnBase*>& columns)
+                    : columns(columns)
+                { }
+
+                template<typename _Type>
+                void operator()(_Type _Schema::* member)
+                {
+                    columns.push_back(new Column<_Type>(member));
+                }
+            };
+
+            // Indexes map a field value to the positions of the records holding it,
+            // reading the values from their column.
+            struct IndexBase
+            {
+                IndexKind kind;
+                ColumnBase const* source;
+
+                IndexBase(IndexKind kind, ColumnBase const* source)
+                    : kind(kind)
+                    , source(source)
+                { }
+
+                virtual void insert(std::size_t position) = 0;
+                virtual void erase(std::size_t position) = 0;
+                virtual void shift(std::size_t position) = 0;
+                virtual void clear(void) = 0;
+                virtual ~IndexBase(void)
+                { }
+            };
+
+            template<typename _Type, typename _Map>
+            struct Index : public IndexBase
+            {
+                typedef _Map Map;
+
+                Column<_Type> const& column;
+                Map entries;
+
+                Index(IndexKind kind, Column<_Type> const& column)
+                    : IndexBase(kind, &column)
+                    , column(column)
+                { }
+
+                virtual void insert(std::size_t position)
+                {
+                    entries.insert(std::make_pair(column.values[position], position));
+                }
+
+                virtual void erase(std::size_t position)
+                {
+                    std::pair<typename _Map::iterator, typename _Map::iterator> range = entries.equal_range(column.values[position]);
+                    for (; range.first != range.second; ++range.first)
+                    {
+                        if (range.first->second != position)
+                            continue;
+                        entries.erase(range.first);
+                        break;
+                    }
+                }
+
+                virtual void shift(std::size_t position)
+                {
+                    for (typename _Map::iterator result = entries.begin(); result != entries.end(); ++result)
+                        if (result->second > position)
+                            --result->second;
+                }
+
+                virtual void clear(void)
+                {
+                    entries.clear();
+                }
+
+                void find(_Type const& key, std::vector<std::size_t>& indices) const
+                {
+                    std::pair<typename _Map::const_iterator, typename _Map::const_iterator> range = entries.equal_range(key);
+                    for (; range.first != range.second; ++range.first)
+                        indices.push_back(range.first->second);
+                }
+            };
+
+            template<typename _Type>
+            struct HashIndex
+            {
+#if defined(PUREMVC_USES_UNORDERED)
+                typedef Index<_Type, std::unordered_multimap<_Type, std::size_t> > type;
+#elif defined(PUREMVC_USES_TR1)
+                typedef Index<_Type, std::tr1::unordered_multimap<_Type, std::size_t> > type;
+#else
+                typedef Index<_Type, std::multimap<_Type, std::size_t> > type;
+#endif
+            };
+
+            template<typename _Type>
+            struct SortedIndex
+            {
+                typedef Index<_Type, std::multimap<_Type, std::size_t> > type;
+            };
+        protected:
+            std::vector<ColumnBase*> _columns;
+            std::vector<IndexBase*> _indexes;
+            std::size_t _size;
+        private:
+            CollectionProxy(CollectionProxy const&);
+            CollectionProxy& operator=(CollectionProxy const&);
+        public:
+            /**
+             * Constructor.
+             *
+             * @param proxy_name the name of the proxy.
+             */
+            explicit CollectionProxy(std::string const& proxy_name = Proxy::NAME)
+                : INotifier()
+                , IProxy()
+                , Proxy(proxy_name)
+                , _size(0)
+            {
+                ColumnBuilder builder(_columns);
+                _Schema::describe(builder);
+            }
+
+        public:
+            /**
+             * Append a record.
+             */
+            void addRecord(_Schema const& record)
+            {
+                for (std::size_t i = 0; i < _columns.size(); ++i)
+                    _columns[i]->add(record);
+                for (std::size_t i = 0; i < _indexes.size(); ++i)
+                    _indexes[i]->insert(_size);
+                ++_size;
+                incrementRevision();
+            }
+
+            /**
+             * Replace the record at <code>index</code>.
+             */
+            void setRecord(std::size_t index, _Schema const& record)
+            {
+                checkIndex(index);
+                for (std::size_t i = 0; i < _indexes.size(); ++i)
+                    _indexes[i]->erase(index);
+                for (std::size_t i = 0; i < _columns.size(); ++i)
+                    _columns[i]->assign(index, record);
+                for (std::size_t i = 0; i < _indexes.size(); ++i)
+                    _indexes[i]->insert(index);
+                incrementRevision();
+            }
+
+            /**
+             * Gather the record at <code>index</code>.
+             *
+             * <P>
+             * Fields not listed as columns are default initialized.</P>
+             */
+            _Schema getRecord(std::size_t index) const
+            {
+                checkIndex(index);
+                _Schema record = _Schema();
+                for (std::size_t i = 0; i < _columns.size(); ++i)
+                    _columns[i]->fetch(index, record);
+                return record;
+            }
+
+            /**
+             * Remove the record at <code>index</code>, keeping the order.
+             */
+            void removeRecord(std::size_t index)
+            {
+                checkIndex(index);
+                for (std::size_t i = 0; i < _indexes.size(); ++i)
+                    _indexes[i]->erase(index);
+                for (std::size_t i = 0; i < _columns.size(); ++i)
+                    _columns[i]->remove(index);
+                for (std::size_t i = 0; i < _indexes.size(); ++i)
+                    _indexes[i]->shift(index);
+                --_size;
+                incrementRevision();
+            }
+
+            /**
+             * Remove the record at <code>index</code>, moving the last record
+             * into its place.
+             *
+             * <P>
+             * Unlike <code>removeRecord</code>, only the two records involved
+             * are updated in the indexes.</P>
+             */
+            void removeRecordUnordered(std::size_t index)
+            {
+                checkIndex(index);
+                std::size_t last = _size - 1;
+                for (std::size_t i = 0; i < _indexes.size(); ++i)
+                {
+                    _indexes[i]->erase(index);
+                    if (index != last)
+                        _indexes[i]->erase(last);
+                }
+                for (std::size_t i = 0; i < _columns.size(); ++i)
+                    _columns[i]->removeUnordered(index);
+                if (index != last)
+                    for (std::size_t i = 0; i < _indexes.size(); ++i)
+                        _indexes[i]->insert(index);
+                --_size;
+                incrementRevision();
+            }
+
+            /**
+             * Get number of records.
+             */
+            std::size_t getRecordCount(void) const
+            {
+                return _size;
+            }
+
+            /**
+             * Reserve room for <code>capacity</code> records in every column.
+             */
+            void reserve(std::size_t capacity)
+            {
+                for (std::size_t i = 0; i < _columns.size(); ++i)
+                    _columns[i]->reserve(capacity);
+            }
+
+            /**
+             * Remove all records.
+             */
+            void clear(void)
+            {
+                for (std::size_t i = 0; i < _columns.size(); ++i)
+                    _columns[i]->clear();
+                for (std::size_t i = 0; i < _indexes.size(); ++i)
+                    _indexes[i]->clear();
+                _size = 0;
+                incrementRevision();
+            }
+
+            /**
+             * Get the contiguous values of a column, valid until the next change.
+             */
+            template<typename _Type>
+            _Type const* getColumn(_Type _Schema::* member) const
+            {
+                std::vector<_Type> const& values = findColumn(member).values;
+                return values.empty() ? NULL : &values[0];
+            }
+
+            /**
+             * Sum a column.
+             */
+            template<typename _Type>
+            _Type sum(_Type _Schema::* member) const
+            {
+                return ColumnOperations<_Type>::sum(getColumn(member), _size);
+            }
+
+            /**
+             * Get the smallest value of a column.
+             *
+             * @throws std::runtime_error if the collection is empty.
+             */
+            template<typename _Type>
+            _Type minimum(_Type _Schema::* member) const
+            {
+                checkIndex(0);
+                return ColumnOperations<_Type>::minimum(getColumn(member), _size);
+            }
+
+            /**
+             * Get the largest value of a column.
+             *
+             * @throws std::runtime_error if the collection is empty.
+             */
+            template<typename _Type>
+            _Type maximum(_Type _Schema::* member) const
+            {
+                checkIndex(0);
+                return ColumnOperations<_Type>::maximum(getColumn(member), _size);
+            }
+
+            /**
+             * Count the records whose field satisfies <code>field op operand</code>.
+             */
+            template<typename _Type>
+            std::size_t count(_Type _Schema::* member, ColumnKernels::Comparison op, _Type operand) const
+            {
+                return ColumnOperations<_Type>::count(getColumn(member), _size, op, operand);
+            }
+
+            /**
+             * Collect the indices of the records whose field satisfies
+             * <code>field op operand</code>, in increasing order.
+             *
+             * @param indices replaced by the indices found.
+             * @return the number of indices found.
+             */
+            template<typename _Type>
+            std::size_t filter(_Type _Schema::* member, ColumnKernels::Comparison op, _Type operand, std::vector<std::size_t>& indices) const
+            {
+                indices.resize(_size);
+                std::size_t result = _size == 0 ? 0 :
+                    ColumnOperations<_Type>::filter(getColumn(member), _size, op, operand, &indices[0]);
+                indices.resize(result);
+                return result;
+            }
+
+            /**
+             * Create a secondary index on a column, built from the current records.
+             *
+             * <P>
+             * Does nothing if the column already has an index of this kind.</P>
+             *
+             * @param member the column to index.
+             * @param kind <code>HASH_INDEX</code> for point lookups or
+             * <code>SORTED_INDEX</code> for point and range lookups.
+             */
+            template<typename _Type>
+            void createIndex(_Type _Schema::* member, IndexKind kind = HASH_INDEX)
+            {
+                if (findIndex(member, kind) != NULL)
+                    return;
+                IndexBase* index;
+                if (kind == SORTED_INDEX)
+                    index = new typename SortedIndex<_Type>::type(kind, findColumn(member));
+                else
+                    index = new typename HashIndex<_Type>::type(kind, findColumn(member));
+                for (std::size_t i = 0; i < _size; ++i)
+                    index->insert(i);
+                _indexes.push_back(index);
+            }
+
+            /**
+             * Remove the secondary indexes of a column.
+             */
+            template<typename _Type>
+            void removeIndex(_Type _Schema::* member)
+            {
+                IndexBase* index;
+                while ((index = findIndex(member, HASH_INDEX)) != NULL || (index = findIndex(member, SORTED_INDEX)) != NULL)
+                {
+                    _indexes.erase(std::find(_indexes.begin(), _indexes.end(), index));
+                    delete index;
+                }
+            }
+
+            /**
+             * Check whether a column has a secondary index of a kind.
+             */
+            template<typename _Type>
+            bool hasIndex(_Type _Schema::* member, IndexKind kind = HASH_INDEX) const
+            {
+                return findIndex(member, kind) != NULL;
+            }
+
+            /**
+             * Collect the indices of the records whose field equals <code>key</code>,
+             * in increasing order.
+             *
+             * <P>
+             * Uses an index of the column if any, else scans the column.</P>
+             *
+             * @param indices replaced by the indices found.
+             * @return the number of indices found.
+             */
+            template<typename _Type>
+            std::size_t findRecords(_Type _Schema::* member, _Type const& key, std::vector<std::size_t>& indices) const
+            {
+                indices.clear();
+                IndexBase const* index = findIndex(member, HASH_INDEX);
+                if (index == NULL)
+                    index = findIndex(member, SORTED_INDEX);
+                if (index == NULL)
+                {
+                    std::vector<_Type> const& values = findColumn(member).values;
+                    for (std::size_t i = 0; i < _size; ++i)
+                        if (values[i] == key)
+                            indices.push_back(i);
+                    return indices.size();
+                }
+                if (index->kind == SORTED_INDEX)
+                    static_cast<typename SortedIndex<_Type>::type const*>(index)->find(key, indices);
+                else
+                    static_cast<typename HashIndex<_Type>::type const*>(index)->find(key, indices);
+                std::sort(indices.begin(), indices.end());
+                return indices.size();
+            }
+
+            /**
+             * Find one record whose field equals <code>key</code>.
+             *
+             * @param index set to the index of the record found.
+             * @return <code>true</code> if a record was found.
+             */
+            template<typename _Type>
+            bool findRecord(_Type _Schema::* member, _Type const& key, std::size_t& index) const
+            {
+                std::vector<std::size_t> indices;
+                if (findRecords(member, key, indices) == 0)
+                    return false;
+                index = indices.front();
+                return true;
+            }
+
+            /**
+             * Collect the indices of the records whose field is in
+             * <code>[lower, upper)</code>, in increasing order.
+             *
+             * <P>
+             * Uses a sorted index of the column if any, else scans the column.</P>
+             *
+             * @param indices replaced by the indices found.
+             * @return the number of indices found.
+             */
+            template<typename _Type>
+            std::size_t findRecordsInRange(_Type _Schema::* member, _Type const& lower, _Type const& upper, std::vector<std::size_t>& indices) const
+            {
+                typedef typename SortedIndex<_Type>::type index_t;
+                indices.clear();
+                index_t const* index = static_cast<index_t const*>(findIndex(member, SORTED_INDEX));
+                if (index == NULL)
+                {
+                    std::vector<_Type> const& values = findColumn(member).values;
+                    for (std::size_t i = 0; i < _size; ++i)
+                        if (!(values[i] < lower) && values[i] < upper)
+                            indices.push_back(i);
+                    return indices.size();
+                }
+                if (!(lower < upper))
+                    return 0;
+                typename index_t::Map::const_iterator first = index->entries.lower_bound(lower);
+                typename index_t::Map::const_iterator last = index->entries.lower_bound(upper);
+                for (; first != last; ++first)
+                    indices.push_back(first->second);
+                std::sort(indices.begin(), indices.end());
+                return indices.size();
+            }
+
+            /**
+             * Virtual destructor.
+             */
+            virtual ~CollectionProxy(void)
+            {
+                for (std::size_t i = 0; i < _indexes.size(); ++i)
+                    delete _indexes[i];
+                for (std::size_t i = 0; i < _columns.size(); ++i)
+                    delete _columns[i];
+            }
+        private:
+            void checkIndex(std::size_t index) const
+            {
+                if (index >= _size)
+                    throw std::runtime_error("Record index is out of range in collection proxy [" + _proxy_name + "].");
+            }
+
+            template<typename _Type>
+            Column<_Type> const& findColumn(_Type _Schema::* member) const
+            {
+                for (std::size_t i = 0; i < _columns.size(); ++i)
+                {
+                    Column<_Type> const* column = dynamic_cast<Column<_Type> const*>(_columns[i]);
+                    if (column != NULL && column->member == member)
+                        return *column;
+                }
+                throw std::runtime_error("Cannot find column in collection proxy [" + _proxy_name + "].");
+            }
+
+            template<typename _Type>
+            IndexBase* findIndex(_Type _Schema::* member, IndexKind kind) const
+            {
+                ColumnBase const* column = &findColumn(member);
+                for (std::size_t i = 0; i < _indexes.size(); ++i)
+                    if (_indexes[i]->kind == kind && _indexes[i]->source == column)
+                        return _indexes[i];
+                return NULL;
+            }
+        };
+    }
+}
+
+#endif /* __PUREMVC_PATTERNS_PROXY_COLLECTION_PROXY_HPP__ */
@@ -0,0 +1,235 @@
+//  DerivedProxy.hpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PUREMVC_PATTERNS_PROXY_DERIVED_PROXY_HPP__)
+#define __PUREMVC_PATTERNS_PROXY_DERIVED_PROXY_HPP__
+
+// STL include
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <stdexcept>
+// PureMVC include
+#if !defined(__PUREMVC_HPP__)
+#define __PUREMVC_INCLUDE__
+#include "../../PureMVC.hpp"
+#endif /* __PUREMVC_HPP__ */
+
+#include "Proxy.hpp"
+
+namespace PureMVC
+{
+    namespace Patterns
+    {
+        /**
+         * A <code>Proxy</code> holding a value computed from other proxies.
+         *
+         * <P>
+         * Recomputing derived values on every notification wastes work when the
+         * inputs did not change. A <code>DerivedProxy</code> declares its input
+         * proxies with <code>addInput</code> and remembers their revisions at the
+         * last computation. <code>getValue</code> only calls <code>compute</code>
+         * when the revision of an input changed since, and the revision of the
+         * <code>DerivedProxy</code> itself only changes when the computed value
+         * differs from the previous one, so proxies derived from it are not
+         * recomputed either.</P>
+         *
+         * <P>
+         * Inputs are checked on demand: a <code>DerivedProxy</code> used as the
+         * input of another one refreshes itself when its revision is read, which
+         * walks the dependency graph down to the changed proxies. When a
+         * notification name is given, the refresh that changes the value sends it
+         * with the value as body and the proxy name as type.</P>
+         *
+         * <P>
+         * <code>_Value</code> must be default constructible, copyable and
+         * comparable with <code>operator==</code>. Like <code>Proxy</code>, a
+         * <code>DerivedProxy</code> is not synchronized.</P>
+         *
+         * <P>
+         * Usage:
+         * <code>
+         *     struct TotalProxy : public DerivedProxy<double>
+         *     {
+         *         TotalProxy(CartProxy& cart, TaxProxy& tax)
+         *             : DerivedProxy<double>("Total", "TotalChanged"), _cart(cart), _tax(tax)
+         *         {
+         *             addInput(cart);
+         *             addInput(tax);
+         *         }
+         *
+         *         virtual void compute(double& value)
+         *         {
+         *             value = _cart.getSubtotal() * (1.0 + _tax.getRate());
+         *         }
+         *     };
+         * </code>
+         *
+         * @see Patterns/Proxy/Proxy.hpp PureMVC::Patterns::Proxy
+         */
+        template<typename _Value>
+        class DerivedProxy : public Proxy
+        {
+        private:
+            struct Input
+            {
+                Proxy const* proxy;
+                long revision;
+
+                explicit Input(Proxy const* proxy)
+                    : proxy(proxy)
+                    , revision(0)
+                { }
+            };
+        protected:
+            std::string _change_name;
+            std::vector<Input> _inputs;
+            _Value _value;
+            std::size_t _compute_count;
+            bool _computed;
+            bool _refreshing;
+        private:
+            DerivedProxy(DerivedProxy const&);
+            DerivedProxy& operator=(DerivedProxy const&);
+        public:
+            /**
+             * Constructor.
+             *
+             * @param proxy_name the name of the proxy.
+             * @param change_name the notification sent when the value changes,
+             * none if empty.
+             */
+            explicit DerivedProxy(std::string const& proxy_name = Proxy::NAME, std::string const& change_name = "")
+                : INotifier()
+                , IProxy()
+                , Proxy(proxy_name)
+                , _change_name(change_name)
+                , _value()
+                , _compute_count(0)
+                , _computed(false)
+                , _refreshing(false)
+            {
+                _data = &_value;
+            }
+
+        public:
+            /**
+             * Get the value, computing it first if an input changed.
+             */
+            _Value const& getValue(void)
+            {
+                refresh();
+                return _value;
+            }
+
+            /**
+             * Compute the value if an input changed since the last computation.
+             *
+             * @return true if the value changed.
+             * @throws std::runtime_error if the proxy depends on itself.
+             */
+            bool refresh(void)
+            {
+                if (_refreshing)
+                    throw std::runtime_error("Cycle in the inputs of derived proxy [" + _proxy_name + "].");
+                _refreshing = true;
+                // Revisions read since the first change, stored once compute
+                // succeeded: an input stays dirty when compute throws.
+                std::vector<long> revisions;
+                try
+                {
+                    // Read every revision, refreshing the derived inputs.
+                    for (std::size_t i = 0; i < _inputs.size(); ++i)
+                    {
+                        long revision = _inputs[i].proxy->getRevision();
+                        if (revision != _inputs[i].revision && revisions.empty())
+                        {
+                            revisions.resize(_inputs.size());
+                            for (std::size_t j = 0; j < i; ++j)
+                                revisions[j] = _inputs[j].revision;
+                        }
+                        if (!revisions.empty())
+                            revisions[i] = revision;
+                    }
+                }
+                catch (...)
+                {
+                    _refreshing = false;
+                    throw;
+                }
+                _refreshing = false;
+                if (_computed && revisions.empty())
+                    return false;
+
+                _Value value = _Value();
+                compute(value);
+                for (std::size_t i = 0; i < revisions.size(); ++i)
+                    _inputs[i].revision = revisions[i];
+                ++_compute_count;
+                bool first = !_computed;
+                _computed = true;
+                if (!first && value == _value)
+                    return false;
+                _value = value;
+                incrementRevision();
+                if (!_change_name.empty())
+                    sendNotification(_change_name, &_value, _proxy_name);
+                return true;
+            }
+
+            /**
+             * Get the revision of the value, refreshing it first.
+             */
+            virtual long getRevision(void) const
+            {
+                const_cast<DerivedProxy*>(this)->refresh();
+                return Proxy::getRevision();
+            }
+
+            /**
+             * Get number of calls to <code>compute</code>.
+             */
+            std::size_t getComputeCount(void) const
+            {
+                return _compute_count;
+            }
+
+            /**
+             * Force a computation on the next refresh.
+             */
+            void invalidate(void)
+            {
+                _computed = false;
+            }
+
+            /**
+             * Virtual destructor.
+             */
+            virtual ~DerivedProxy(void)
+            { }
+        protected:
+            /**
+             * Declare an input, the value is computed again when its revision changes.
+             */
+            void addInput(Proxy const& proxy)
+            {
+                _inputs.push_back(Input(&proxy));
+                _computed = false;
+            }
+
+            /**
+             * Compute the value from the inputs.
+             *
+             * @param value default constructed, set to the new value.
+             */
+            virtual void compute(_Value& value) = 0;
+        };
+    }
+}
+
+#endif /* __PUREMVC_PATTERNS_PROXY_DERIVED_PROXY_HPP__ */
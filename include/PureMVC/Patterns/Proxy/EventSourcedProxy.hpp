@@ -0,0 +1,413 @@
+//  EventSourcedProxy.hpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PUREMVC_PATTERNS_PROXY_EVENT_SOURCED_PROXY_HPP__)
+#define __PUREMVC_PATTERNS_PROXY_EVENT_SOURCED_PROXY_HPP__
+
+// STL include
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdio>
+#include <cstddef>
+#include <stdexcept>
+// PureMVC include
+#if !defined(__PUREMVC_HPP__)
+#define __PUREMVC_INCLUDE__
+#include "../../PureMVC.hpp"
+#endif /* __PUREMVC_HPP__ */
+
+#include "Proxy.hpp"
+#include "MappedFileProxy.hpp"
+
+namespace PureMVC
+{
+    namespace Patterns
+    {
+        /**
+         * A <code>Proxy</code> whose state is built from an append-only log of events.
+         *
+         * <P>
+         * Every <code>append</code> writes the event to a log on disk before
+         * applying it to the state, so the state can be rebuilt after a restart.
+         * Replaying the whole history would make recovery time grow with it: every
+         * <code>snapshot_interval</code> events, the state is written to a snapshot
+         * and the log before it is deleted. <code>open</code> maps the latest
+         * snapshot and only replays the events appended after it.</P>
+         *
+         * <P>
+         * Files are named after <code>path</code>:
+         * <code>
+         *     path.snapshot        MappedFileHeader format, one SnapshotRecord
+         *     path.00000000.log    events 0 to segment_size - 1
+         *     path.00000001.log    events segment_size to 2 * segment_size - 1
+         * </code>
+         * Segments hold the memory image of the events back to back. An event
+         * partially written by a crash is dropped on <code>open</code>. Events are
+         * flushed to the operating system on <code>append</code>, not synced to
+         * the device.</P>
+         *
+         * <P>
+         * <code>_Event</code> and <code>_State</code> must be POD types without
+         * pointers. Subclasses implement <code>apply</code>. Like <code>Proxy</code>,
+         * an <code>EventSourcedProxy</code> is not synchronized.</P>
+         *
+         * <P>
+         * Usage:
+         * <code>
+         *     AccountProxy proxy("Account", "data/account");
+         *     proxy.open();
+         *     proxy.append(deposit);
+         *     long balance = proxy.getState().balance;
+         * </code>
+         *
+         * @see Patterns/Proxy/MappedFileProxy.hpp PureMVC::Patterns::MappedFileProxy
+         */
+        template<typename _Event, typename _State>
+        class EventSourcedProxy : public Proxy
+        {
+        public:
+            enum { DEFAULT_SEGMENT_SIZE = 65536, DEFAULT_SNAPSHOT_INTERVAL = 65536 };
+
+            /**
+             * Content of the snapshot file.
+             */
+            struct SnapshotRecord
+            {
+                unsigned int sequence_low;
+                unsigned int sequence_high;
+                _State state;
+            };
+        protected:
+            std::string _path;
+            std::size_t _segment_size;
+            std::size_t _snapshot_interval;
+            _State _initial_state;
+            _State _state;
+            std::size_t _sequence;
+            std::size_t _snapshot_sequence;
+            std::ofstream _log;
+            std::size_t _log_segment;
+            bool _opened;
+        private:
+            EventSourcedProxy(EventSourcedProxy const&);
+            EventSourcedProxy& operator=(EventSourcedProxy const&);
+        public:
+            /**
+             * Constructor.
+             *
+             * @param proxy_name the name of the proxy.
+             * @param path the prefix of the log and snapshot files.
+             * @param segment_size the number of events per log segment.
+             * @param snapshot_interval the number of events between snapshots.
+             * @param state the state before the first event.
+             */
+            EventSourcedProxy(std::string const& proxy_name,
+                              std::string const& path,
+                              std::size_t segment_size = DEFAULT_SEGMENT_SIZE,
+                              std::size_t snapshot_interval = DEFAULT_SNAPSHOT_INTERVAL,
+                              _State const& state = _State())
+                : INotifier()
+                , IProxy()
+                , Proxy(proxy_name)
+                , _path(path)
+                , _segment_size(segment_size == 0 ? 1 : segment_size)
+                , _snapshot_interval(snapshot_interval == 0 ? 1 : snapshot_interval)
+                , _initial_state(state)
+                , _state(state)
+                , _sequence(0)
+                , _snapshot_sequence(0)
+                , _log_segment(0)
+                , _opened(false)
+            {
+                _data = &_state;
+            }
+
+        public:
+            /**
+             * Recover the state from the snapshot and the log, and open the log
+             * for appending.
+             *
+             * <P>
+             * Replay stops at the first segment which is not full. A segment on
+             * disk after it means events are missing, for example the snapshot
+             * covering the deleted segments was lost: <code>open</code> fails
+             * instead of rebuilding a state without them.</P>
+             *
+             * @throws std::runtime_error if the files are unreadable or
+             * inconsistent.
+             */
+            void open(void)
+            {
+                close();
+                _state = _initial_state;
+                _sequence = 0;
+                _snapshot_sequence = 0;
+                loadSnapshot();
+
+                std::size_t segment_end = findSegmentEnd();
+                std::size_t segment = _sequence / _segment_size;
+                std::size_t offset = _sequence % _segment_size;
+                for (;; ++segment, offset = 0)
+                {
+                    std::size_t count = replaySegment(segment, offset);
+                    if (count < _segment_size)
+                        break;
+                }
+                if (segment + 1 < segment_end)
+                    throw std::runtime_error("Event log is missing events before: [" + getSegmentPath(segment_end - 1) + "].");
+                openSegment(_sequence / _segment_size, false);
+                _opened = true;
+                incrementRevision();
+            }
+
+            /**
+             * Close the log.
+             */
+            void close(void)
+            {
+                if (_log.is_open())
+                    _log.close();
+                _log.clear();
+                _opened = false;
+            }
+
+            /**
+             * Write the event to the log and apply it to the state.
+             *
+             * @throws std::runtime_error if the log is not open or cannot be
+             * written.
+             */
+            void append(_Event const& event)
+            {
+                if (!_opened)
+                    throw std::runtime_error("Event log is not open in proxy [" + _proxy_name + "].");
+                if (_sequence / _segment_size != _log_segment)
+                    openSegment(_sequence / _segment_size, true);
+                _log.write((char const*)&event, sizeof(_Event));
+                _log.flush();
+                if (_log.fail())
+                    throw std::runtime_error("Cannot write event log: [" + _path + "].");
+                apply(_state, event);
+                ++_sequence;
+                incrementRevision();
+                if (_sequence - _snapshot_sequence >= _snapshot_interval)
+                    snapshot();
+            }
+
+            /**
+             * Write the state to the snapshot and delete the log segments it
+             * covers.
+             *
+             * @throws std::runtime_error if the snapshot cannot be written.
+             */
+            void snapshot(void)
+            {
+                SnapshotRecord record;
+                record.sequence_low = (unsigned int)(_sequence & 0xFFFFFFFFUL);
+                record.sequence_high = (unsigned int)((_sequence >> 16) >> 16);
+                record.state = _state;
+
+                // Replace the previous snapshot only once the new one is complete.
+                std::string path = getSnapshotPath();
+                std::string temporary = path + ".tmp";
+                MappedFileProxy<SnapshotRecord>::writeFile(temporary, &record, 1);
+                if (!replaceFile(temporary, path))
+                    throw std::runtime_error("Cannot write snapshot: [" + path + "].");
+                _snapshot_sequence = _sequence;
+
+                for (std::size_t segment = _sequence / _segment_size; segment-- > 0;)
+                    if (std::remove(getSegmentPath(segment).c_str()) != 0)
+                        break;
+            }
+
+            /**
+             * Get the current state.
+             */
+            _State const& getState(void) const
+            {
+                return _state;
+            }
+
+            /**
+             * Get number of events applied to the state.
+             */
+            std::size_t getSequence(void) const
+            {
+                return _sequence;
+            }
+
+            /**
+             * Get number of events covered by the last snapshot.
+             */
+            std::size_t getSnapshotSequence(void) const
+            {
+                return _snapshot_sequence;
+            }
+
+            /**
+             * Get the path of the snapshot file.
+             */
+            std::string getSnapshotPath(void) const
+            {
+                return _path + ".snapshot";
+            }
+
+            /**
+             * Get the path of a log segment.
+             */
+            std::string getSegmentPath(std::size_t segment) const
+            {
+                std::ostringstream result;
+                result << _path << '.' << std::setw(8) << std::setfill('0') << segment << ".log";
+                return result.str();
+            }
+
+            /**
+             * Virtual destructor.
+             */
+            virtual ~EventSourcedProxy(void)
+            {
+                close();
+            }
+        protected:
+            /**
+             * Apply an event to the state.
+             *
+             * <P>
+             * Called on <code>append</code> and for every event replayed by
+             * <code>open</code>.</P>
+             */
+            virtual void apply(_State& state, _Event const& event) = 0;
+        private:
+            static bool exists(std::string const& path)
+            {
+                std::ifstream input(path.c_str(), std::ios::in | std::ios::binary);
+                return input.is_open();
+            }
+
+            // Returns one past the highest log segment on disk.
+            std::size_t findSegmentEnd(void) const
+            {
+                std::string::size_type slash = _path.find_last_of("/\\");
+                std::string directory = slash == std::string::npos ? std::string() : _path.substr(0, slash + 1);
+                std::string prefix = (slash == std::string::npos ? _path : _path.substr(slash + 1)) + '.';
+                std::string const suffix = ".log";
+                std::vector<std::string> names;
+                if (!listFiles(directory, names))
+                    throw std::runtime_error("Cannot list event log: [" + _path + "].");
+
+                std::size_t result = 0;
+                for (std::size_t i = 0; i < names.size(); ++i)
+                {
+                    std::string const& name = names[i];
+                    if (name.size() <= prefix.size() + suffix.size()
+                        || name.compare(0, prefix.size(), prefix) != 0
+                        || name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0)
+                        continue;
+                    std::string digits = name.substr(prefix.size(), name.size() - prefix.size() - suffix.size());
+                    if (digits.find_first_not_of("0123456789") != std::string::npos)
+                        continue;
+                    std::size_t segment = 0;
+                    std::istringstream(digits) >> segment;
+                    if (segment + 1 > result)
+                        result = segment + 1;
+                }
+                return result;
+            }
+
+            void loadSnapshot(void)
+            {
+                std::string path = getSnapshotPath();
+                if (!exists(path))
+                    return;
+                MappedFileProxy<SnapshotRecord> snapshot(_proxy_name, path);
+                if (snapshot.getRecordCount() != 1)
+                    throw std::runtime_error("Invalid snapshot: [" + path + "].");
+                SnapshotRecord const& record = snapshot.getRecord(0);
+                _sequence = (std::size_t)record.sequence_low;
+                if (record.sequence_high != 0)
+                    _sequence |= ((std::size_t)record.sequence_high << 16) << 16;
+                _state = record.state;
+                _snapshot_sequence = _sequence;
+            }
+
+            // Replays the events of a segment from offset, returns the number of
+            // complete events in the segment.
+            std::size_t replaySegment(std::size_t segment, std::size_t offset)
+            {
+                std::string path = getSegmentPath(segment);
+                std::ifstream input(path.c_str(), std::ios::in | std::ios::binary);
+                if (!input.is_open())
+                {
+                    if (offset != 0)
+                        throw std::runtime_error("Event log is behind snapshot: [" + path + "].");
+                    return 0;
+                }
+                input.seekg(0, std::ios::end);
+                std::size_t size = (std::size_t)input.tellg();
+                std::size_t count = size / sizeof(_Event);
+                if (count < offset)
+                    throw std::runtime_error("Event log is behind snapshot: [" + path + "].");
+                input.seekg((std::streamoff)(offset * sizeof(_Event)), std::ios::beg);
+                _Event event;
+                for (std::size_t i = offset; i < count; ++i)
+                {
+                    if (!input.read((char*)&event, sizeof(_Event)))
+                        throw std::runtime_error("Cannot read event log: [" + path + "].");
+                    apply(_state, event);
+                    ++_sequence;
+                }
+                input.close();
+                if (size % sizeof(_Event) != 0)
+                    truncateSegment(path, count);
+                return count;
+            }
+
+            // Drops the partially written event at the end of a segment.
+            void truncateSegment(std::string const& path, std::size_t count)
+            {
+                std::vector<char> events(count * sizeof(_Event));
+                do
+                {
+                    std::ifstream input(path.c_str(), std::ios::in | std::ios::binary);
+                    if (!events.empty() && !input.read(&events[0], (std::streamsize)events.size()))
+                        throw std::runtime_error("Cannot read event log: [" + path + "].");
+                } while (false);
+                std::string temporary = path + ".tmp";
+                do
+                {
+                    std::ofstream output(temporary.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+                    if (!events.empty())
+                        output.write(&events[0], (std::streamsize)events.size());
+                    output.close();
+                    if (output.fail())
+                        throw std::runtime_error("Cannot write event log: [" + temporary + "].");
+                } while (false);
+                if (!replaceFile(temporary, path))
+                    throw std::runtime_error("Cannot write event log: [" + path + "].");
+            }
+
+            void openSegment(std::size_t segment, bool create)
+            {
+                if (_log.is_open())
+                    _log.close();
+                _log.clear();
+                std::string path = getSegmentPath(segment);
+                _log.open(path.c_str(), std::ios::out | std::ios::binary | (create ? std::ios::trunc : std::ios::app));
+                if (!_log.is_open())
+                    throw std::runtime_error("Cannot open event log: [" + path + "].");
+                _log_segment = segment;
+            }
+        };
+    }
+}
+
+#endif /* __PUREMVC_PATTERNS_PROXY_EVENT_SOURCED_PROXY_HPP__ */
@@ -0,0 +1,276 @@
+//  MappedFileProxy.hpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PUREMVC_PATTERNS_PROXY_MAPPED_FILE_PROXY_HPP__)
+#define __PUREMVC_PATTERNS_PROXY_MAPPED_FILE_PROXY_HPP__
+
+// STL include
+#include <string>
+#include <fstream>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+// PureMVC include
+#if !defined(__PUREMVC_HPP__)
+#define __PUREMVC_INCLUDE__
+#include "../../PureMVC.hpp"
+#endif /* __PUREMVC_HPP__ */
+
+#include "Proxy.hpp"
+
+namespace PureMVC
+{
+    namespace Patterns
+    {
+        /**
+         * Header of the files read by <code>MappedFileProxy</code>.
+         *
+         * <P>
+         * The layout is 32 bytes of unsigned 32 bit integers in native byte order,
+         * followed by the records:
+         * <code>
+         *     offset  0: magic       "PMVCDATA"
+         *     offset  8: version     1
+         *     offset 12: data_offset offset of the first record, multiple of 8, at least 32
+         *     offset 16: record_size size of one record in bytes
+         *     offset 20: record_type tag chosen by the application, 0 when unused
+         *     offset 24: count_low   number of records, low 32 bits
+         *     offset 28: count_high  number of records, high 32 bits
+         * </code>
+         * The records are stored back to back from <code>data_offset</code>, as
+         * their in-memory image. A file written on a platform with a different
+         * byte order is rejected by its <code>version</code>.</P>
+         */
+        struct MappedFileHeader
+        {
+            enum { VERSION = 1, SIZE = 32 };
+
+            char magic[8];
+            unsigned int version;
+            unsigned int data_offset;
+            unsigned int record_size;
+            unsigned int record_type;
+            unsigned int count_low;
+            unsigned int count_high;
+
+            static char const* getMagic(void)
+            {
+                return "PMVCDATA";
+            }
+        };
+
+        /**
+         * A <code>Proxy</code> exposing the records of a memory mapped file.
+         *
+         * <P>
+         * Parsing a large dataset into heap objects at startup is slow and keeps
+         * a second copy of the file in memory. A <code>MappedFileProxy</code> maps
+         * a file in the <code>MappedFileHeader</code> format and points
+         * <code>getData</code> at its first record: nothing is read or copied on
+         * <code>load</code>, pages are loaded on first access, and processes
+         * mapping the same file share its pages.</P>
+         *
+         * <P>
+         * <code>_Record</code> must be a POD type without pointers, with an
+         * alignment of at most 8 bytes. The records are read only and stay valid
+         * until <code>unload</code> or the destruction of the proxy.</P>
+         *
+         * <P>
+         * Usage:
+         * <code>
+         *     MappedFileProxy<Quote>::writeFile("quotes.bin", quotes, count);
+         *     ...
+         *     MappedFileProxy<Quote> proxy("Quotes", "quotes.bin");
+         *     Quote const* quotes = (Quote const*)proxy.getData();
+         *     double price = proxy.getRecord(i).price;
+         * </code>
+         *
+         * @see Patterns/Proxy/Proxy.hpp PureMVC::Patterns::Proxy
+         */
+        template<typename _Record>
+        class MappedFileProxy : public Proxy
+        {
+        protected:
+            MemoryMappedFile _file;
+            _Record const* _records;
+            std::size_t _count;
+            unsigned int _record_type;
+        private:
+            MappedFileProxy(MappedFileProxy const&);
+            MappedFileProxy& operator=(MappedFileProxy const&);
+        public:
+            /**
+             * Constructor.
+             *
+             * @param proxy_name the name of the proxy.
+             * @param path the file to load, none if empty.
+             * @param record_type the expected record type, <code>0</code> to
+             * accept any.
+             */
+            explicit MappedFileProxy(std::string const& proxy_name = Proxy::NAME,
+                                     std::string const& path = "",
+                                     unsigned int record_type = 0)
+                : INotifier()
+                , IProxy()
+                , Proxy(proxy_name)
+                , _records(NULL)
+                , _count(0)
+                , _record_type(record_type)
+            {
+                if (!path.empty())
+                    load(path);
+            }
+
+        public:
+            /**
+             * Map the file, replacing the loaded one.
+             *
+             * @throws std::runtime_error if the file cannot be mapped or does not
+             * hold records of this type.
+             */
+            void load(std::string const& path)
+            {
+                unload();
+                _file.open(path);
+                std::size_t size = _file.getSize();
+                char const* data = (char const*)_file.getData();
+                MappedFileHeader header;
+                if (size < (std::size_t)MappedFileHeader::SIZE)
+                    fail("File is too small for a header", path);
+                std::memcpy(&header, data, sizeof(header));
+                if (std::memcmp(header.magic, MappedFileHeader::getMagic(), sizeof(header.magic)) != 0)
+                    fail("Invalid file format", path);
+                if (header.version != MappedFileHeader::VERSION)
+                    fail("Unsupported version or byte order", path);
+                if (header.record_size != sizeof(_Record))
+                    fail("Record size mismatch", path);
+                if (_record_type != 0 && header.record_type != _record_type)
+                    fail("Record type mismatch", path);
+                if (header.data_offset < (unsigned int)MappedFileHeader::SIZE || header.data_offset % 8 != 0 || header.data_offset > size)
+                    fail("Invalid data offset", path);
+                std::size_t count = getCount(header);
+                if (count > (size - header.data_offset) / sizeof(_Record))
+                    fail("File is truncated", path);
+                _records = (_Record const*)(data + header.data_offset);
+                _count = count;
+                _data = _records;
+                incrementRevision();
+            }
+
+            /**
+             * Unmap the file.
+             */
+            void unload(void)
+            {
+                if (_data != NULL)
+                    incrementRevision();
+                _data = NULL;
+                _records = NULL;
+                _count = 0;
+                _file.close();
+            }
+
+            /**
+             * Check whether a file is loaded.
+             */
+            bool isLoaded(void) const
+            {
+                return _file.isOpen();
+            }
+
+            /**
+             * Get the records, <code>NULL</code> if no file is loaded.
+             */
+            _Record const* getRecords(void) const
+            {
+                return _records;
+            }
+
+            /**
+             * Get number of records.
+             */
+            std::size_t getRecordCount(void) const
+            {
+                return _count;
+            }
+
+            /**
+             * Get the record at <code>index</code>.
+             *
+             * @throws std::runtime_error if the index is out of range.
+             */
+            _Record const& getRecord(std::size_t index) const
+            {
+                if (index >= _count)
+                    throw std::runtime_error("Record index is out of range in mapped file proxy [" + _proxy_name + "].");
+                return _records[index];
+            }
+
+            /**
+             * Write records to a file in the <code>MappedFileHeader</code> format.
+             *
+             * @param path the path of the file, replaced if it exists.
+             * @param records the records to write.
+             * @param count the number of records.
+             * @param record_type the record type tag.
+             * @throws std::runtime_error if the file cannot be written.
+             */
+            static void writeFile(std::string const& path,
+                                  _Record const* records,
+                                  std::size_t count,
+                                  unsigned int record_type = 0)
+            {
+                MappedFileHeader header;
+                std::memcpy(header.magic, MappedFileHeader::getMagic(), sizeof(header.magic));
+                header.version = MappedFileHeader::VERSION;
+                header.data_offset = MappedFileHeader::SIZE;
+                header.record_size = sizeof(_Record);
+                header.record_type = record_type;
+                header.count_low = (unsigned int)(count & 0xFFFFFFFFUL);
+                // Two shifts keep the expression defined for a 32 bit size_t.
+                header.count_high = (unsigned int)((count >> 16) >> 16);
+
+                std::ofstream output(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+                output.write((char const*)&header, sizeof(header));
+                if (count != 0)
+                    output.write((char const*)records, (std::streamsize)(count * sizeof(_Record)));
+                output.close();
+                if (output.fail())
+                    throw std::runtime_error("Cannot write file: [" + path + "].");
+            }
+
+            /**
+             * Virtual destructor.
+             */
+            virtual ~MappedFileProxy(void)
+            {
+                unload();
+            }
+        private:
+            void fail(char const* reason, std::string const& path)
+            {
+                unload();
+                throw std::runtime_error(std::string(reason) + ": [" + path + "].");
+            }
+
+            static std::size_t getCount(MappedFileHeader const& header)
+            {
+                std::size_t count = (std::size_t)header.count_low;
+                if (header.count_high != 0)
+                {
+                    if (sizeof(std::size_t) <= 4)
+                        return ~(std::size_t)0;
+                    count |= ((std::size_t)header.count_high << 16) << 16;
+                }
+                return count;
+            }
+        };
+    }
+}
+
+#endif /* __PUREMVC_PATTERNS_PROXY_MAPPED_FILE_PROXY_HPP__ */
@@ -80,6 +80,17 @@ namespace PureMVC
              */
             virtual void const* getData(void) const;
 
+            /**
+             * Get the revision of the data.
+             *
+             * <P>
+             * The revision starts at <code>0</code> and is incremented on every
+             * <code>setData</code> and by subclasses changing their data in place,
+             * so a reader can tell whether the data changed since it last looked
+             * by comparing revisions.</P>
+             */
+            virtual long getRevision(void) const;
+
             /**
              * Called by the Model when the Proxy is registered.
              */
@@ -99,11 +110,18 @@ namespace PureMVC
              * Virtual destructor.
              */
             virtual ~Proxy(void);
+        protected:
+            /**
+             * Increment the revision, to be called after changing the data in place.
+             */
+            void incrementRevision(void);
         protected:
             // the proxy name
             std::string _proxy_name;
             // the data object
             void const* _data;
+            // the revision of the data object
+            long volatile _revision;
         public:
             static char const* const NAME;
         };
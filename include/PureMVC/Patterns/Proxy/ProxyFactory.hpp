@@ -0,0 +1,115 @@
+//  ProxyFactory.hpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PUREMVC_PATTERNS_PROXY_PROXY_FACTORY_HPP__)
+#define __PUREMVC_PATTERNS_PROXY_PROXY_FACTORY_HPP__
+
+// STL include
+#include <string>
+// PureMVC include
+#if !defined(__PUREMVC_HPP__)
+#define __PUREMVC_INCLUDE__
+#include "../../PureMVC.hpp"
+#endif /* __PUREMVC_HPP__ */
+
+#include "../../Interfaces/IProxy.hpp"
+#include "../../Interfaces/IProxyFactory.hpp"
+
+namespace PureMVC
+{
+    namespace Patterns
+    {
+        using Interfaces::IProxy;
+        using Interfaces::IProxyFactory;
+
+        /**
+         * Proxy creator calling the default constructor.
+         */
+        template<typename _Proxy>
+        struct DefaultProxyCreator
+        {
+            /**
+             * Create new proxy.
+             */
+            inline IProxy* operator()(std::string const&) const
+            {
+                return new _Proxy();
+            }
+        };
+
+        /**
+         * An <code>IProxyFactory</code> delegating to a creator functor.
+         *
+         * <P>
+         * <code>_Creator</code> is a function or functor taking the proxy name
+         * and returning a new <code>IProxy*</code>.</P>
+         *
+         * <P>
+         * Usage:
+         * <code>
+         *     model.registerProxyFactory(AccountProxy::NAME, createProxyFactory<AccountProxy>());
+         *     model.registerProxyFactory("Settings", createProxyFactory(&createSettingsProxy));
+         * </code>
+         *
+         * @see Core/Model.hpp PureMVC::Core::Model
+         */
+        template<typename _Creator>
+        class ProxyFactory : public virtual IProxyFactory
+        {
+        protected:
+            _Creator _creator;
+        public:
+            /**
+             * Constructor.
+             *
+             * @param creator the functor creating the proxy.
+             */
+            explicit ProxyFactory(_Creator creator)
+                : IProxyFactory()
+                , _creator(creator)
+            { }
+
+        public:
+            /**
+             * Create the <code>IProxy</code> with the creator.
+             *
+             * @param proxy_name the name the proxy is registered with.
+             */
+            virtual IProxy* createProxy(std::string const& proxy_name)
+            {
+                return _creator(proxy_name);
+            }
+
+            /**
+             * Virtual destructor.
+             */
+            virtual ~ProxyFactory(void)
+            { }
+        };
+
+        /**
+         * Create new proxy factory with a creator functor.
+         */
+        template<typename _Creator>
+        inline IProxyFactory* createProxyFactory(_Creator creator)
+        {
+            return new ProxyFactory<_Creator>(creator);
+        }
+
+        /**
+         * Create new proxy factory of default constructed proxies.
+         */
+        template<typename _Proxy>
+        inline IProxyFactory* createProxyFactory(void)
+        {
+            return new ProxyFactory<DefaultProxyCreator<_Proxy> >(DefaultProxyCreator<_Proxy>());
+        }
+    }
+}
+
+#endif /* __PUREMVC_PATTERNS_PROXY_PROXY_FACTORY_HPP__ */
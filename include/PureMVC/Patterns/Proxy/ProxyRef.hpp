@@ -0,0 +1,193 @@
+//  ProxyRef.hpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PUREMVC_PATTERNS_PROXY_PROXY_REF_HPP__)
+#define __PUREMVC_PATTERNS_PROXY_PROXY_REF_HPP__
+
+// STL include
+#include <string>
+#include <stdexcept>
+// PureMVC include
+#if !defined(__PUREMVC_HPP__)
+#define __PUREMVC_INCLUDE__
+#include "../../PureMVC.hpp"
+#endif /* __PUREMVC_HPP__ */
+
+#include "../../Interfaces/IModel.hpp"
+#include "../../Interfaces/INotifier.hpp"
+#include "../../Core/Model.hpp"
+
+namespace PureMVC
+{
+    namespace Patterns
+    {
+        using Interfaces::IModel;
+        using Interfaces::IProxy;
+        using Interfaces::INotifier;
+
+        /**
+         * A typed handle to an <code>IProxy</code> registered with a <code>Model</code>.
+         *
+         * <P>
+         * <code>retrieveProxy</code> hashes the name, takes the lock of the
+         * <code>Model</code> and searches its map on every call. A <code>ProxyRef</code>
+         * does this once, casts the result to <code>_Proxy</code> and keeps the pointer
+         * together with the generation of the <code>Model</code>. Later accesses only
+         * compare the generation: the proxy is searched again after any
+         * <code>removeProxy</code> on the same <code>Model</code>.</P>
+         *
+         * <P>
+         * A <code>ProxyRef</code> is meant to be a member of the mediator or command
+         * using it. It is not synchronized, not even through a <code>const</code>
+         * reference: every access may update the cached pointer and generation.
+         * Give each thread its own copy.</P>
+         *
+         * <P>
+         * Usage:
+         * <code>
+         *     ProxyRef<AccountProxy> _account(*this, AccountProxy::NAME);
+         *     ...
+         *     _account->deposit(amount);
+         * </code>
+         *
+         * @see Core/Model.hpp PureMVC::Core::Model
+         */
+        template<typename _Proxy>
+        class ProxyRef
+        {
+        private:
+            INotifier const* _notifier;
+            mutable IModel* _model;
+            std::string _proxy_name;
+            mutable _Proxy* _proxy;
+            mutable long _generation;
+        public:
+            /**
+             * Constructor.
+             *
+             * @param model the <code>IModel</code> holding the proxy.
+             * @param proxy_name the name of the proxy.
+             */
+            ProxyRef(IModel& model, std::string const& proxy_name)
+                : _notifier(NULL)
+                , _model(&model)
+                , _proxy_name(proxy_name)
+                , _proxy(NULL)
+                , _generation(0)
+            { }
+
+            /**
+             * Constructor.
+             *
+             * <P>
+             * The <code>Model</code> is looked up from the multiton key of
+             * <code>notifier</code> on first access, so the handle can be built
+             * before the notifier is registered.</P>
+             *
+             * @param notifier the <code>IMediator</code>, <code>IProxy</code> or
+             * <code>ICommand</code> providing the multiton key.
+             * @param proxy_name the name of the proxy.
+             */
+            ProxyRef(INotifier const& notifier, std::string const& proxy_name)
+                : _notifier(&notifier)
+                , _model(NULL)
+                , _proxy_name(proxy_name)
+                , _proxy(NULL)
+                , _generation(0)
+            { }
+
+            /**
+             * Copy constructor.
+             */
+            ProxyRef(ProxyRef const& arg)
+                : _notifier(arg._notifier)
+                , _model(arg._model)
+                , _proxy_name(arg._proxy_name)
+                , _proxy(arg._proxy)
+                , _generation(arg._generation)
+            { }
+
+            /**
+             * Assignment operator.
+             */
+            ProxyRef& operator=(ProxyRef const& arg)
+            {
+                _notifier = arg._notifier;
+                _model = arg._model;
+                _proxy_name = arg._proxy_name;
+                _proxy = arg._proxy;
+                _generation = arg._generation;
+                return *this;
+            }
+
+        public:
+            /**
+             * Get the proxy.
+             *
+             * @return the proxy, or <code>NULL</code> if no proxy of type
+             * <code>_Proxy</code> is registered with the name.
+             */
+            _Proxy* get(void) const
+            {
+                if (_model == NULL)
+                    _model = &Core::Model::getInstance(_notifier->getMultitonKey());
+                long generation = _model->getGeneration();
+                if (_proxy != NULL && _generation == generation)
+                    return _proxy;
+                // Read the generation first: a removal during the lookup
+                // forces the next access to search again.
+                _generation = generation;
+                _proxy = dynamic_cast<_Proxy*>(_model->tryRetrieveProxy(_proxy_name));
+                return _proxy;
+            }
+
+            /**
+             * Access the proxy.
+             *
+             * @throws std::runtime_error if no proxy of type <code>_Proxy</code>
+             * is registered with the name.
+             */
+            _Proxy* operator->(void) const
+            {
+                return &operator*();
+            }
+
+            /**
+             * Access the proxy.
+             *
+             * @throws std::runtime_error if no proxy of type <code>_Proxy</code>
+             * is registered with the name.
+             */
+            _Proxy& operator*(void) const
+            {
+                _Proxy* proxy = get();
+                if (proxy == NULL)
+                    throw std::runtime_error("Cannot find any proxy with name: [" + _proxy_name + "].");
+                return *proxy;
+            }
+
+            /**
+             * Forget the cached pointer, the next access searches the proxy again.
+             */
+            void reset(void)
+            {
+                _proxy = NULL;
+            }
+
+            /**
+             * Get the name of the proxy.
+             */
+            std::string const& getProxyName(void) const
+            {
+                return _proxy_name;
+            }
+        };
+    }
+}
+
+#endif /* __PUREMVC_PATTERNS_PROXY_PROXY_REF_HPP__ */
@@ -0,0 +1,187 @@
+//  ProxySnapshot.hpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PUREMVC_PATTERNS_PROXY_PROXY_SNAPSHOT_HPP__)
+#define __PUREMVC_PATTERNS_PROXY_PROXY_SNAPSHOT_HPP__
+
+// STL include
+#include <string>
+#include <map>
+#include <cstddef>
+// PureMVC include
+#if !defined(__PUREMVC_HPP__)
+#define __PUREMVC_INCLUDE__
+#include "../../PureMVC.hpp"
+#endif /* __PUREMVC_HPP__ */
+
+#include "../../Interfaces/IModel.hpp"
+#include "../../Interfaces/IProxyFactory.hpp"
+#include "../../Interfaces/ISerializable.hpp"
+
+namespace PureMVC
+{
+    namespace Patterns
+    {
+        using Interfaces::IModel;
+        using Interfaces::IProxyFactory;
+        using Interfaces::ISerializable;
+
+        /**
+         * A snapshot of the proxies of a core in one binary file.
+         *
+         * <P>
+         * Rebuilding a core on restart means registering every proxy again and
+         * reloading its data. <code>save</code> walks
+         * <code>IModel::listProxyNames</code> and writes the image of every proxy
+         * implementing <code>ISerializable</code> to one file. On restart,
+         * <code>open</code> maps the file and <code>restore</code> hands each
+         * image to the proxy registered with its name, or builds the proxy with
+         * the factory registered for its serial type and registers it.</P>
+         *
+         * <P>
+         * The file is in the <code>MappedFileHeader</code> format with
+         * <code>RECORD_TYPE</code> as record type: its records are the
+         * <code>Entry</code> table, followed by the proxy names and the images,
+         * each image aligned to 8 bytes. The images stay mapped until
+         * <code>close</code>, so a proxy may keep pointers into its image while
+         * the snapshot is open instead of copying it.</P>
+         *
+         * <P>
+         * Proxies are not locked during <code>save</code> and
+         * <code>restore</code>: no other thread may change them meanwhile. Like
+         * the proxies built by <code>IModel::registerProxyFactory</code>, the
+         * proxies built by <code>restore</code> are deleted by the application
+         * after <code>removeProxy</code>.</P>
+         *
+         * <P>
+         * Usage:
+         * <code>
+         *     ProxySnapshot::save(Model::getInstance("Main"), "main.snapshot");
+         *     ...
+         *     ProxySnapshot snapshot("main.snapshot");
+         *     snapshot.registerFactory(CatalogProxy::SERIAL_TYPE, createProxyFactory<CatalogProxy>());
+         *     snapshot.restore(Model::getInstance("Main"));
+         * </code>
+         *
+         * @see Interfaces/ISerializable.hpp PureMVC::Interfaces::ISerializable
+         * @see Patterns/Proxy/MappedFileProxy.hpp PureMVC::Patterns::MappedFileHeader
+         */
+        class PUREMVC_API ProxySnapshot
+        {
+        public:
+            enum { RECORD_TYPE = 0x50414E53 };
+
+            /**
+             * Record of the snapshot file describing one proxy. Offsets are
+             * from the start of the file.
+             */
+            struct Entry
+            {
+                unsigned int name_offset;
+                unsigned int name_size;
+                unsigned int serial_type;
+                unsigned int reserved;
+                unsigned int data_offset_low;
+                unsigned int data_offset_high;
+                unsigned int data_size_low;
+                unsigned int data_size_high;
+            };
+        protected:
+            typedef std::map<unsigned int, IProxyFactory*> FactoryMap;
+        protected:
+            MemoryMappedFile _file;
+            Entry const* _entries;
+            std::size_t _count;
+            FactoryMap _factory_map;
+        private:
+            ProxySnapshot(ProxySnapshot const&);
+            ProxySnapshot& operator=(ProxySnapshot const&);
+        public:
+            /**
+             * Constructor.
+             *
+             * @param path the snapshot to open, none if empty.
+             */
+            explicit ProxySnapshot(std::string const& path = "");
+
+        public:
+            /**
+             * Write the serializable proxies of a model to a snapshot file.
+             *
+             * <P>
+             * The file is replaced with <code>replaceFile</code> once the new
+             * snapshot is complete. Proxies not built yet by their factory are
+             * skipped, and are not built.</P>
+             *
+             * @param model the model holding the proxies.
+             * @param path the path of the snapshot file.
+             * @return the number of proxies written.
+             * @throws std::runtime_error if the file cannot be written.
+             */
+            static std::size_t save(IModel const& model, std::string const& path);
+
+            /**
+             * Map a snapshot file, replacing the opened one.
+             *
+             * @throws std::runtime_error if the file cannot be mapped or is not
+             * a snapshot.
+             */
+            void open(std::string const& path);
+
+            /**
+             * Unmap the snapshot file.
+             */
+            void close(void);
+
+            /**
+             * Check whether a snapshot is opened.
+             */
+            bool isOpen(void) const;
+
+            /**
+             * Get number of proxies in the snapshot.
+             */
+            std::size_t getCount(void) const;
+
+            /**
+             * Register the factory building the proxies of a serial type which
+             * are not registered when <code>restore</code> runs.
+             *
+             * <P>
+             * The snapshot holds the factory and replaces the one registered
+             * earlier for this serial type.</P>
+             */
+            void registerFactory(unsigned int serial_type, IProxyFactory* factory);
+
+            /**
+             * Restore the proxies of the snapshot into a model.
+             *
+             * <P>
+             * A proxy registered with the name of an image reads it with
+             * <code>deserialize</code>. Otherwise, the factory of its serial
+             * type builds the proxy, which reads the image and is registered.
+             * Images without a proxy nor a factory are skipped.</P>
+             *
+             * @param model the model to restore.
+             * @return the number of proxies restored.
+             * @throws std::runtime_error if no snapshot is opened, or the
+             * registered proxy of an image is not serializable.
+             */
+            std::size_t restore(IModel& model);
+
+            /**
+             * Virtual destructor.
+             */
+            virtual ~ProxySnapshot(void);
+        private:
+            void fail(char const* reason, std::string const& path);
+        };
+    }
+}
+
+#endif /* __PUREMVC_PATTERNS_PROXY_PROXY_SNAPSHOT_HPP__ */
@@ -0,0 +1,285 @@
+//  VersionedProxy.hpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PUREMVC_PATTERNS_PROXY_VERSIONED_PROXY_HPP__)
+#define __PUREMVC_PATTERNS_PROXY_VERSIONED_PROXY_HPP__
+
+// STL include
+#include <string>
+#include <cstddef>
+// PureMVC include
+#if !defined(__PUREMVC_HPP__)
+#define __PUREMVC_INCLUDE__
+#include "../../PureMVC.hpp"
+#endif /* __PUREMVC_HPP__ */
+
+#include "Proxy.hpp"
+
+namespace PureMVC
+{
+    namespace Patterns
+    {
+        /**
+         * Wait of <code>VersionedProxy::publish</code> for the readers of the
+         * previous epoch.
+         */
+        struct PUREMVC_API VersionSpin
+        {
+            /**
+             * Spin for the first turns, then give way with
+             * <code>Thread::sleep(0)</code>.
+             *
+             * @param idle the number of turns waited, incremented.
+             */
+            static void pause(std::size_t& idle);
+        };
+
+        /**
+         * A <code>Proxy</code> holding immutable versions of its data.
+         *
+         * <P>
+         * <code>Proxy::getData</code> and <code>Proxy::setData</code> exchange a raw
+         * pointer without any synchronization. A <code>VersionedProxy</code> instead
+         * copies every value given to <code>publish</code> into a new version and
+         * replaces the current version atomically. <code>getSnapshot</code> returns
+         * a reference counted handle to the current version: readers never take a
+         * lock and keep a consistent value for as long as they hold the handle, while
+         * writers go on publishing. A version is destroyed when it is no longer
+         * current and the last handle to it is released.</P>
+         *
+         * <P>
+         * Readers announce themselves on one of two counters selected by an epoch
+         * for the few instructions between loading the current version and taking
+         * a reference to it. <code>publish</code> switches the epoch and waits for
+         * the readers of the previous epoch before releasing the replaced version,
+         * so a version is never destroyed under a reader. Writers are serialized
+         * with each other.</P>
+         *
+         * <P>
+         * Usage:
+         * <code>
+         *     VersionedProxy<Settings> proxy("Settings");
+         *     proxy.publish(new_settings);
+         *     VersionedProxy<Settings>::Snapshot settings = proxy.getSnapshot();
+         *     draw(settings->theme);
+         * </code>
+         *
+         * @see Patterns/Proxy/Proxy.hpp PureMVC::Patterns::Proxy
+         */
+        template<typename _Type>
+        class VersionedProxy : public Proxy
+        {
+        private:
+            struct Version
+            {
+                _Type value;
+                long number;
+                long volatile references;
+
+                Version(_Type const& value, long number)
+                    : value(value)
+                    , number(number)
+                    , references(1)
+                { }
+            };
+        public:
+            /**
+             * Reference counted handle to one version of the data.
+             */
+            class Snapshot
+            {
+                friend class VersionedProxy;
+            private:
+                Version* _version;
+            private:
+                explicit Snapshot(Version* version)
+                    : _version(version)
+                { }
+            public:
+                /**
+                 * Constructor of an empty handle.
+                 */
+                Snapshot(void)
+                    : _version(NULL)
+                { }
+
+                /**
+                 * Copy constructor.
+                 */
+                Snapshot(Snapshot const& arg)
+                    : _version(arg._version)
+                {
+                    if (_version != NULL)
+                        atomicIncrement(&_version->references);
+                }
+
+                /**
+                 * Assignment operator.
+                 */
+                Snapshot& operator=(Snapshot const& arg)
+                {
+                    if (arg._version != NULL)
+                        atomicIncrement(&arg._version->references);
+                    release(_version);
+                    _version = arg._version;
+                    return *this;
+                }
+
+                /**
+                 * Access the value of the version.
+                 */
+                _Type const& operator*(void) const
+                {
+                    return _version->value;
+                }
+
+                /**
+                 * Access the value of the version.
+                 */
+                _Type const* operator->(void) const
+                {
+                    return &_version->value;
+                }
+
+                /**
+                 * Get the number of the version, starting from zero.
+                 */
+                long getVersion(void) const
+                {
+                    return _version == NULL ? -1 : _version->number;
+                }
+
+                /**
+                 * Check whether the handle is empty.
+                 */
+                bool isNull(void) const
+                {
+                    return _version == NULL;
+                }
+
+                /**
+                 * Destructor, releases the version.
+                 */
+                ~Snapshot(void)
+                {
+                    release(_version);
+                }
+            };
+        protected:
+            void* volatile _current;
+            mutable long volatile _epoch;
+            mutable long volatile _readers[2];
+            FastMutex _write_access;
+        private:
+            VersionedProxy(VersionedProxy const&);
+            VersionedProxy& operator=(VersionedProxy const&);
+        public:
+            /**
+             * Constructor.
+             *
+             * @param proxy_name the name of the proxy.
+             * @param value the value of the first version.
+             */
+            explicit VersionedProxy(std::string const& proxy_name = Proxy::NAME, _Type const& value = _Type())
+                : INotifier()
+                , IProxy()
+                , Proxy(proxy_name)
+                , _current(new Version(value, 0))
+                , _epoch(0)
+            {
+                _readers[0] = 0;
+                _readers[1] = 0;
+            }
+
+        public:
+            /**
+             * Get a handle to the current version, without locking.
+             */
+            Snapshot getSnapshot(void) const
+            {
+                long epoch;
+                for (;;)
+                {
+                    epoch = atomicLoad(&_epoch);
+                    atomicIncrement(&_readers[epoch & 1]);
+                    // The writer switching this epoch will wait for us.
+                    if (atomicLoad(&_epoch) == epoch)
+                        break;
+                    atomicDecrement(&_readers[epoch & 1]);
+                }
+                Version* version = (Version*)atomicLoadPointer(&_current);
+                atomicIncrement(&version->references);
+                atomicDecrement(&_readers[epoch & 1]);
+                return Snapshot(version);
+            }
+
+            /**
+             * Publish a copy of the value as the current version.
+             *
+             * <P>
+             * Readers holding a previous version keep it unchanged.</P>
+             *
+             * @param value the new value.
+             * @return the number of the new version.
+             */
+            long publish(_Type const& value)
+            {
+                Version* version = new Version(value, 0);
+                Version* previous;
+                long number;
+                do
+                {
+                    FastMutex::ScopedLock lock(_write_access);
+                    previous = (Version*)_current;
+                    number = previous->number + 1;
+                    version->number = number;
+                    atomicExchangePointer(&_current, version);
+                    incrementRevision();
+
+                    long epoch = _epoch;
+                    atomicExchange(&_epoch, epoch + 1);
+                    // Readers of the previous epoch may still be taking a
+                    // reference to the previous version: spin briefly, then
+                    // give way in case one of them was preempted.
+                    std::size_t idle = 0;
+                    while (atomicLoad(&_readers[epoch & 1]) != 0)
+                        VersionSpin::pause(idle);
+                } while (false);
+                release(previous);
+                return number;
+            }
+
+            /**
+             * Get the number of the current version.
+             */
+            long getVersion(void) const
+            {
+                return getSnapshot().getVersion();
+            }
+
+            /**
+             * Virtual destructor.
+             *
+             * <P>
+             * Handles still held keep their version alive.</P>
+             */
+            virtual ~VersionedProxy(void)
+            {
+                release((Version*)_current);
+            }
+        private:
+            static void release(Version* version)
+            {
+                if (version != NULL && atomicDecrement(&version->references) == 0)
+                    delete version;
+            }
+        };
+    }
+}
+
+#endif /* __PUREMVC_PATTERNS_PROXY_VERSIONED_PROXY_HPP__ */
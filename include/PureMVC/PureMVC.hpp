@@ -99,6 +99,23 @@
 #define PUREMVC_USES_TR1
 #endif
 
+// Macro support std::unordered_map and std::unordered_multimap for C++11
+#if (defined(__cplusplus) && __cplusplus >= 201103L) || (defined(_MSC_VER) && _MSC_VER >= 1600)
+#define PUREMVC_USES_UNORDERED
+#endif
+
+// Macro support coroutine for C++20
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __cpp_impl_coroutine >= 201902L && __has_include(<coroutine>)
+#define PUREMVC_USES_COROUTINE
+#endif
+#endif
+
+// STL include
+#include <string>
+#include <vector>
+#include <cstddef>
+
 #if defined(_MSC_VER) && _MSC_VER < 1300
 namespace std {
     typedef unsigned long size_t;
@@ -210,12 +227,262 @@ namespace PureMVC
          */
         ~FastMutex(void);
     };
+
+    /**
+     * Event class of PureMVC.
+     *
+     * <P>
+     * Lets threads wait until another thread signals it. An auto reset event
+     * releases one waiting thread per <code>set</code>, or the next thread
+     * calling <code>wait</code> when none is waiting. A manual reset event
+     * releases every thread until <code>reset</code> is called.</P>
+     */
+    class PUREMVC_API Event
+    {
+    private:
+        void* _event;
+        Event(Event const&);
+        Event& operator=(Event const&);
+    public:
+        /**
+         * Default constructor.
+         *
+         * @param auto_reset true to reset the event when a thread is released.
+         */
+        explicit Event(bool auto_reset = true);
+    public:
+        /**
+         * Signals the event.
+         */
+        void set(void);
+
+        /**
+         * Resets the event to the non-signaled state.
+         */
+        void reset(void);
+
+        /**
+         * Waits until the event is signaled.
+         */
+        void wait(void);
+
+        /**
+         * Waits for at most the given interval for the event to be signaled. Returns true if it was.
+         */
+        bool tryWait(long milliseconds);
+
+        /**
+         * Destructor.
+         */
+        ~Event(void);
+    };
+
+    /**
+     * Atomically increments the value.
+     *
+     * @param value the target to increment.
+     * @return the incremented value.
+     */
+    PUREMVC_API long atomicIncrement(long volatile* value);
+
+    /**
+     * Atomically decrements the value.
+     *
+     * @param value the target to decrement.
+     * @return the decremented value.
+     */
+    PUREMVC_API long atomicDecrement(long volatile* value);
+
+    /**
+     * Atomically replaces the value.
+     *
+     * @param value the target to replace.
+     * @param exchange the new value.
+     * @return the initial value of target.
+     */
+    PUREMVC_API long atomicExchange(long volatile* value, long exchange);
+
+    /**
+     * Atomically replaces the value if it equals to the comparand.
+     *
+     * @param value the target to replace.
+     * @param exchange the new value.
+     * @param comparand the value to compare with target.
+     * @return the initial value of target.
+     */
+    PUREMVC_API long atomicCompareExchange(long volatile* value, long exchange, long comparand);
+
+    /**
+     * Atomically reads the value, ordered with the other atomic operations.
+     *
+     * @param value the target to read.
+     * @return the value of target.
+     */
+    PUREMVC_API long atomicLoad(long volatile const* value);
+
+    /**
+     * Atomically replaces the pointer.
+     *
+     * @param value the target to replace.
+     * @param exchange the new pointer.
+     * @return the initial pointer of target.
+     */
+    PUREMVC_API void* atomicExchangePointer(void* volatile* value, void* exchange);
+
+    /**
+     * Atomically replaces the pointer if it equals to the comparand.
+     *
+     * @param value the target to replace.
+     * @param exchange the new pointer.
+     * @param comparand the pointer to compare with target.
+     * @return the initial pointer of target.
+     */
+    PUREMVC_API void* atomicCompareExchangePointer(void* volatile* value, void* exchange, void* comparand);
+
+    /**
+     * Atomically reads the pointer, ordered with the other atomic operations.
+     *
+     * @param value the target to read.
+     * @return the pointer of target.
+     */
+    PUREMVC_API void* atomicLoadPointer(void* volatile const* value);
+
+    /**
+     * Read-only memory mapping of a whole file.
+     *
+     * <P>
+     * The content is not read on <code>open</code>: pages are loaded by the
+     * operating system on first access and are shared through the page cache
+     * with every process mapping the same file.</P>
+     */
+    class PUREMVC_API MemoryMappedFile
+    {
+    private:
+        void const* _data;
+        std::size_t _size;
+    private:
+        MemoryMappedFile(MemoryMappedFile const&);
+        MemoryMappedFile& operator=(MemoryMappedFile const&);
+    public:
+        /**
+         * Default constructor, nothing is mapped.
+         */
+        explicit MemoryMappedFile(void);
+
+        /**
+         * Constructor, maps the file.
+         *
+         * @throws std::runtime_error if the file cannot be mapped.
+         */
+        explicit MemoryMappedFile(std::string const& path);
+    public:
+        /**
+         * Map the file, replacing the current mapping.
+         *
+         * @param path the path of the file.
+         * @throws std::runtime_error if the file cannot be mapped or is empty.
+         */
+        void open(std::string const& path);
+
+        /**
+         * Unmap the file.
+         */
+        void close(void);
+
+        /**
+         * Check whether a file is mapped.
+         */
+        bool isOpen(void) const;
+
+        /**
+         * Get the first byte of the file, <code>NULL</code> if nothing is mapped.
+         */
+        void const* getData(void) const;
+
+        /**
+         * Get size of the file in bytes.
+         */
+        std::size_t getSize(void) const;
+
+        /**
+         * Destructor, unmaps the file.
+         */
+        ~MemoryMappedFile(void);
+    };
+
+    /**
+     * Atomically replaces a file by another one.
+     *
+     * <P>
+     * Unlike removing <code>target</code> then renaming <code>source</code>, a
+     * crash leaves either the old or the new file at <code>target</code>.</P>
+     *
+     * @param source the path of the new file.
+     * @param target the path of the file to replace, created if absent.
+     * @return false if the file cannot be replaced.
+     */
+    PUREMVC_API bool replaceFile(std::string const& source, std::string const& target);
+
+    /**
+     * Get the names of the files in a directory.
+     *
+     * @param directory the path of the directory, empty for the current one.
+     * @param names receives the names, without the directory.
+     * @return false if the directory cannot be read.
+     */
+    PUREMVC_API bool listFiles(std::string const& directory, std::vector<std::string>& names);
+
+    /**
+     * Expected sizes of the tables of a core.
+     *
+     * <P>
+     * The tables of the <code>Model</code>, <code>View</code> and
+     * <code>Controller</code> grow on demand, rehashing several times while
+     * an application registers its actors at startup. A core constructed with
+     * a <code>CoreCapacity</code> allocates them once. The counts are hints:
+     * a table still grows past them, and <code>0</code> reserves nothing.</P>
+     *
+     * <P>
+     * Usage:
+     * <code>
+     *     Facade::getInstance("Trading", CoreCapacity(200, 50, 300, 400));
+     * </code>
+     */
+    struct CoreCapacity
+    {
+        std::size_t proxies;
+        std::size_t mediators;
+        std::size_t commands;
+        std::size_t notifications;
+
+        /**
+         * Constructor.
+         *
+         * @param proxies the expected number of proxies.
+         * @param mediators the expected number of mediators.
+         * @param commands the expected number of notification names with a command.
+         * @param notifications the expected number of notification names with
+         * an observer, including those of the mediators and commands.
+         */
+        explicit CoreCapacity(std::size_t proxies = 0,
+                              std::size_t mediators = 0,
+                              std::size_t commands = 0,
+                              std::size_t notifications = 0)
+            : proxies(proxies)
+            , mediators(mediators)
+            , commands(commands)
+            , notifications(notifications)
+        { }
+    };
 }
 
 #if !defined(__PUREMVC_INCLUDE__)
 #define __PUREMVC_INCLUDE__
 #include "Interfaces/INotifier.hpp"
 #include "Interfaces/IProxy.hpp"
+#include "Interfaces/IProxyFactory.hpp"
+#include "Interfaces/ISerializable.hpp"
+#include "Interfaces/IEvictable.hpp"
 #include "Interfaces/INotification.hpp"
 #include "Interfaces/IObserver.hpp"
 #include "Interfaces/ICommand.hpp"
@@ -226,19 +493,38 @@ namespace PureMVC
 #include "Interfaces/IView.hpp"
 #include "Interfaces/IAggregate.hpp"
 #include "Interfaces/IIterator.hpp"
+#include "Interfaces/ICacheLoader.hpp"
 #include "Patterns/Observer/Notification.hpp"
 #include "Patterns/Observer/Notifier.hpp"
 #include "Patterns/Observer/Observer.hpp"
 #include "Patterns/Command/SimpleCommand.hpp"
 #include "Patterns/Command/MacroCommand.hpp"
 #include "Patterns/Command/DelegateCommand.hpp"
+#include "Patterns/Command/PooledCommand.hpp"
+#include "Patterns/Command/PipelineCommand.hpp"
+#include "Patterns/Command/CachedCommand.hpp"
+#include "Patterns/Command/ThrottledCommand.hpp"
+#include "Patterns/Command/DebouncedCommand.hpp"
 #include "Patterns/Proxy/Proxy.hpp"
+#include "Patterns/Proxy/ProxyFactory.hpp"
+#include "Patterns/Proxy/VersionedProxy.hpp"
+#include "Patterns/Proxy/ChangeTrackingProxy.hpp"
+#include "Patterns/Proxy/CollectionProxy.hpp"
+#include "Patterns/Proxy/MappedFileProxy.hpp"
+#include "Patterns/Proxy/EventSourcedProxy.hpp"
+#include "Patterns/Proxy/DerivedProxy.hpp"
+#include "Patterns/Proxy/AsyncProxy.hpp"
+#include "Patterns/Proxy/ProxySnapshot.hpp"
+#include "Patterns/Proxy/CachingProxy.hpp"
 #include "Patterns/Mediator/Mediator.hpp"
 #include "Patterns/Facade/Facade.hpp"
 #include "Patterns/Iterator/Iterator.hpp"
+#include "Core/FlatHashMap.hpp"
 #include "Core/Model.hpp"
 #include "Core/View.hpp"
 #include "Core/Controller.hpp"
+#include "Patterns/Command/CoroutineCommand.hpp"
+#include "Patterns/Proxy/ProxyRef.hpp"
 #endif
 
 namespace PureMVC
@@ -346,6 +632,93 @@ namespace PureMVC
          */
         ~Thread();
     };
+
+    /**
+     * Timer service shared by PureMVC.
+     *
+     * <P>
+     * One background thread executes every scheduled <code>ICommand</code>, instead
+     * of one thread per delayed command. The thread is started by the first call of
+     * <code>schedule</code>. It sleeps until the next timer expires, or until a
+     * <code>schedule</code> when none is pending. Commands run on the timer
+     * thread and must not block it.</P>
+     *
+     * <P>
+     * Pending timers are kept in a hierarchical hashed timer wheel of pooled
+     * entries: <code>schedule</code> and <code>cancel</code> take constant time and
+     * allocate nothing once the pool has grown, so hundreds of thousands of
+     * timeouts can be pending. Delays are limited to about 49 days.</P>
+     */
+    class PUREMVC_API Timer
+    {
+    public:
+        /**
+         * Identifier of a scheduled timer, <code>0</code> is never used.
+         */
+        typedef unsigned long TimerId;
+    private:
+        void* _timer_handler;
+    private:
+        explicit Timer(void);
+        Timer(Timer const&);
+        Timer& operator=(Timer const&);
+    public:
+        /**
+         * Get the shared timer service.
+         */
+        static Timer& getInstance(void);
+
+        /**
+         * Returns a monotonic clock in milliseconds.
+         *
+         * <P>
+         * The value wraps around, compare two ticks by their difference.</P>
+         */
+        static unsigned long getTickCount(void);
+
+        /**
+         * Schedule the command.
+         *
+         * @param command the <code>ICommand</code> to execute.
+         * @param destroyable_notification the parameter of <code>execute</code>,
+         * destroyed by <code>Timer</code> after the last execution or on cancel.
+         * @param delay the number of milliseconds before the first execution.
+         * @param period the number of milliseconds between executions, <code>0</code>
+         * to execute only once.
+         * @return the identifier of the timer.
+         */
+        TimerId schedule(ICommand& command, INotification const* destroyable_notification, long delay, long period = 0);
+
+        /**
+         * Cancel the timer.
+         *
+         * <P>
+         * When the command is being executed on the timer thread, waits until it
+         * returns, unless called from that command.</P>
+         *
+         * @param timer_id the identifier returned by <code>schedule</code>.
+         * @return true if the timer was pending.
+         */
+        bool cancel(TimerId timer_id);
+
+        /**
+         * Cancel every timer executing the command.
+         *
+         * @param command the <code>ICommand</code> given to <code>schedule</code>.
+         * @return the number of cancelled timers.
+         */
+        std::size_t cancelAll(ICommand const& command);
+
+        /**
+         * Get number of pending timers.
+         */
+        std::size_t getPendingCount(void) const;
+
+        /**
+         * Destructor.
+         */
+        ~Timer(void);
+    };
 }
 
 #endif /* __PUREMVC_HPP__ */
@@ -32,6 +32,7 @@ else
 #include <map>
 #endif
 #include <list>
+#include <vector>
 #include <algorithm>
 #include <iostream>
 #include <iterator>
@@ -69,6 +70,27 @@ namespace PureMVC
         throw _Exception(buff);
     }
 
+    // Grows a hash map ahead of inserting up to size elements, so the inserts
+    // do not rehash. Tree maps have nothing to reserve.
+    template<typename _Map>
+    inline void reserveMap(_Map& map, std::size_t size)
+    {
+#if defined(PUREMVC_USES_TR1)
+        std::size_t buckets = (std::size_t)(size / map.max_load_factor()) + 1;
+        if (buckets > map.bucket_count())
+            map.rehash(buckets);
+#else
+        (void)map;
+        (void)size;
+#endif
+    }
+
+    template<typename _Value>
+    inline void reserveMap(Core::FlatHashMap<_Value>& map, std::size_t size)
+    {
+        map.reserve(size);
+    }
+
     extern char const __PURE_MVC_DEFAULT_NAME__[];
     template<typename _Type,
              char const _Name[] = __PURE_MVC_DEFAULT_NAME__>
@@ -142,6 +164,22 @@ namespace PureMVC
             FastMutex::ScopedLock _(*_mutex);
             _instance->insert(item);
         }
+        void insert(_Type* const* values, std::size_t count)
+        {
+            createCache();
+            std::vector<std::pair<std::string, _Type*> > items;
+            items.reserve(count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                char buff[20] = { 0 };
+                sprintf(buff, "%lx", (unsigned long)values[i]);
+                items.push_back(std::make_pair(std::string(buff), values[i]));
+            }
+            if (!_mutex) _mutex = new FastMutex();
+            FastMutex::ScopedLock _(*_mutex);
+            reserveMap(*_instance, _instance->size() + count);
+            _instance->insert(items.begin(), items.end());
+        }
         void insert(std::string const& key, _Type* const& value)
         {
             createCache();
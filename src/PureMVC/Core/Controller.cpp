@@ -42,13 +42,14 @@ void Controller::insert(std::string const& key, IController* controller)
     puremvc_controller_instance_map.insert(key, controller);
 }
 
-Controller::Controller(std::string const& key)
+Controller::Controller(std::string const& key, CoreCapacity const& capacity)
     : _multiton_key(key)
     , _view(NULL)
 {
     if (puremvc_controller_instance_map.find(_multiton_key))
         throw std::runtime_error(MULTITON_MSG);
     puremvc_controller_instance_map.insert(_multiton_key, this);
+    reserveCommands(capacity.commands);
     initializeController();
 }
 
@@ -59,28 +60,26 @@ inline void Controller::initializeController(void)
     _view  = &View::getInstance(_multiton_key);
 }
 
-IController & Controller::getInstance(std::string const& key)
+IController & Controller::getInstance(std::string const& key, CoreCapacity const& capacity)
 {
     IController* result = puremvc_controller_instance_map.find(key);
     if (result == NULL)
     {
-        result = new Controller(key);
+        result = new Controller(key, capacity);
         puremvc_controller_instance_map.insert(key, result);
     }
+    // an existing controller only locks to grow
+    else if (capacity.commands != 0)
+        result->reserveCommands(capacity.commands);
     return *result;
 }
 
 void Controller::executeCommand(INotification const& notification)
 {
-    CommandMap::iterator result = _command_map.end();
-    do
-    {
-        PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
-        result = _command_map.find(notification.getName());
-        if (result == _command_map.end())
-            return;
-    }while (false);
-    result->second->execute(notification);
+    ICommand* command = tryRetrieveCommand(notification.getName());
+    if (command == NULL)
+        return;
+    command->execute(notification);
 }
 
 void Controller::registerCommand(std::string const& notification_name, ICommand* command)
@@ -100,10 +99,41 @@ void Controller::registerCommand(std::string const& notification_name, ICommand*
     _command_map[notification_name] =  command;
 }
 
-inline bool Controller::hasCommand(std::string const& notification_name) const
+void Controller::registerCommands(std::string const* notification_names, ICommand* const* commands, std::size_t count)
+{
+    PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
+
+    if (_view == NULL)
+        throwException<std::runtime_error>("Cannot register commands. View is null.");
+
+    std::vector<std::string> names;
+    std::vector<IObserver*> observers;
+    reserveMap(_command_map, _command_map.size() + count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (_command_map.find(notification_names[i]) == _command_map.end())
+        {
+            names.push_back(notification_names[i]);
+            observers.push_back(createObserver(&Controller::executeCommand, this));
+        }
+        commands[i]->initializeNotifier(_multiton_key);
+        _command_map[notification_names[i]] = commands[i];
+    }
+    if (observers.empty())
+        return;
+    puremvc_observer_instance_map.insert(&observers[0], observers.size());
+    _view->registerObservers(&names[0], &observers[0], observers.size());
+}
+
+void Controller::reserveCommands(std::size_t count)
 {
     PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
-    return _command_map.find(notification_name) != _command_map.end();
+    reserveMap(_command_map, count);
+}
+
+inline bool Controller::hasCommand(std::string const& notification_name) const
+{
+    return tryRetrieveCommand(notification_name) != NULL;
 }
 
 ICommand* Controller::removeCommand(std::string const& notification_name)
@@ -135,15 +165,29 @@ ICommand* Controller::removeCommand(std::string const& notification_name)
     return command;
 }
 
-ICommand const& Controller::retrieveCommand(std::string const& notification_name) const
+ICommand const* Controller::tryRetrieveCommand(std::string const& notification_name) const
 {
     PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
 
     CommandMap::const_iterator result = _command_map.find(notification_name);
     if (result == _command_map.end())
+        return NULL;
+
+    return result->second;
+}
+
+inline ICommand* Controller::tryRetrieveCommand(std::string const& notification_name)
+{
+    return const_cast<ICommand*>(static_cast<Controller const&>(*this).tryRetrieveCommand(notification_name));
+}
+
+ICommand const& Controller::retrieveCommand(std::string const& notification_name) const
+{
+    ICommand const* command = tryRetrieveCommand(notification_name);
+    if (command == NULL)
         throwException<std::runtime_error>("Cannot find any command with notification name: [%s].", notification_name.c_str());
 
-    return *result->second;
+    return *command;
 }
 
 inline ICommand& Controller::retrieveCommand(std::string const& notification)
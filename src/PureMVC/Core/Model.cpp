@@ -42,50 +42,366 @@ void Model::insert(std::string const& key, IModel* model)
     puremvc_model_instance_map.insert(key, model);
 }
 
-Model::Model(std::string const& key)
+Model::Model(std::string const& key, CoreCapacity const& capacity)
     : _multiton_key(key)
+    , _generation(0)
+    , _eviction_hand(_eviction_ring.end())
+    , _memory_usage(0)
+    , _memory_budget(~(std::size_t)0)
 {
     if (puremvc_model_instance_map.find(_multiton_key))
         throw std::runtime_error(MULTITON_MSG);
     puremvc_model_instance_map.insert(_multiton_key, this);
+    reserveProxies(capacity.proxies);
     initializeModel();
 }
 
 inline void Model::initializeModel(void)
 { }
 
-IModel& Model::getInstance(std::string const& key)
+IModel& Model::getInstance(std::string const& key, CoreCapacity const& capacity)
 {
     IModel* result = puremvc_model_instance_map.find(key) ;
     if (result == NULL)
     {
-        result = new Model(key);
+        result = new Model(key, capacity);
         puremvc_model_instance_map.insert(std::make_pair(key, result));
     }
+    // an existing model only locks to grow
+    else if (capacity.proxies != 0)
+        result->reserveProxies(capacity.proxies);
     return *result;
 }
 
 void Model::registerProxy(IProxy* proxy)
 {
+    IProxy* replaced = NULL;
     proxy->initializeNotifier(_multiton_key);
     do
     {
         PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
-        ProxyMap::iterator result = _proxy_map.find(proxy->getProxyName());
+        // a registered proxy replaces its factory
+        replaced = replaceProxyFactory(proxy->getProxyName());
         _proxy_map.insert(std::make_pair(proxy->getProxyName(), (proxy)));
     }while (false);
+    if (replaced != NULL)
+    {
+        replaced->onRemove();
+        delete replaced;
+    }
     proxy->onRegister();
 }
 
-IProxy const& Model::retrieveProxy(std::string const& proxy_name) const
+void Model::registerProxies(IProxy* const* proxies, std::size_t count)
 {
+    std::list<IProxy*> replaced;
+    for (std::size_t i = 0; i < count; ++i)
+        proxies[i]->initializeNotifier(_multiton_key);
+    do
+    {
+        PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
+        reserveMap(_proxy_map, _proxy_map.size() + count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            IProxy* proxy = replaceProxyFactory(proxies[i]->getProxyName());
+            if (proxy != NULL)
+                replaced.push_back(proxy);
+            _proxy_map.insert(std::make_pair(proxies[i]->getProxyName(), proxies[i]));
+        }
+    }while (false);
+    for (std::list<IProxy*>::iterator result = replaced.begin(); result != replaced.end(); ++result)
+    {
+        (*result)->onRemove();
+        delete *result;
+    }
+    for (std::size_t i = 0; i < count; ++i)
+        proxies[i]->onRegister();
+}
+
+IProxy* Model::replaceProxyFactory(std::string const& proxy_name)
+{
+    ProxyFactoryMap::iterator factory = _proxy_factory_map.find(proxy_name);
+    if (factory == _proxy_factory_map.end())
+        return NULL;
+    bool built = factory->second.built;
+    dropProxyFactory(factory);
+    if (!built)
+        return NULL;
+    // the evictable proxy built by the factory is owned by the model
+    ProxyMap::iterator result = _proxy_map.find(proxy_name);
+    IProxy* proxy = result->second;
+    _proxy_map.erase(result);
+    atomicIncrement(&_generation);
+    return proxy;
+}
+
+void Model::reserveProxies(std::size_t count)
+{
+    PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
+    reserveMap(_proxy_map, count);
+}
+
+inline void Model::registerProxyFactory(std::string const& proxy_name, IProxyFactory* factory)
+{
+    addProxyFactory(proxy_name, factory, false);
+}
+
+inline void Model::registerEvictableProxyFactory(std::string const& proxy_name, IProxyFactory* factory)
+{
+    addProxyFactory(proxy_name, factory, true);
+}
+
+void Model::addProxyFactory(std::string const& proxy_name, IProxyFactory* factory, bool evictable)
+{
+    if (factory == NULL)
+        return;
+
     PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
 
+    ProxyFactoryMap::iterator result = _proxy_factory_map.find(proxy_name);
+    // ignore the factory if its proxy is registered or being built
+    if (_proxy_map.find(proxy_name) != _proxy_map.end() ||
+        (result != _proxy_factory_map.end() && !result->second.builder.empty()))
+    {
+        delete factory;
+        return;
+    }
+    if (result != _proxy_factory_map.end())
+    {
+        delete result->second.factory;
+        result->second.factory = factory;
+        result->second.evictable = evictable;
+        return;
+    }
+    ProxyFactoryEntry entry;
+    entry.factory = factory;
+    entry.evictable = evictable;
+    _proxy_factory_map.insert(std::make_pair(proxy_name, entry));
+}
+
+IProxy const* Model::tryRetrieveProxy(std::string const& proxy_name) const
+{
+    do
+    {
+        PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
+
+        ProxyMap::const_iterator result = _proxy_map.find(proxy_name);
+        if (result != _proxy_map.end())
+        {
+            // mark an evictable proxy as used for the clock hand
+            if (!_eviction_ring.empty())
+            {
+                ProxyFactoryMap::const_iterator entry = _proxy_factory_map.find(proxy_name);
+                if (entry != _proxy_factory_map.end())
+                    entry->second.referenced = true;
+            }
+            return result->second;
+        }
+
+        if (_proxy_factory_map.find(proxy_name) == _proxy_factory_map.end())
+            return NULL;
+    }while (false);
+
+    return const_cast<Model*>(this)->createProxy(proxy_name);
+}
+
+IProxy* Model::createProxy(std::string const& proxy_name)
+{
+    std::string thread_id = Thread::getCurrentThreadId();
+    IProxyFactory* factory = NULL;
+    ProxyBuild* build = NULL;
+    bool evictable = false;
+
+    while (factory == NULL)
+    {
+        ProxyBuild* running = NULL;
+        do
+        {
+            PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
+
+            ProxyMap::iterator proxy = _proxy_map.find(proxy_name);
+            if (proxy != _proxy_map.end())
+                return proxy->second;
+
+            ProxyFactoryMap::iterator result = _proxy_factory_map.find(proxy_name);
+            if (result == _proxy_factory_map.end())
+                return NULL;
+            if (result->second.builder.empty())
+            {
+                result->second.build = build = new ProxyBuild();
+                result->second.builder = thread_id;
+                factory = result->second.factory;
+                evictable = result->second.evictable;
+            }
+            // the factory needs its own proxy
+            else if (result->second.builder == thread_id)
+                return NULL;
+            else
+            {
+                running = result->second.build;
+                atomicIncrement(&running->references);
+            }
+        }while (false);
+
+        // wait for the thread building the proxy
+        if (running != NULL)
+        {
+            running->done.wait();
+            running->release();
+        }
+    }
+
+    IProxy* proxy = NULL;
+    std::size_t memory_usage = 0;
+    try
+    {
+        proxy = factory->createProxy(proxy_name);
+        if (proxy == NULL)
+            throwException<std::runtime_error>("Cannot create proxy with name: [%s]. Factory returned null.", proxy_name.c_str());
+        if (evictable)
+        {
+            IEvictable const* evictable_proxy = dynamic_cast<IEvictable const*>(proxy);
+            if (evictable_proxy == NULL)
+                throwException<std::runtime_error>("Cannot create proxy with name: [%s]. Evictable proxy does not implement IEvictable.", proxy_name.c_str());
+            memory_usage = evictable_proxy->getMemoryUsage();
+        }
+        proxy->initializeNotifier(_multiton_key);
+    }
+    catch (...)
+    {
+        delete proxy;
+        do
+        {
+            PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
+            ProxyFactoryMap::iterator result = _proxy_factory_map.find(proxy_name);
+            if (result != _proxy_factory_map.end() && result->second.factory == factory)
+            {
+                result->second.builder.clear();
+                result->second.build = NULL;
+            }
+            else
+                delete factory;
+        }while (false);
+        // the waiters retry the factory
+        build->done.set();
+        build->release();
+        throw;
+    }
+
+    bool registered = false;
+    do
+    {
+        PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
+        ProxyFactoryMap::iterator result = _proxy_factory_map.find(proxy_name);
+        // removed or replaced by registerProxy while building
+        if (result == _proxy_factory_map.end() || result->second.factory != factory)
+            break;
+        _proxy_map.insert(std::make_pair(proxy_name, proxy));
+        registered = true;
+        if (!evictable)
+        {
+            _proxy_factory_map.erase(result);
+            break;
+        }
+        // keep the factory, the new proxy is the last one reached by the clock hand
+        result->second.builder.clear();
+        result->second.build = NULL;
+        result->second.built = true;
+        result->second.referenced = true;
+        result->second.memory_usage = memory_usage;
+        result->second.position = _eviction_ring.insert(_eviction_hand, proxy_name);
+        _memory_usage += memory_usage;
+    }while (false);
+    build->done.set();
+    build->release();
+
+    if (!registered)
+    {
+        delete factory;
+        delete proxy;
+        return tryRetrieveProxy(proxy_name);
+    }
+    if (!evictable)
+        delete factory;
+    proxy->onRegister();
+    if (evictable)
+        evictProxies(&proxy_name);
+    return proxy;
+}
+
+void Model::evictProxies(std::string const* kept_name)
+{
+    std::list<IProxy*> evicted;
+    do
+    {
+        PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
+
+        // two turns of the clock hand clear every mark and reach every proxy
+        std::size_t steps = 2 * _eviction_ring.size() + 1;
+        while (_memory_usage > _memory_budget && steps-- > 0)
+        {
+            if (_eviction_hand == _eviction_ring.end())
+                _eviction_hand = _eviction_ring.begin();
+            ProxyFactoryMap::iterator entry = _proxy_factory_map.find(*_eviction_hand);
+            if (entry->second.referenced || (kept_name != NULL && *kept_name == entry->first))
+            {
+                entry->second.referenced = false;
+                ++_eviction_hand;
+                continue;
+            }
+            ProxyMap::iterator result = _proxy_map.find(entry->first);
+            evicted.push_back(result->second);
+            _proxy_map.erase(result);
+            _memory_usage -= entry->second.memory_usage;
+            entry->second.memory_usage = 0;
+            entry->second.built = false;
+            _eviction_hand = _eviction_ring.erase(_eviction_hand);
+        }
+        if (!evicted.empty())
+            atomicIncrement(&_generation);
+    }while (false);
+
+    for (std::list<IProxy*>::iterator result = evicted.begin(); result != evicted.end(); ++result)
+    {
+        (*result)->onRemove();
+        delete *result;
+    }
+}
+
+inline void Model::dropProxyFactory(ProxyFactoryMap::iterator const& result)
+{
+    if (result->second.built)
+    {
+        if (_eviction_hand == result->second.position)
+            ++_eviction_hand;
+        _eviction_ring.erase(result->second.position);
+        _memory_usage -= result->second.memory_usage;
+    }
+    // the thread building the proxy deletes the factory itself
+    if (result->second.builder.empty())
+        delete result->second.factory;
+    _proxy_factory_map.erase(result);
+}
+
+inline IProxy* Model::tryRetrieveProxy(std::string const& proxy_name)
+{
+    return const_cast<IProxy*>(static_cast<Model const&>(*this).tryRetrieveProxy(proxy_name));
+}
+
+IProxy const* Model::tryRetrieveBuiltProxy(std::string const& proxy_name) const
+{
+    PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
     ProxyMap::const_iterator result = _proxy_map.find(proxy_name);
-    if (result == _proxy_map.end())
+    return result == _proxy_map.end() ? NULL : result->second;
+}
+
+IProxy const& Model::retrieveProxy(std::string const& proxy_name) const
+{
+    IProxy const* proxy = tryRetrieveProxy(proxy_name);
+    if (proxy == NULL)
         throwException<std::runtime_error>("Cannot find any proxy with name: [%s].", proxy_name.c_str());
 
-    return *result->second;
+    return *proxy;
 }
 
 inline IProxy& Model::retrieveProxy(std::string const& proxy_name)
@@ -93,10 +409,39 @@ inline IProxy& Model::retrieveProxy(std::string const& proxy_name)
     return const_cast<IProxy&>(static_cast<Model const&>(*this).retrieveProxy(proxy_name));
 }
 
-inline bool Model::hasProxy(std::string const& proxy_name) const
+bool Model::hasProxy(std::string const& proxy_name) const
+{
+    PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
+    // a proxy not built yet is registered, but checking it neither builds nor marks it
+    return _proxy_map.find(proxy_name) != _proxy_map.end() ||
+        _proxy_factory_map.find(proxy_name) != _proxy_factory_map.end();
+}
+
+long Model::getGeneration(void) const
+{
+    return _generation;
+}
+
+void Model::setMemoryBudget(std::size_t budget)
+{
+    do
+    {
+        PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
+        _memory_budget = budget;
+    }while (false);
+    evictProxies(NULL);
+}
+
+std::size_t Model::getMemoryBudget(void) const
 {
     PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
-    return _proxy_map.find(proxy_name) != _proxy_map.end();
+    return _memory_budget;
+}
+
+std::size_t Model::getMemoryUsage(void) const
+{
+    PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
+    return _memory_usage;
 }
 
 IProxy* Model::removeProxy(std::string const& proxy_name)
@@ -106,6 +451,11 @@ IProxy* Model::removeProxy(std::string const& proxy_name)
     do
     {
         PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
+        // the proxy may not be built yet, or be evictable
+        ProxyFactoryMap::iterator factory = _proxy_factory_map.find(proxy_name);
+        if (factory != _proxy_factory_map.end())
+            dropProxyFactory(factory);
+
         // Retrieve the named mediator
         ProxyMap::iterator result = _proxy_map.find(proxy_name);
 
@@ -116,6 +466,8 @@ IProxy* Model::removeProxy(std::string const& proxy_name)
         proxy = result->second;
         // remove the mediator from the map
         _proxy_map.erase(result);
+        // invalidate pointers cached by ProxyRef
+        atomicIncrement(&_generation);
     }while (false);
 
     if (proxy != NULL) proxy->onRemove();
@@ -144,5 +496,15 @@ Model::ProxyNames Model::listProxyNames(void) const
 Model::~Model(void)
 {
     removeModel(_multiton_key);
+    ProxyFactoryMap::iterator result = _proxy_factory_map.begin();
+    for (; result != _proxy_factory_map.end(); ++result)
+    {
+        // the evictable proxies are owned by the model
+        if (result->second.built)
+            delete _proxy_map[result->first];
+        delete result->second.factory;
+    }
     _proxy_map.clear();
+    _proxy_factory_map.clear();
+    _eviction_ring.clear();
 }
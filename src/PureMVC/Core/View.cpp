@@ -13,6 +13,19 @@ char const* const View::MULTITON_MSG =
 
 char const* const View::DEFAULT_KEY = "PureMVC";
 
+namespace
+{
+    bool lessName(std::string const* left, std::string const* right)
+    {
+        return *left < *right;
+    }
+
+    bool equalName(std::string const* left, std::string const* right)
+    {
+        return *left == *right;
+    }
+}
+
 inline View::MediatorMap::key_type const& 
 View::IteratorConverter::operator()
 (View::MediatorMap::const_iterator const& iterator) const
@@ -42,26 +55,37 @@ void View::insert(std::string const& key, IView* view)
     puremvc_view_instance_map.insert(key, view);
 }
 
-View::View(std::string const& key)
+View::View(std::string const& key, CoreCapacity const& capacity)
     : _multiton_key(key)
+    , _dispatch_count(0)
 {
     if (puremvc_view_instance_map.find(_multiton_key))
         throw std::runtime_error(MULTITON_MSG);
     puremvc_view_instance_map.insert(_multiton_key, this);
+    reserveMediators(capacity.mediators);
+    reserveObservers(capacity.notifications);
     initializeView();
 }
 
 inline void View::initializeView(void)
 { }
 
-IView& View::getInstance(std::string const& key)
+IView& View::getInstance(std::string const& key, CoreCapacity const& capacity)
 {
     IView* result = puremvc_view_instance_map.find(key);
     if (result == NULL)
     {
-        result = new View(key);
+        result = new View(key, capacity);
         puremvc_view_instance_map.insert(key, result);
     }
+    else
+    {
+        // an existing view only locks to grow
+        if (capacity.mediators != 0)
+            result->reserveMediators(capacity.mediators);
+        if (capacity.notifications != 0)
+            result->reserveObservers(capacity.notifications);
+    }
     return *result;
 }
 
@@ -70,36 +94,83 @@ inline void View::registerObserver(std::string const& notification_name,
 {
     PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
 
-    ObserverMap::value_type item(notification_name, observer);
+    _observer_map[notification_name].push_back(observer);
+}
+
+void View::registerObservers(std::string const* notification_names,
+                             IObserver* const* observers,
+                             std::size_t count)
+{
+    // the table holds one entry per name, shared by all its observers
+    std::vector<std::string const*> names(count);
+    for (std::size_t i = 0; i < count; ++i)
+        names[i] = &notification_names[i];
+    std::sort(names.begin(), names.end(), lessName);
+    names.erase(std::unique(names.begin(), names.end(), equalName), names.end());
+
+    PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
+
+    std::size_t added = 0;
+    for (std::size_t i = 0; i < names.size(); ++i)
+        if (_observer_map.find(*names[i]) == _observer_map.end())
+            ++added;
+    reserveMap(_observer_map, _observer_map.size() + added);
+    for (std::size_t i = 0; i < count; ++i)
+        _observer_map[notification_names[i]].push_back(observers[i]);
+}
 
-    _observer_map.insert(item);
+void View::reserveObservers(std::size_t count)
+{
+    PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
+    reserveMap(_observer_map, count);
 }
 
 void View::notifyObservers(INotification const& notification)
 {
-    typedef std::list<IObserver*> list_observer_t;
-
     std::string const& name = notification.getName();
 
-    list_observer_t list;
+    ObserverList list;
 
     do
     {
         // Scope lock for safety
         PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
 
-        // Find observer by name
-        ObserverMap::iterator result = _observer_map.find(name);
+        // Find observers by name and store them
+        ObserverMap::const_iterator result = _observer_map.find(name);
+        if (result == _observer_map.end())
+            return;
+        list = result->second;
+        // the copied observers are not deleted until the dispatch ends
+        ++_dispatch_count;
+    }while (false);
 
-        // Looping and store observer
-        for (; result != _observer_map.end() && result->first == notification.getName() ; ++result)
-            list.push_back(result->second);
+    try
+    {
+        ObserverList::const_iterator iter = list.begin();
+        for(; iter != list.end(); ++iter)
+            (*iter)->notifyObserver(notification);
+    }
+    catch (...)
+    {
+        endDispatch();
+        throw;
+    }
+    endDispatch();
+}
 
+void View::endDispatch(void)
+{
+    ObserverList retired;
+    do
+    {
+        PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
+        if (--_dispatch_count == 0)
+            retired.swap(_retired_observers);
     }while (false);
 
-    list_observer_t::const_iterator iter = list.begin();
-    for(; iter != list.end(); ++iter)
-        (*iter)->notifyObserver(notification);
+    for (ObserverList::iterator iter = retired.begin(); iter != retired.end(); ++iter)
+        delete *iter;
 }
 
 void View::removeObserver(std::string const& notification_name,
@@ -108,18 +179,25 @@ void View::removeObserver(std::string const& notification_name,
     PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
 
     ObserverMap::iterator result = _observer_map.find(notification_name);
+    if (result == _observer_map.end())
+        return;
 
-    for (; result != _observer_map.end(); ++result)
+    ObserverList& list = result->second;
+    for (ObserverList::iterator iter = list.begin(); iter != list.end(); ++iter)
     {
-        if (result->first != notification_name)
-            continue;
-
-        ObserverMap::value_type::second_type observer = result->second;
+        IObserver* observer = *iter;
         if (observer->compareNotifyContext(notify_context) )
         {
-            _observer_map.erase(result);
+            list.erase(iter);
+            // drop the name once its last observer is removed
+            if (list.empty())
+                _observer_map.erase(result);
             puremvc_observer_instance_map.remove(observer);
-            delete observer;
+            // a notification being dispatched may still reach the observer
+            if (_dispatch_count != 0)
+                _retired_observers.push_back(observer);
+            else
+                delete observer;
             return;
         }
     }
@@ -141,35 +219,130 @@ void View::registerMediator(IMediator* mediator)
         _mediator_map.insert(std::make_pair(mediator->getMediatorName(), mediator));
     }while (false);
 
-    IMediator::NotificationNames result(mediator->listNotificationInterests());
+    std::size_t count = 0;
+    std::string const* interests = mediator->getNotificationInterests(count);
+    if (interests != NULL)
+    {
+        // static interests, walked without building a list
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            IObserver *observer = createObserver(&IMediator::handleNotification, mediator);
+            puremvc_observer_instance_map.insert(observer);
+            registerObserver(interests[i], observer);
+        }
+    }
+    else
+    {
+        IMediator::NotificationNames result(mediator->listNotificationInterests());
 #if defined(__DMC__) // The C++ complier of Digital Mars is too stupid~~~
-    std::auto_ptr<IIterator<std::string> >  
+        std::auto_ptr<IIterator<std::string> >  
 #else
-    IMediator::NotificationNames::element_type::Iterator
+        IMediator::NotificationNames::element_type::Iterator
 #endif
-    iter(result->getIterator());
-    // Register Mediator as an observer for each notification of interests
-    while(iter->moveNext())
-    {
-        // Register Mediator as Observer for its list of Notification interests
-        // Create Observer referencing this mediator's handlNotification method
-        IObserver *observer = createObserver(&IMediator::handleNotification, mediator);
-        puremvc_observer_instance_map.insert(observer);
-        registerObserver(iter->getCurrent(), observer);
+        iter(result->getIterator());
+        // Register Mediator as an observer for each notification of interests
+        while(iter->moveNext())
+        {
+            // Register Mediator as Observer for its list of Notification interests
+            // Create Observer referencing this mediator's handlNotification method
+            IObserver *observer = createObserver(&IMediator::handleNotification, mediator);
+            puremvc_observer_instance_map.insert(observer);
+            registerObserver(iter->getCurrent(), observer);
+        }
     }
     // alert the mediator that it has been registered
     mediator->onRegister();
 }
 
-inline IMediator const& View::retrieveMediator(std::string const& mediator_name) const
+void View::registerMediators(IMediator* const* mediators, std::size_t count)
+{
+    std::vector<IMediator*> registered;
+    registered.reserve(count);
+    do
+    {
+        PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
+
+        reserveMap(_mediator_map, _mediator_map.size() + count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            // skip the names already registered, as registerMediator does
+            if (!_mediator_map.insert(std::make_pair(mediators[i]->getMediatorName(), mediators[i])).second)
+                continue;
+            mediators[i]->initializeNotifier(_multiton_key);
+            registered.push_back(mediators[i]);
+        }
+    }while (false);
+
+    std::vector<std::string> names;
+    std::vector<IObserver*> observers;
+    for (std::size_t i = 0; i < registered.size(); ++i)
+    {
+        IMediator* mediator = registered[i];
+        std::size_t interest_count = 0;
+        std::string const* interests = mediator->getNotificationInterests(interest_count);
+        if (interests != NULL)
+        {
+            for (std::size_t j = 0; j < interest_count; ++j)
+            {
+                names.push_back(interests[j]);
+                observers.push_back(createObserver(&IMediator::handleNotification, mediator));
+            }
+        }
+        else
+        {
+            IMediator::NotificationNames result(mediator->listNotificationInterests());
+#if defined(__DMC__) // The C++ complier of Digital Mars is too stupid~~~
+            std::auto_ptr<IIterator<std::string> >
+#else
+            IMediator::NotificationNames::element_type::Iterator
+#endif
+            iter(result->getIterator());
+            while(iter->moveNext())
+            {
+                names.push_back(iter->getCurrent());
+                observers.push_back(createObserver(&IMediator::handleNotification, mediator));
+            }
+        }
+    }
+    if (!observers.empty())
+    {
+        puremvc_observer_instance_map.insert(&observers[0], observers.size());
+        registerObservers(&names[0], &observers[0], observers.size());
+    }
+
+    for (std::size_t i = 0; i < registered.size(); ++i)
+        registered[i]->onRegister();
+}
+
+void View::reserveMediators(std::size_t count)
+{
+    PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
+    reserveMap(_mediator_map, count);
+}
+
+IMediator const* View::tryRetrieveMediator(std::string const& mediator_name) const
 {
     PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
 
     MediatorMap::const_iterator result = _mediator_map.find(mediator_name);
     if (result == _mediator_map.end())
+        return NULL;
+
+    return result->second;
+}
+
+inline IMediator* View::tryRetrieveMediator(std::string const& mediator_name)
+{
+    return const_cast<IMediator*>(static_cast<View const&>(*this).tryRetrieveMediator(mediator_name));
+}
+
+inline IMediator const& View::retrieveMediator(std::string const& mediator_name) const
+{
+    IMediator const* mediator = tryRetrieveMediator(mediator_name);
+    if (mediator == NULL)
         throwException<std::runtime_error>("Cannot find any mediator with name: [%s].", mediator_name.c_str());
 
-    return *result->second;
+    return *mediator;
 }
 
 inline IMediator& View::retrieveMediator(std::string const& mediator_name)
@@ -196,18 +369,28 @@ IMediator* View::removeMediator(std::string const& mediator_name)
 
     if (mediator != NULL )
     {
-        // for every notification this mediator is interested in...
-        IMediator::NotificationNames result(mediator->listNotificationInterests());
+        std::size_t count = 0;
+        std::string const* interests = mediator->getNotificationInterests(count);
+        if (interests != NULL)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                removeObserver(interests[i], (IObserver*)mediator);
+        }
+        else
+        {
+            // for every notification this mediator is interested in...
+            IMediator::NotificationNames result(mediator->listNotificationInterests());
 #if defined(__DMC__) // The C++ complier of Digital Mars is too stupid~~~
-        std::auto_ptr<IIterator<std::string> >  
+            std::auto_ptr<IIterator<std::string> >  
 #else
-        IMediator::NotificationNames::element_type::Iterator 
+            IMediator::NotificationNames::element_type::Iterator 
 #endif
-        iter(result->getIterator());
-        while(iter->moveNext())
-        {
-            // remove the observer linking the mediator to the notification interest
-            removeObserver(iter->getCurrent(), (IObserver*)mediator);
+            iter(result->getIterator());
+            while(iter->moveNext())
+            {
+                // remove the observer linking the mediator to the notification interest
+                removeObserver(iter->getCurrent(), (IObserver*)mediator);
+            }
         }
         // Notify that it was removed
         mediator->onRemove();
@@ -217,8 +400,7 @@ IMediator* View::removeMediator(std::string const& mediator_name)
 
 inline bool View::hasMediator(std::string const& mediator_name) const
 {
-    PureMVC::FastMutex::ScopedLock lock(_synchronous_access);
-    return _mediator_map.find(mediator_name) != _mediator_map.end();
+    return tryRetrieveMediator(mediator_name) != NULL;
 }
 
 void View::removeView(std::string const& key)
@@ -226,6 +408,12 @@ void View::removeView(std::string const& key)
     puremvc_view_instance_map.remove(key);
 }
 
+void View::registerOwnedObserver(IView& view, std::string const& notification_name, IObserver* observer)
+{
+    puremvc_observer_instance_map.insert(observer);
+    view.registerObserver(notification_name, observer);
+}
+
 View::MediatorNames View::listMediatorNames(void) const
 {
     typedef StdContainerAggregate<MediatorMap const*,
@@ -246,13 +434,18 @@ View::~View(void)
     ObserverMap::const_iterator iter = _observer_map.begin();
     for(; iter != _observer_map.end(); ++iter)
     {
-        ObserverMap::value_type::second_type observer = iter->second;
-        ObserverMap::value_type::second_type observer2 =
-            puremvc_observer_instance_map.remove(observer);
+        ObserverList::const_iterator observer = iter->second.begin();
+        for (; observer != iter->second.end(); ++observer)
+        {
+            IObserver* observer2 = puremvc_observer_instance_map.remove(*observer);
 
-        if (observer2 != NULL)
-            delete observer2;
+            if (observer2 != NULL)
+                delete observer2;
+        }
     }
     _observer_map.clear();
     _mediator_map.clear();
+    for (ObserverList::iterator iter = _retired_observers.begin(); iter != _retired_observers.end(); ++iter)
+        delete *iter;
+    _retired_observers.clear();
 }
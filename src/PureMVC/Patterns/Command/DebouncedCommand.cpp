@@ -0,0 +1,82 @@
+//  DebouncedCommand.cpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#include "../../Common.hpp"
+
+DebouncedCommand::Trailing::Trailing(DebouncedCommand* owner)
+    : INotifier()
+    , ICommand()
+    , SimpleCommand()
+    , _owner(owner)
+{ }
+
+void DebouncedCommand::Trailing::execute(INotification const& notification)
+{
+    do
+    {
+        FastMutex::ScopedLock lock(_owner->_synchronous_access);
+        // Superseded by a later notification while it was due.
+        if (_owner->_pending != &notification)
+            return;
+        _owner->_pending = NULL;
+        _owner->_timer_id = 0;
+    } while (false);
+    _owner->_command->execute(notification);
+}
+
+DebouncedCommand::DebouncedCommand(ICommand* command, long quiet_period)
+    : INotifier()
+    , ICommand()
+    , Notifier()
+    , _command(command)
+    , _quiet_period(quiet_period)
+    , _timer_id(0)
+    , _pending(NULL)
+    , _trailing(this)
+{
+    if (_command == NULL)
+        throw std::runtime_error("Command parameter is null.");
+}
+
+void DebouncedCommand::initializeNotifier(std::string const& key)
+{
+    Notifier::initializeNotifier(key);
+    _command->initializeNotifier(key);
+}
+
+void DebouncedCommand::execute(INotification const& notification)
+{
+    Timer& timer = Timer::getInstance();
+    unsigned long stale_id;
+    do
+    {
+        FastMutex::ScopedLock lock(_synchronous_access);
+        stale_id = _timer_id;
+        _pending = new Notification(notification.getName(), notification.getBody(), notification.getType());
+        _timer_id = timer.schedule(_trailing, _pending, _quiet_period);
+    } while (false);
+
+    // The stale timer drops its notification once _pending changed, cancel
+    // outside the lock only to free it: the command may be sending to this one.
+    if (stale_id != 0)
+        timer.cancel(stale_id);
+}
+
+DebouncedCommand::~DebouncedCommand(void)
+{
+    unsigned long timer_id;
+    do
+    {
+        FastMutex::ScopedLock lock(_synchronous_access);
+        timer_id = _timer_id;
+        _timer_id = 0;
+        _pending = NULL;
+    } while (false);
+    if (timer_id != 0)
+        Timer::getInstance().cancel(timer_id);
+}
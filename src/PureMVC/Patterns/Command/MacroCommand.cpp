@@ -20,7 +20,7 @@ MacroCommand::MacroCommand(std::list<ICommand*> const& command_list)
     : INotifier()
     , ICommand()
     , Notifier()
-    , _sub_commands(command_list)
+    , _sub_commands(command_list.begin(), command_list.end())
 {
     initializeMacroCommand();
 }
@@ -41,20 +41,25 @@ inline void MacroCommand::addSubCommand(ICommand* command)
 {
     if (command == NULL)
         return;
+    if (!_multiton_key.empty())
+        command->initializeNotifier(_multiton_key);
     _sub_commands.push_back(command);
 }
 
-void MacroCommand::execute(INotification const& notification)
+void MacroCommand::initializeNotifier(std::string const& key)
 {
+    Notifier::initializeNotifier(key);
     CommandList::iterator result = _sub_commands.begin();
-    while(result != _sub_commands.end())
-    {
-        (*result)->initializeNotifier(_multiton_key);
-        (*result)->execute(notification);
+    for (; result != _sub_commands.end(); ++result)
+        (*result)->initializeNotifier(key);
+}
 
-        _sub_commands.erase(result);
-        result = _sub_commands.begin();
-    }
+void MacroCommand::execute(INotification const& notification)
+{
+    ICommand* const* result = _sub_commands.empty() ? NULL : &_sub_commands[0];
+    ICommand* const* end = result + _sub_commands.size();
+    for (; result != end; ++result)
+        (*result)->execute(notification);
 }
 
 MacroCommand& MacroCommand::operator=(MacroCommand const& arg)
@@ -0,0 +1,321 @@
+//  PipelineCommand.cpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#include "../../Common.hpp"
+
+namespace
+{
+    // Marks the end of the stream, passed from stage to stage by stop().
+    Notification puremvc_pipeline_stop("");
+
+    // Spins a little before the caller blocks, false once it should block.
+    inline bool spin(std::size_t& idle)
+    {
+        if (idle >= 128)
+            return false;
+        if (++idle > 64)
+            Thread::sleep(0);
+        return true;
+    }
+
+    // Wakes the thread sleeping on the event, if any.
+    inline void wake(long volatile* waiting, Event& event)
+    {
+        if (atomicCompareExchange(waiting, 0, 1) == 1)
+            event.set();
+    }
+}
+
+// Bounded ring buffer with one producer and one consumer.
+//
+// A side that finds the queue full (or empty) raises its waiting flag, checks
+// the queue again and sleeps on its event. The other side checks the flag after
+// moving its index, so one of them always sees the other's write.
+class PipelineCommand::Queue
+{
+private:
+    INotification* volatile* _items;
+    long _capacity;
+    long volatile _head;
+    long volatile _tail;
+    long volatile _push_waiting;
+    long volatile _pop_waiting;
+    Event _not_full;
+    Event _not_empty;
+    Queue(Queue const&);
+    Queue& operator=(Queue const&);
+public:
+    explicit Queue(std::size_t capacity)
+        : _items(new INotification* volatile[capacity])
+        , _capacity((long)capacity)
+        , _head(0)
+        , _tail(0)
+        , _push_waiting(0)
+        , _pop_waiting(0)
+    { }
+
+    bool tryPush(INotification* item)
+    {
+        long tail = _tail;
+        if (tail - atomicLoad(&_head) >= _capacity)
+            return false;
+        _items[tail % _capacity] = item;
+        atomicExchange(&_tail, tail + 1);
+        wake(&_pop_waiting, _not_empty);
+        return true;
+    }
+
+    void push(INotification* item)
+    {
+        std::size_t idle = 0;
+        while (!tryPush(item))
+        {
+            if (spin(idle))
+                continue;
+            atomicExchange(&_push_waiting, 1);
+            if (tryPush(item))
+            {
+                atomicExchange(&_push_waiting, 0);
+                return;
+            }
+            _not_full.wait();
+        }
+    }
+
+    INotification* tryPop(void)
+    {
+        long head = _head;
+        if (head == atomicLoad(&_tail))
+            return NULL;
+        INotification* item = _items[head % _capacity];
+        atomicExchange(&_head, head + 1);
+        wake(&_push_waiting, _not_full);
+        return item;
+    }
+
+    INotification* pop(void)
+    {
+        std::size_t idle = 0;
+        INotification* item;
+        while ((item = tryPop()) == NULL)
+        {
+            if (spin(idle))
+                continue;
+            atomicExchange(&_pop_waiting, 1);
+            if ((item = tryPop()) != NULL)
+            {
+                atomicExchange(&_pop_waiting, 0);
+                break;
+            }
+            _not_empty.wait();
+        }
+        return item;
+    }
+
+    ~Queue(void)
+    {
+        INotification* item;
+        while ((item = tryPop()) != NULL)
+        {
+            if (item != &puremvc_pipeline_stop)
+                delete item;
+        }
+        delete[] _items;
+    }
+};
+
+// Worker running one stage command on its own thread.
+class PipelineCommand::Stage : public SimpleCommand
+{
+public:
+    ICommand* command;
+    Queue input;
+    Thread* thread;
+    Stage* next;
+    PipelineCommand* owner;
+private:
+    Stage(Stage const&);
+    Stage& operator=(Stage const&);
+public:
+    Stage(PipelineCommand* owner, ICommand* command, std::size_t capacity)
+        : INotifier()
+        , ICommand()
+        , SimpleCommand()
+        , command(command)
+        , input(capacity)
+        , thread(NULL)
+        , next(NULL)
+        , owner(owner)
+    { }
+
+    virtual void execute(INotification const&)
+    {
+        for (;;)
+        {
+            INotification* item = input.pop();
+            if (item == &puremvc_pipeline_stop)
+            {
+                if (next != NULL)
+                    next->input.push(item);
+                return;
+            }
+            bool passed = false;
+            try
+            {
+                command->execute(*item);
+                passed = true;
+            }
+            catch(std::exception const& ex)
+            {
+                std::cerr << ex.what() << std::endl;
+            }
+            catch(...)
+            {
+                std::cerr << "Cannot handle exception from pipeline stage." << std::endl;
+            }
+            if (passed && next != NULL)
+                next->input.push(item);
+            else
+            {
+                delete item;
+                atomicIncrement(&owner->_completed);
+                wake(&owner->_flush_waiting, owner->_flushed);
+            }
+        }
+    }
+
+    ~Stage(void)
+    {
+        delete thread;
+    }
+};
+
+PipelineCommand::PipelineCommand(std::size_t capacity)
+    : INotifier()
+    , ICommand()
+    , Notifier()
+    , _capacity(capacity == 0 ? 1 : capacity)
+    , _submitted(0)
+    , _completed(0)
+    , _running(0)
+    , _flush_waiting(0)
+{ }
+
+PipelineCommand::PipelineCommand(ICommand* const* stages, std::size_t count, std::size_t capacity)
+    : INotifier()
+    , ICommand()
+    , Notifier()
+    , _capacity(capacity == 0 ? 1 : capacity)
+    , _submitted(0)
+    , _completed(0)
+    , _running(0)
+    , _flush_waiting(0)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        addStage(stages[i]);
+}
+
+void PipelineCommand::addStage(ICommand* command)
+{
+    if (command == NULL)
+        return;
+
+    FastMutex::ScopedLock lock(_mutex);
+    if (_running)
+        throwException<std::runtime_error>("Cannot add stage while pipeline is running.");
+    if (!_multiton_key.empty())
+        command->initializeNotifier(_multiton_key);
+    Stage* stage = new Stage(this, command, _capacity);
+    if (!_stages.empty())
+        _stages.back()->next = stage;
+    _stages.push_back(stage);
+}
+
+void PipelineCommand::initializeNotifier(std::string const& key)
+{
+    Notifier::initializeNotifier(key);
+    StageList::iterator result = _stages.begin();
+    for (; result != _stages.end(); ++result)
+        (*result)->command->initializeNotifier(key);
+}
+
+void PipelineCommand::execute(INotification const& notification)
+{
+    FastMutex::ScopedLock lock(_mutex);
+    if (_stages.empty())
+        return;
+    if (!_running)
+        start();
+    INotification* item = new Notification(notification.getName(), notification.getBody(), notification.getType());
+    atomicIncrement(&_submitted);
+    _stages.front()->input.push(item);
+}
+
+inline void PipelineCommand::start(void)
+{
+    StageList::iterator result = _stages.begin();
+    for (; result != _stages.end(); ++result)
+    {
+        (*result)->thread = new Thread(**result);
+        (*result)->thread->start(puremvc_pipeline_stop);
+    }
+    _running = 1;
+}
+
+void PipelineCommand::flush(void)
+{
+    // One flusher sleeps on the event at a time.
+    FastMutex::ScopedLock lock(_flush_mutex);
+    std::size_t idle = 0;
+    while (atomicLoad(&_completed) != atomicLoad(&_submitted))
+    {
+        if (spin(idle))
+            continue;
+        atomicExchange(&_flush_waiting, 1);
+        if (atomicLoad(&_completed) == atomicLoad(&_submitted))
+        {
+            atomicExchange(&_flush_waiting, 0);
+            break;
+        }
+        _flushed.wait();
+    }
+}
+
+void PipelineCommand::stop(void)
+{
+    FastMutex::ScopedLock lock(_mutex);
+    if (!_running)
+        return;
+    _stages.front()->input.push(&puremvc_pipeline_stop);
+    StageList::iterator result = _stages.begin();
+    for (; result != _stages.end(); ++result)
+    {
+        (*result)->thread->join();
+        delete (*result)->thread;
+        (*result)->thread = NULL;
+    }
+    _running = 0;
+}
+
+std::size_t PipelineCommand::getStageCount(void) const
+{
+    return _stages.size();
+}
+
+std::size_t PipelineCommand::getCompletedCount(void) const
+{
+    return (std::size_t)atomicLoad(&_completed);
+}
+
+PipelineCommand::~PipelineCommand(void)
+{
+    stop();
+    StageList::iterator result = _stages.begin();
+    for (; result != _stages.end(); ++result)
+        delete *result;
+}
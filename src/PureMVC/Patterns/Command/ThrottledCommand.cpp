@@ -0,0 +1,109 @@
+//  ThrottledCommand.cpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#include "../../Common.hpp"
+
+ThrottledCommand::Trailing::Trailing(ThrottledCommand* owner)
+    : INotifier()
+    , ICommand()
+    , SimpleCommand()
+    , _owner(owner)
+{ }
+
+void ThrottledCommand::Trailing::execute(INotification const& notification)
+{
+    do
+    {
+        FastMutex::ScopedLock lock(_owner->_synchronous_access);
+        if (_owner->_pending == &notification)
+        {
+            _owner->_pending = NULL;
+            _owner->_timer_id = 0;
+        }
+        _owner->acquire();
+    } while (false);
+    _owner->_command->execute(notification);
+}
+
+ThrottledCommand::ThrottledCommand(ICommand* command, std::size_t limit, long interval)
+    : INotifier()
+    , ICommand()
+    , Notifier()
+    , _command(command)
+    , _limit(limit == 0 ? 1 : limit)
+    , _interval(interval)
+    , _window_start(Timer::getTickCount())
+    , _count(0)
+    , _timer_id(0)
+    , _pending(NULL)
+    , _trailing(this)
+{
+    if (_command == NULL)
+        throw std::runtime_error("Command parameter is null.");
+}
+
+void ThrottledCommand::initializeNotifier(std::string const& key)
+{
+    Notifier::initializeNotifier(key);
+    _command->initializeNotifier(key);
+}
+
+inline bool ThrottledCommand::acquire(void)
+{
+    unsigned long now = Timer::getTickCount();
+    if ((long)(now - _window_start) >= _interval)
+    {
+        _window_start = now;
+        _count = 0;
+    }
+    if (_count >= _limit)
+        return false;
+    ++_count;
+    return true;
+}
+
+void ThrottledCommand::execute(INotification const& notification)
+{
+    bool passed;
+    unsigned long stale_id;
+    do
+    {
+        FastMutex::ScopedLock lock(_synchronous_access);
+        passed = acquire();
+        // A newer notification supersedes the kept one.
+        stale_id = _timer_id;
+        _timer_id = 0;
+        _pending = NULL;
+        if (!passed)
+        {
+            long delay = _interval - (long)(Timer::getTickCount() - _window_start);
+            _pending = new Notification(notification.getName(), notification.getBody(), notification.getType());
+            _timer_id = Timer::getInstance().schedule(_trailing, _pending, delay);
+        }
+    } while (false);
+
+    // Cancel outside the lock, the trailing execution may be waiting for it.
+    if (stale_id != 0)
+        Timer::getInstance().cancel(stale_id);
+    if (passed)
+        _command->execute(notification);
+}
+
+ThrottledCommand::~ThrottledCommand(void)
+{
+    unsigned long timer_id;
+    do
+    {
+        FastMutex::ScopedLock lock(_synchronous_access);
+        timer_id = _timer_id;
+        _timer_id = 0;
+        _pending = NULL;
+    } while (false);
+    if (timer_id != 0)
+        Timer::getInstance().cancel(timer_id);
+}
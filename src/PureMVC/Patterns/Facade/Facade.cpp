@@ -23,10 +23,12 @@ void Facade::insert(std::string const& key, IFacade* facade)
     puremvc_facade_instance_map.insert(key, facade);
 }
 
-Facade::Facade(std::string const& key)
+Facade::Facade(std::string const& key, CoreCapacity const& capacity)
     : _controller(NULL)
     , _model(NULL)
     , _view(NULL)
+    , _timer_command(NULL)
+    , _capacity(capacity)
 {
     if (puremvc_facade_instance_map.find(key))
         throw std::runtime_error(MULTITON_MSG);
@@ -42,14 +44,16 @@ void Facade::initializeFacade(void)
     initializeView();
 }
 
-IFacade& Facade::getInstance(std::string const& key)
+IFacade& Facade::getInstance(std::string const& key, CoreCapacity const& capacity)
 {
     IFacade* result = puremvc_facade_instance_map.find(key);
     if (result  == NULL)
     {
-        result = new Facade(key);
+        result = new Facade(key, capacity);
         puremvc_facade_instance_map.insert(std::make_pair(key, result));
     }
+    else
+        result->reserve(capacity);
     return *result;
 }
 
@@ -57,21 +61,21 @@ inline void Facade::initializeController(void)
 {
     if (_controller != NULL)
         return;
-    _controller = &Controller::getInstance(_multiton_key);
+    _controller = &Controller::getInstance(_multiton_key, _capacity);
 }
 
 void Facade::initializeModel(void)
 {
     if (_model != NULL)
         return;
-    _model = &Model::getInstance(_multiton_key);
+    _model = &Model::getInstance(_multiton_key, _capacity);
 }
 
 void Facade::initializeView(void)
 {
     if (_view != NULL)
         return;
-    _view = &View::getInstance(_multiton_key);
+    _view = &View::getInstance(_multiton_key, _capacity);
 }
 
 inline void Facade::registerCommand(std::string const& notification_name,ICommand* command)
@@ -81,6 +85,13 @@ inline void Facade::registerCommand(std::string const& notification_name,IComman
     _controller->registerCommand(notification_name, command);
 }
 
+inline void Facade::registerCommands(std::string const* notification_names, ICommand* const* commands, std::size_t count)
+{
+    if (_controller == NULL)
+        throwException<std::runtime_error>("Cannot register commands. Controller is null.");
+    _controller->registerCommands(notification_names, commands, count);
+}
+
 inline ICommand const& Facade::retrieveCommand(std::string const& notification_name) const
 {
     if (_controller == NULL)
@@ -95,6 +106,20 @@ inline ICommand& Facade::retrieveCommand(std::string const& notification_name)
     return _controller->retrieveCommand(notification_name);
 }
 
+inline ICommand const* Facade::tryRetrieveCommand(std::string const& notification_name) const
+{
+    if (_controller == NULL)
+        return NULL;
+    return _controller->tryRetrieveCommand(notification_name);
+}
+
+inline ICommand* Facade::tryRetrieveCommand(std::string const& notification_name)
+{
+    if (_controller == NULL)
+        return NULL;
+    return _controller->tryRetrieveCommand(notification_name);
+}
+
 inline ICommand* Facade::removeCommand(std::string const& notification_name)
 {
     if (_controller == NULL)
@@ -116,6 +141,40 @@ inline void Facade::registerProxy(IProxy* proxy)
     _model->registerProxy(proxy);
 }
 
+inline void Facade::registerProxies(IProxy* const* proxies, std::size_t count)
+{
+    if (_model == NULL)
+        throwException<std::runtime_error>("Cannot register proxies. Model is null.");
+    _model->registerProxies(proxies, count);
+}
+
+void Facade::reserve(CoreCapacity const& capacity)
+{
+    // a count of 0 reserves nothing, skip the lock
+    if (_model != NULL && capacity.proxies != 0)
+        _model->reserveProxies(capacity.proxies);
+    if (_view != NULL && capacity.mediators != 0)
+        _view->reserveMediators(capacity.mediators);
+    if (_view != NULL && capacity.notifications != 0)
+        _view->reserveObservers(capacity.notifications);
+    if (_controller != NULL && capacity.commands != 0)
+        _controller->reserveCommands(capacity.commands);
+}
+
+inline void Facade::registerProxyFactory(std::string const& proxy_name, IProxyFactory* factory)
+{
+    if (_model == NULL)
+        throwException<std::runtime_error>("Cannot register proxy factory [%s]. Model is null.", proxy_name.c_str());
+    _model->registerProxyFactory(proxy_name, factory);
+}
+
+inline void Facade::registerEvictableProxyFactory(std::string const& proxy_name, IProxyFactory* factory)
+{
+    if (_model == NULL)
+        throwException<std::runtime_error>("Cannot register evictable proxy factory [%s]. Model is null.", proxy_name.c_str());
+    _model->registerEvictableProxyFactory(proxy_name, factory);
+}
+
 inline IProxy const& Facade::retrieveProxy(std::string const& proxy_name) const
 {
     if (_model == NULL)
@@ -130,6 +189,20 @@ inline IProxy& Facade::retrieveProxy(std::string const& proxy_name)
     return _model->retrieveProxy(proxy_name);
 }
 
+inline IProxy const* Facade::tryRetrieveProxy(std::string const& proxy_name) const
+{
+    if (_model == NULL)
+        return NULL;
+    return _model->tryRetrieveProxy(proxy_name);
+}
+
+inline IProxy* Facade::tryRetrieveProxy(std::string const& proxy_name)
+{
+    if (_model == NULL)
+        return NULL;
+    return _model->tryRetrieveProxy(proxy_name);
+}
+
 inline IProxy* Facade::removeProxy (std::string const& proxy_name)
 {
     if (_model == NULL)
@@ -152,6 +225,13 @@ inline void Facade::registerMediator(IMediator* mediator)
     _view->registerMediator(mediator);
 }
 
+inline void Facade::registerMediators(IMediator* const* mediators, std::size_t count)
+{
+    if (_view == NULL)
+        throwException<std::runtime_error>("Cannot register mediators. View is null.");
+    _view->registerMediators(mediators, count);
+}
+
 inline IMediator const& Facade::retrieveMediator(std::string const& mediator_name) const
 {
     if (_view == NULL)
@@ -166,6 +246,20 @@ inline IMediator& Facade::retrieveMediator(std::string const& mediator_name)
     return _view->retrieveMediator(mediator_name);
 }
 
+inline IMediator const* Facade::tryRetrieveMediator(std::string const& mediator_name) const
+{
+    if (_view == NULL)
+        return NULL;
+    return _view->tryRetrieveMediator(mediator_name);
+}
+
+inline IMediator* Facade::tryRetrieveMediator(std::string const& mediator_name)
+{
+    if (_view == NULL)
+        return NULL;
+    return _view->tryRetrieveMediator(mediator_name);
+}
+
 inline IMediator* Facade::removeMediator(std::string const& mediator_name)
 {
     if (_view == NULL)
@@ -204,8 +298,13 @@ Facade::CoreNames Facade::listCores(void)
 
 void Facade::removeCore(std::string const& key)
 {
-    if (puremvc_facade_instance_map.find(key) == NULL)
+    IFacade* facade = puremvc_facade_instance_map.find(key);
+    if (facade == NULL)
         return;
+    // Pending timers would send to the removed core
+    Facade* instance = dynamic_cast<Facade*>(facade);
+    if (instance != NULL && instance->_timer_command != NULL)
+        Timer::getInstance().cancelAll(*instance->_timer_command);
     Model::removeModel( key );
     Controller::removeController( key );
     View::removeView( key );
@@ -216,6 +315,24 @@ namespace PureMVC
 {
     namespace Patterns
     {
+        class FacadeTimerCommand : public SimpleCommand
+        {
+        private:
+            IFacade* _facade;
+        public:
+            explicit FacadeTimerCommand(IFacade* facade)
+                : INotifier()
+                , ICommand()
+                , SimpleCommand()
+                , _facade(facade)
+            { }
+        public:
+            virtual void execute(INotification const& notification)
+            {
+                _facade->notifyObservers(notification);
+            }
+        };
+
         class FacadeNotifier
         {
         private:
@@ -249,8 +366,42 @@ void Facade::broadcastNotification(
     broadcastNotification(notification);
 }
 
+unsigned long Facade::sendNotificationAfter(long delay, std::string const& notification_name, void const* body, std::string const& type)
+{
+    return scheduleNotification(delay, 0, notification_name, body, type);
+}
+
+unsigned long Facade::sendNotificationEvery(long period, std::string const& notification_name, void const* body, std::string const& type)
+{
+    if (period <= 0)
+        throwException<std::runtime_error>("Cannot send notification [%s] every %ld milliseconds.", notification_name.c_str(), period);
+    return scheduleNotification(period, period, notification_name, body, type);
+}
+
+bool Facade::cancelNotification(unsigned long timer_id)
+{
+    return Timer::getInstance().cancel(timer_id);
+}
+
+unsigned long Facade::scheduleNotification(long delay, long period, std::string const& notification_name, void const* body, std::string const& type)
+{
+    if (_timer_command == NULL)
+    {
+        ICommand* command = new PureMVC::Patterns::FacadeTimerCommand(this);
+        if (atomicCompareExchangePointer((void* volatile*)&_timer_command, command, NULL) != NULL)
+            delete command;
+    }
+    return Timer::getInstance().schedule(*_timer_command, new Notification(notification_name, body, type), delay, period);
+}
+
 Facade::~Facade(void)
 {
+    if (_timer_command != NULL)
+    {
+        Timer::getInstance().cancelAll(*_timer_command);
+        delete _timer_command;
+        _timer_command = NULL;
+    }
     if (_view != NULL)
         delete _view;
     if (_model != NULL)
@@ -17,6 +17,8 @@ Mediator::Mediator(std::string const& mediator_name,
     , Notifier()
     , _mediator_name(mediator_name)
     , _view_component(view_component)
+    , _notification_interests(NULL)
+    , _notification_interest_count(0)
 { }
 
 Mediator::Mediator(Mediator const& arg)
@@ -25,6 +27,8 @@ Mediator::Mediator(Mediator const& arg)
     , Notifier(arg)
     , _mediator_name(arg._mediator_name)
     , _view_component(arg._view_component)
+    , _notification_interests(arg._notification_interests)
+    , _notification_interest_count(arg._notification_interest_count)
 { }
 
 inline std::string const& Mediator::getMediatorName(void) const
@@ -49,6 +53,18 @@ inline Mediator::NotificationNames Mediator::listNotificationInterests(void) con
     return NotificationNames(new result_t);
 }
 
+inline std::string const* Mediator::getNotificationInterests(std::size_t& count) const
+{
+    count = _notification_interest_count;
+    return _notification_interests;
+}
+
+void Mediator::setNotificationInterests(std::string const* names, std::size_t count)
+{
+    _notification_interests = names;
+    _notification_interest_count = names == NULL ? 0 : count;
+}
+
 inline void Mediator::handleNotification(INotification const& notification)
 {
     (void)notification;
@@ -64,6 +80,8 @@ Mediator& Mediator::operator=(Mediator const& arg)
 {
     _mediator_name = arg._mediator_name;
     _view_component = arg._view_component;
+    _notification_interests = arg._notification_interests;
+    _notification_interest_count = arg._notification_interest_count;
     return *this;
 }
 
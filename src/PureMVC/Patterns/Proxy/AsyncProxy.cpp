@@ -0,0 +1,248 @@
+//  AsyncProxy.cpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#include "../../Common.hpp"
+
+namespace
+{
+    Notification puremvc_async_start("");
+
+    // Shared pool of loader threads. Workers are started when loads are
+    // queued and stop when the queue is empty, so an idle pool has no thread.
+    struct AsyncLoader
+    {
+        FastMutex mutex;
+        std::list<AsyncProxy*> queue;
+        std::list<Thread*> workers;
+        std::size_t running;
+        std::size_t size;
+
+        AsyncLoader(void)
+            : running(0)
+            , size(AsyncProxy::DEFAULT_POOL_SIZE)
+        { }
+
+        ~AsyncLoader(void)
+        {
+            std::list<Thread*> stopped;
+            do
+            {
+                FastMutex::ScopedLock lock(mutex);
+                queue.clear();
+                stopped.swap(workers);
+            } while (false);
+            for (std::list<Thread*>::iterator result = stopped.begin(); result != stopped.end(); ++result)
+                delete *result;
+        }
+    } puremvc_async_loader;
+}
+
+// Loader thread, runs the queued loads until the queue is empty.
+class AsyncProxy::Worker : public SimpleCommand
+{
+public:
+    Worker(void)
+        : INotifier()
+        , ICommand()
+        , SimpleCommand()
+    { }
+
+    virtual void execute(INotification const&)
+    {
+        for (;;)
+        {
+            AsyncProxy* proxy;
+            do
+            {
+                FastMutex::ScopedLock lock(puremvc_async_loader.mutex);
+                if (puremvc_async_loader.queue.empty())
+                {
+                    --puremvc_async_loader.running;
+                    return;
+                }
+                proxy = puremvc_async_loader.queue.front();
+                puremvc_async_loader.queue.pop_front();
+            } while (false);
+            proxy->runLoad();
+        }
+    }
+
+    // Queues the load unless one is queued or running, starting a worker if
+    // the pool is not full.
+    static bool submit(AsyncProxy* proxy)
+    {
+        std::list<Thread*> finished;
+        FastMutex::ScopedLock lock(puremvc_async_loader.mutex);
+        long state = atomicLoad(&proxy->_load_state);
+        // The previous load may still be sending its notification.
+        if (state == QUEUED || state == LOADING || !proxy->_idle.tryWait(0))
+            return false;
+        // QUEUED is published with the push, and after the waiters are blocked:
+        // cancelLoad either drops the queued load or waits for it.
+        proxy->_idle.reset();
+        atomicExchange(&proxy->_load_state, QUEUED);
+        puremvc_async_loader.queue.push_back(proxy);
+        // Reap the workers which stopped since the last submit.
+        std::list<Thread*>::iterator result = puremvc_async_loader.workers.begin();
+        while (result != puremvc_async_loader.workers.end())
+        {
+            if ((*result)->isRunning())
+                ++result;
+            else
+            {
+                finished.push_back(*result);
+                result = puremvc_async_loader.workers.erase(result);
+            }
+        }
+        if (puremvc_async_loader.running < puremvc_async_loader.size
+            && puremvc_async_loader.running < puremvc_async_loader.queue.size())
+        {
+            Thread* thread = new Thread(new Worker());
+            ++puremvc_async_loader.running;
+            puremvc_async_loader.workers.push_back(thread);
+            thread->start(puremvc_async_start);
+        }
+        for (result = finished.begin(); result != finished.end(); ++result)
+            delete *result;
+        return true;
+    }
+};
+
+namespace
+{
+    bool dropLoad(AsyncProxy* proxy)
+    {
+        FastMutex::ScopedLock lock(puremvc_async_loader.mutex);
+        std::list<AsyncProxy*>::iterator result = std::find(puremvc_async_loader.queue.begin(), puremvc_async_loader.queue.end(), proxy);
+        if (result == puremvc_async_loader.queue.end())
+            return false;
+        puremvc_async_loader.queue.erase(result);
+        return true;
+    }
+}
+
+AsyncProxy::AsyncProxy(std::string const& proxy_name, std::string const& loaded_name, std::string const& failed_name)
+    : INotifier()
+    , IProxy()
+    , Proxy(proxy_name)
+    , _loaded_name(loaded_name)
+    , _failed_name(failed_name)
+    , _load_state(UNLOADED)
+    , _idle(false)
+{
+    _idle.set();
+}
+
+void AsyncProxy::onRegister(void)
+{
+    startLoad();
+}
+
+void AsyncProxy::onRemove(void)
+{
+    cancelLoad();
+}
+
+bool AsyncProxy::startLoad(void)
+{
+    return Worker::submit(this);
+}
+
+void AsyncProxy::cancelLoad(void)
+{
+    if (atomicLoad(&_load_state) == QUEUED && dropLoad(this))
+    {
+        atomicExchange(&_load_state, UNLOADED);
+        _idle.set();
+        return;
+    }
+    waitLoad();
+}
+
+AsyncProxy::LoadState AsyncProxy::getLoadState(void) const
+{
+    return (LoadState)atomicLoad(&_load_state);
+}
+
+bool AsyncProxy::isLoaded(void) const
+{
+    return getLoadState() == LOADED;
+}
+
+bool AsyncProxy::waitLoad(long milliseconds) const
+{
+    if (milliseconds >= 0)
+        return _idle.tryWait(milliseconds);
+    _idle.wait();
+    return true;
+}
+
+std::string AsyncProxy::getError(void) const
+{
+    FastMutex::ScopedLock lock(_synchronous_access);
+    return _error;
+}
+
+void AsyncProxy::setPoolSize(std::size_t size)
+{
+    FastMutex::ScopedLock lock(puremvc_async_loader.mutex);
+    puremvc_async_loader.size = size == 0 ? 1 : size;
+}
+
+std::size_t AsyncProxy::getPoolSize(void)
+{
+    FastMutex::ScopedLock lock(puremvc_async_loader.mutex);
+    return puremvc_async_loader.size;
+}
+
+void AsyncProxy::runLoad(void)
+{
+    atomicExchange(&_load_state, LOADING);
+    std::string error;
+    bool loaded = false;
+    try
+    {
+        load();
+        loaded = true;
+    }
+    catch (std::exception const& ex)
+    {
+        error = ex.what();
+    }
+    catch (...)
+    {
+        error = "Cannot handle exception from proxy load.";
+    }
+    do
+    {
+        FastMutex::ScopedLock lock(_synchronous_access);
+        _error = error;
+    } while (false);
+
+    atomicExchange(&_load_state, loaded ? LOADED : FAILED);
+
+    std::string const& name = loaded ? _loaded_name : _failed_name;
+    if (!name.empty())
+    {
+        try
+        {
+            sendNotification(name, static_cast<IProxy*>(this), _proxy_name);
+        }
+        catch (std::exception const& ex)
+        {
+            std::cerr << ex.what() << std::endl;
+        }
+    }
+    // A waiter may destroy the proxy from here.
+    _idle.set();
+}
+
+AsyncProxy::~AsyncProxy(void)
+{
+    cancelLoad();
+}
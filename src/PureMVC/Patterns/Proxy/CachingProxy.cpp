@@ -0,0 +1,14 @@
+//  CachingProxy.cpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#include "../../Common.hpp"
+
+unsigned long CacheClock::getTime(void)
+{
+    return Timer::getTickCount();
+}
@@ -0,0 +1,96 @@
+//  ChangeTrackingProxy.cpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#include "../../Common.hpp"
+
+bool ChangeTrackingProxy::ChangeSet::hasField(std::size_t field) const
+{
+    return field < FIELD_COUNT && (fields & (1UL << field)) != 0;
+}
+
+bool ChangeTrackingProxy::ChangeSet::hasRecord(unsigned long id) const
+{
+    return std::binary_search(records.begin(), records.end(), id);
+}
+
+ChangeTrackingProxy::ChangeTrackingProxy(std::string const& proxy_name, std::string const& change_name, void const* data)
+    : INotifier()
+    , IProxy()
+    , Proxy(proxy_name, data)
+    , _change_name(change_name)
+    , _depth(0)
+{
+    _pending.fields = 0;
+}
+
+void ChangeTrackingProxy::beginChanges(void)
+{
+    FastMutex::ScopedLock lock(_synchronous_access);
+    ++_depth;
+}
+
+void ChangeTrackingProxy::commitChanges(void)
+{
+    do
+    {
+        FastMutex::ScopedLock lock(_synchronous_access);
+        if (_depth == 0)
+            throwException<std::runtime_error>("Cannot commit changes of proxy [%s]. No transaction is open.", _proxy_name.c_str());
+        --_depth;
+    }while (false);
+    flushChanges();
+}
+
+bool ChangeTrackingProxy::flushChanges(void)
+{
+    ChangeSet change_set;
+    do
+    {
+        FastMutex::ScopedLock lock(_synchronous_access);
+        if (_depth != 0 || (_pending.fields == 0 && _pending.records.empty()))
+            return false;
+        change_set.fields = _pending.fields;
+        change_set.records.swap(_pending.records);
+        _pending.fields = 0;
+    }while (false);
+
+    std::sort(change_set.records.begin(), change_set.records.end());
+    change_set.records.erase(std::unique(change_set.records.begin(), change_set.records.end()), change_set.records.end());
+    sendNotification(_change_name, &change_set, _proxy_name);
+    return true;
+}
+
+void ChangeTrackingProxy::markChanged(std::size_t field)
+{
+    if (field >= FIELD_COUNT)
+        throwException<std::runtime_error>("Cannot mark field [%u] of proxy [%s]. Index is out of range.", (unsigned int)field, _proxy_name.c_str());
+    FastMutex::ScopedLock lock(_synchronous_access);
+    _pending.fields |= 1UL << field;
+    incrementRevision();
+}
+
+void ChangeTrackingProxy::markRecordChanged(unsigned long id)
+{
+    FastMutex::ScopedLock lock(_synchronous_access);
+    _pending.records.push_back(id);
+    incrementRevision();
+}
+
+bool ChangeTrackingProxy::hasChanges(void) const
+{
+    FastMutex::ScopedLock lock(_synchronous_access);
+    return _pending.fields != 0 || !_pending.records.empty();
+}
+
+std::string const& ChangeTrackingProxy::getChangeName(void) const
+{
+    return _change_name;
+}
+
+ChangeTrackingProxy::~ChangeTrackingProxy(void)
+{ }
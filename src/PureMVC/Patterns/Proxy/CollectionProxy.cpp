@@ -0,0 +1,450 @@
+//  CollectionProxy.cpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#include "../../Common.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PUREMVC_COLUMN_SSE2
+#include <emmintrin.h>
+#if defined(__AVX__)
+#define PUREMVC_COLUMN_AVX
+#include <immintrin.h>
+#endif
+#if defined(__AVX2__)
+#define PUREMVC_COLUMN_AVX2
+#endif
+#endif
+
+namespace
+{
+#if defined(PUREMVC_COLUMN_SSE2)
+    // Lane operations of one vector register, specialized per column type.
+    template<typename _Type>
+    struct Lanes;
+
+#if defined(PUREMVC_COLUMN_AVX)
+    template<>
+    struct Lanes<double>
+    {
+        typedef __m256d type;
+        enum { WIDTH = 4 };
+        static type load(double const* values) { return _mm256_loadu_pd(values); }
+        static void store(double* values, type a) { _mm256_storeu_pd(values, a); }
+        static type set(double value) { return _mm256_set1_pd(value); }
+        static type add(type a, type b) { return _mm256_add_pd(a, b); }
+        static type minimum(type a, type b) { return _mm256_min_pd(a, b); }
+        static type maximum(type a, type b) { return _mm256_max_pd(a, b); }
+        static type less(type a, type b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+        static type lessEqual(type a, type b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+        static type greater(type a, type b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+        static type greaterEqual(type a, type b) { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+        static type equal(type a, type b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+        static type notEqual(type a, type b) { return _mm256_cmp_pd(a, b, _CMP_NEQ_UQ); }
+        static int mask(type a) { return _mm256_movemask_pd(a); }
+    };
+
+    template<>
+    struct Lanes<float>
+    {
+        typedef __m256 type;
+        enum { WIDTH = 8 };
+        static type load(float const* values) { return _mm256_loadu_ps(values); }
+        static void store(float* values, type a) { _mm256_storeu_ps(values, a); }
+        static type set(float value) { return _mm256_set1_ps(value); }
+        static type add(type a, type b) { return _mm256_add_ps(a, b); }
+        static type minimum(type a, type b) { return _mm256_min_ps(a, b); }
+        static type maximum(type a, type b) { return _mm256_max_ps(a, b); }
+        static type less(type a, type b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+        static type lessEqual(type a, type b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+        static type greater(type a, type b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+        static type greaterEqual(type a, type b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+        static type equal(type a, type b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+        static type notEqual(type a, type b) { return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ); }
+        static int mask(type a) { return _mm256_movemask_ps(a); }
+    };
+#else
+    template<>
+    struct Lanes<double>
+    {
+        typedef __m128d type;
+        enum { WIDTH = 2 };
+        static type load(double const* values) { return _mm_loadu_pd(values); }
+        static void store(double* values, type a) { _mm_storeu_pd(values, a); }
+        static type set(double value) { return _mm_set1_pd(value); }
+        static type add(type a, type b) { return _mm_add_pd(a, b); }
+        static type minimum(type a, type b) { return _mm_min_pd(a, b); }
+        static type maximum(type a, type b) { return _mm_max_pd(a, b); }
+        static type less(type a, type b) { return _mm_cmplt_pd(a, b); }
+        static type lessEqual(type a, type b) { return _mm_cmple_pd(a, b); }
+        static type greater(type a, type b) { return _mm_cmpgt_pd(a, b); }
+        static type greaterEqual(type a, type b) { return _mm_cmpge_pd(a, b); }
+        static type equal(type a, type b) { return _mm_cmpeq_pd(a, b); }
+        static type notEqual(type a, type b) { return _mm_cmpneq_pd(a, b); }
+        static int mask(type a) { return _mm_movemask_pd(a); }
+    };
+
+    template<>
+    struct Lanes<float>
+    {
+        typedef __m128 type;
+        enum { WIDTH = 4 };
+        static type load(float const* values) { return _mm_loadu_ps(values); }
+        static void store(float* values, type a) { _mm_storeu_ps(values, a); }
+        static type set(float value) { return _mm_set1_ps(value); }
+        static type add(type a, type b) { return _mm_add_ps(a, b); }
+        static type minimum(type a, type b) { return _mm_min_ps(a, b); }
+        static type maximum(type a, type b) { return _mm_max_ps(a, b); }
+        static type less(type a, type b) { return _mm_cmplt_ps(a, b); }
+        static type lessEqual(type a, type b) { return _mm_cmple_ps(a, b); }
+        static type greater(type a, type b) { return _mm_cmpgt_ps(a, b); }
+        static type greaterEqual(type a, type b) { return _mm_cmpge_ps(a, b); }
+        static type equal(type a, type b) { return _mm_cmpeq_ps(a, b); }
+        static type notEqual(type a, type b) { return _mm_cmpneq_ps(a, b); }
+        static int mask(type a) { return _mm_movemask_ps(a); }
+    };
+#endif
+
+#if defined(PUREMVC_COLUMN_AVX2)
+    template<>
+    struct Lanes<int>
+    {
+        typedef __m256i type;
+        enum { WIDTH = 8 };
+        static type load(int const* values) { return _mm256_loadu_si256((__m256i const*)values); }
+        static void store(int* values, type a) { _mm256_storeu_si256((__m256i*)values, a); }
+        static type set(int value) { return _mm256_set1_epi32(value); }
+        static type ones(void) { return _mm256_set1_epi32(-1); }
+        static type add(type a, type b) { return _mm256_add_epi32(a, b); }
+        static type minimum(type a, type b) { return _mm256_min_epi32(a, b); }
+        static type maximum(type a, type b) { return _mm256_max_epi32(a, b); }
+        static type less(type a, type b) { return _mm256_cmpgt_epi32(b, a); }
+        static type lessEqual(type a, type b) { return _mm256_xor_si256(greater(a, b), ones()); }
+        static type greater(type a, type b) { return _mm256_cmpgt_epi32(a, b); }
+        static type greaterEqual(type a, type b) { return _mm256_xor_si256(less(a, b), ones()); }
+        static type equal(type a, type b) { return _mm256_cmpeq_epi32(a, b); }
+        static type notEqual(type a, type b) { return _mm256_xor_si256(equal(a, b), ones()); }
+        static int mask(type a) { return _mm256_movemask_ps(_mm256_castsi256_ps(a)); }
+    };
+#else
+    template<>
+    struct Lanes<int>
+    {
+        typedef __m128i type;
+        enum { WIDTH = 4 };
+        static type load(int const* values) { return _mm_loadu_si128((__m128i const*)values); }
+        static void store(int* values, type a) { _mm_storeu_si128((__m128i*)values, a); }
+        static type set(int value) { return _mm_set1_epi32(value); }
+        static type ones(void) { return _mm_set1_epi32(-1); }
+        static type add(type a, type b) { return _mm_add_epi32(a, b); }
+        // SSE2 has no 32 bit min/max, select with the comparison mask.
+        static type select(type m, type a, type b) { return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b)); }
+        static type minimum(type a, type b) { return select(_mm_cmplt_epi32(a, b), a, b); }
+        static type maximum(type a, type b) { return select(_mm_cmpgt_epi32(a, b), a, b); }
+        static type less(type a, type b) { return _mm_cmplt_epi32(a, b); }
+        static type lessEqual(type a, type b) { return _mm_xor_si128(greater(a, b), ones()); }
+        static type greater(type a, type b) { return _mm_cmpgt_epi32(a, b); }
+        static type greaterEqual(type a, type b) { return _mm_xor_si128(less(a, b), ones()); }
+        static type equal(type a, type b) { return _mm_cmpeq_epi32(a, b); }
+        static type notEqual(type a, type b) { return _mm_xor_si128(equal(a, b), ones()); }
+        static int mask(type a) { return _mm_movemask_ps(_mm_castsi128_ps(a)); }
+    };
+#endif
+
+    // Comparisons selected once per scan, outside the loop.
+    struct Less
+    {
+        template<typename _Lanes>
+        static typename _Lanes::type apply(typename _Lanes::type a, typename _Lanes::type b) { return _Lanes::less(a, b); }
+    };
+
+    struct LessEqual
+    {
+        template<typename _Lanes>
+        static typename _Lanes::type apply(typename _Lanes::type a, typename _Lanes::type b) { return _Lanes::lessEqual(a, b); }
+    };
+
+    struct Greater
+    {
+        template<typename _Lanes>
+        static typename _Lanes::type apply(typename _Lanes::type a, typename _Lanes::type b) { return _Lanes::greater(a, b); }
+    };
+
+    struct GreaterEqual
+    {
+        template<typename _Lanes>
+        static typename _Lanes::type apply(typename _Lanes::type a, typename _Lanes::type b) { return _Lanes::greaterEqual(a, b); }
+    };
+
+    struct Equal
+    {
+        template<typename _Lanes>
+        static typename _Lanes::type apply(typename _Lanes::type a, typename _Lanes::type b) { return _Lanes::equal(a, b); }
+    };
+
+    struct NotEqual
+    {
+        template<typename _Lanes>
+        static typename _Lanes::type apply(typename _Lanes::type a, typename _Lanes::type b) { return _Lanes::notEqual(a, b); }
+    };
+
+    template<typename _Type>
+    _Type sumColumn(_Type const* values, std::size_t count)
+    {
+        typedef Lanes<_Type> lanes_t;
+        std::size_t const width = lanes_t::WIDTH;
+        std::size_t i = 0;
+        _Type result = _Type();
+        if (count >= 2 * width)
+        {
+            // Two accumulators hide the latency of the additions.
+            typename lanes_t::type first = lanes_t::set(_Type());
+            typename lanes_t::type second = first;
+            for (; i + 2 * width <= count; i += 2 * width)
+            {
+                first = lanes_t::add(first, lanes_t::load(values + i));
+                second = lanes_t::add(second, lanes_t::load(values + i + width));
+            }
+            _Type lanes[lanes_t::WIDTH];
+            lanes_t::store(lanes, lanes_t::add(first, second));
+            for (std::size_t j = 0; j < width; ++j)
+                result += lanes[j];
+        }
+        for (; i < count; ++i)
+            result += values[i];
+        return result;
+    }
+
+    template<typename _Type, bool _Minimum>
+    _Type reduceColumn(_Type const* values, std::size_t count)
+    {
+        typedef Lanes<_Type> lanes_t;
+        std::size_t const width = lanes_t::WIDTH;
+        std::size_t i = 0;
+        _Type result = values[0];
+        if (count >= width)
+        {
+            typename lanes_t::type accumulator = lanes_t::load(values);
+            for (i = width; i + width <= count; i += width)
+                accumulator = _Minimum ? lanes_t::minimum(accumulator, lanes_t::load(values + i))
+                                       : lanes_t::maximum(accumulator, lanes_t::load(values + i));
+            _Type lanes[lanes_t::WIDTH];
+            lanes_t::store(lanes, accumulator);
+            result = lanes[0];
+            for (std::size_t j = 1; j < width; ++j)
+                if (_Minimum ? lanes[j] < result : result < lanes[j])
+                    result = lanes[j];
+        }
+        for (; i < count; ++i)
+            if (_Minimum ? values[i] < result : result < values[i])
+                result = values[i];
+        return result;
+    }
+
+    template<typename _Compare, typename _Type>
+    std::size_t countColumn(_Type const* values, std::size_t count, ColumnKernels::Comparison op, _Type operand)
+    {
+        typedef Lanes<_Type> lanes_t;
+        std::size_t const width = lanes_t::WIDTH;
+        typename lanes_t::type right = lanes_t::set(operand);
+        std::size_t result = 0;
+        std::size_t i = 0;
+        for (; i + width <= count; i += width)
+        {
+            int mask = lanes_t::mask(_Compare::template apply<lanes_t>(lanes_t::load(values + i), right));
+            for (; mask != 0; mask &= mask - 1)
+                ++result;
+        }
+        return result + ScalarColumnOperations<_Type>::count(values + i, count - i, op, operand);
+    }
+
+    template<typename _Compare, typename _Type>
+    std::size_t filterColumn(_Type const* values, std::size_t count, ColumnKernels::Comparison op, _Type operand, std::size_t* indices)
+    {
+        typedef Lanes<_Type> lanes_t;
+        std::size_t const width = lanes_t::WIDTH;
+        typename lanes_t::type right = lanes_t::set(operand);
+        std::size_t result = 0;
+        std::size_t i = 0;
+        for (; i + width <= count; i += width)
+        {
+            int mask = lanes_t::mask(_Compare::template apply<lanes_t>(lanes_t::load(values + i), right));
+            for (std::size_t j = 0; mask != 0; ++j, mask >>= 1)
+                if (mask & 1)
+                    indices[result++] = i + j;
+        }
+        for (; i < count; ++i)
+            if (ScalarColumnOperations<_Type>::compare(values[i], op, operand))
+                indices[result++] = i;
+        return result;
+    }
+
+    template<typename _Type>
+    inline _Type sum(_Type const* values, std::size_t count)
+    {
+        return sumColumn(values, count);
+    }
+
+    template<typename _Type>
+    inline _Type minimum(_Type const* values, std::size_t count)
+    {
+        return reduceColumn<_Type, true>(values, count);
+    }
+
+    template<typename _Type>
+    inline _Type maximum(_Type const* values, std::size_t count)
+    {
+        return reduceColumn<_Type, false>(values, count);
+    }
+
+    template<typename _Type>
+    std::size_t count(_Type const* values, std::size_t count, ColumnKernels::Comparison op, _Type operand)
+    {
+        switch (op)
+        {
+        case ColumnKernels::LESS: return countColumn<Less>(values, count, op, operand);
+        case ColumnKernels::LESS_EQUAL: return countColumn<LessEqual>(values, count, op, operand);
+        case ColumnKernels::GREATER: return countColumn<Greater>(values, count, op, operand);
+        case ColumnKernels::GREATER_EQUAL: return countColumn<GreaterEqual>(values, count, op, operand);
+        case ColumnKernels::EQUAL: return countColumn<Equal>(values, count, op, operand);
+        default: return countColumn<NotEqual>(values, count, op, operand);
+        }
+    }
+
+    template<typename _Type>
+    std::size_t filter(_Type const* values, std::size_t count, ColumnKernels::Comparison op, _Type operand, std::size_t* indices)
+    {
+        switch (op)
+        {
+        case ColumnKernels::LESS: return filterColumn<Less>(values, count, op, operand, indices);
+        case ColumnKernels::LESS_EQUAL: return filterColumn<LessEqual>(values, count, op, operand, indices);
+        case ColumnKernels::GREATER: return filterColumn<Greater>(values, count, op, operand, indices);
+        case ColumnKernels::GREATER_EQUAL: return filterColumn<GreaterEqual>(values, count, op, operand, indices);
+        case ColumnKernels::EQUAL: return filterColumn<Equal>(values, count, op, operand, indices);
+        default: return filterColumn<NotEqual>(values, count, op, operand, indices);
+        }
+    }
+#else
+    template<typename _Type>
+    inline _Type sum(_Type const* values, std::size_t count)
+    {
+        return ScalarColumnOperations<_Type>::sum(values, count);
+    }
+
+    template<typename _Type>
+    inline _Type minimum(_Type const* values, std::size_t count)
+    {
+        return ScalarColumnOperations<_Type>::minimum(values, count);
+    }
+
+    template<typename _Type>
+    inline _Type maximum(_Type const* values, std::size_t count)
+    {
+        return ScalarColumnOperations<_Type>::maximum(values, count);
+    }
+
+    template<typename _Type>
+    inline std::size_t count(_Type const* values, std::size_t count, ColumnKernels::Comparison op, _Type operand)
+    {
+        return ScalarColumnOperations<_Type>::count(values, count, op, operand);
+    }
+
+    template<typename _Type>
+    inline std::size_t filter(_Type const* values, std::size_t count, ColumnKernels::Comparison op, _Type operand, std::size_t* indices)
+    {
+        return ScalarColumnOperations<_Type>::filter(values, count, op, operand, indices);
+    }
+#endif
+}
+
+char const* ColumnKernels::getInstructionSet(void)
+{
+#if defined(PUREMVC_COLUMN_AVX2)
+    return "AVX2";
+#elif defined(PUREMVC_COLUMN_AVX)
+    return "AVX";
+#elif defined(PUREMVC_COLUMN_SSE2)
+    return "SSE2";
+#else
+    return "Scalar";
+#endif
+}
+
+int ColumnKernels::sum(int const* values, std::size_t count)
+{
+    return ::sum(values, count);
+}
+
+float ColumnKernels::sum(float const* values, std::size_t count)
+{
+    return ::sum(values, count);
+}
+
+double ColumnKernels::sum(double const* values, std::size_t count)
+{
+    return ::sum(values, count);
+}
+
+int ColumnKernels::minimum(int const* values, std::size_t count)
+{
+    return ::minimum(values, count);
+}
+
+float ColumnKernels::minimum(float const* values, std::size_t count)
+{
+    return ::minimum(values, count);
+}
+
+double ColumnKernels::minimum(double const* values, std::size_t count)
+{
+    return ::minimum(values, count);
+}
+
+int ColumnKernels::maximum(int const* values, std::size_t count)
+{
+    return ::maximum(values, count);
+}
+
+float ColumnKernels::maximum(float const* values, std::size_t count)
+{
+    return ::maximum(values, count);
+}
+
+double ColumnKernels::maximum(double const* values, std::size_t count)
+{
+    return ::maximum(values, count);
+}
+
+std::size_t ColumnKernels::count(int const* values, std::size_t count, Comparison op, int operand)
+{
+    return ::count(values, count, op, operand);
+}
+
+std::size_t ColumnKernels::count(float const* values, std::size_t count, Comparison op, float operand)
+{
+    return ::count(values, count, op, operand);
+}
+
+std::size_t ColumnKernels::count(double const* values, std::size_t count, Comparison op, double operand)
+{
+    return ::count(values, count, op, operand);
+}
+
+std::size_t ColumnKernels::filter(int const* values, std::size_t count, Comparison op, int operand, std::size_t* indices)
+{
+    return ::filter(values, count, op, operand, indices);
+}
+
+std::size_t ColumnKernels::filter(float const* values, std::size_t count, Comparison op, float operand, std::size_t* indices)
+{
+    return ::filter(values, count, op, operand, indices);
+}
+
+std::size_t ColumnKernels::filter(double const* values, std::size_t count, Comparison op, double operand, std::size_t* indices)
+{
+    return ::filter(values, count, op, operand, indices);
+}
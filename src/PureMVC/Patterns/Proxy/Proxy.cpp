@@ -16,6 +16,7 @@ Proxy::Proxy(std::string const& proxy_name, void const* data)
     , Notifier()
     , _proxy_name(proxy_name)
     , _data(data)
+    , _revision(0)
 { }
 
 Proxy::Proxy(Proxy const& arg)
@@ -24,6 +25,7 @@ Proxy::Proxy(Proxy const& arg)
     , Notifier(arg)
     , _proxy_name(arg._proxy_name)
     , _data(arg._data)
+    , _revision(arg._revision)
 { }
 
 inline std::string const& Proxy::getProxyName(void) const
@@ -34,6 +36,7 @@ inline std::string const& Proxy::getProxyName(void) const
 inline void Proxy::setData(void const* data)
 {
     _data = data;
+    incrementRevision();
 }
 
 inline void const* Proxy::getData(void) const
@@ -41,6 +44,16 @@ inline void const* Proxy::getData(void) const
     return _data;
 }
 
+long Proxy::getRevision(void) const
+{
+    return atomicLoad(&_revision);
+}
+
+void Proxy::incrementRevision(void)
+{
+    atomicIncrement(&_revision);
+}
+
 inline void Proxy::onRegister(void)
 { }
 
@@ -51,6 +64,7 @@ Proxy& Proxy::operator=(Proxy const& arg)
 {
     _proxy_name = arg._proxy_name;
     _data = arg._data;
+    incrementRevision();
     return *this;
 }
 
@@ -0,0 +1,280 @@
+//  ProxySnapshot.cpp
+//  PureMVC_C++
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#include "../../Common.hpp"
+
+namespace
+{
+    struct SavedProxy
+    {
+        std::string name;
+        ISerializable const* image;
+        std::size_t size;
+    };
+
+    inline std::size_t alignOffset(std::size_t offset)
+    {
+        return (offset + 7) & ~(std::size_t)7;
+    }
+
+    inline void splitOffset(std::size_t value, unsigned int& low, unsigned int& high)
+    {
+        low = (unsigned int)(value & 0xFFFFFFFFUL);
+        // Two shifts keep the expression defined for a 32 bit size_t.
+        high = (unsigned int)((value >> 16) >> 16);
+    }
+
+    inline bool joinOffset(unsigned int low, unsigned int high, std::size_t& value)
+    {
+        value = (std::size_t)low;
+        if (high == 0)
+            return true;
+        if (sizeof(std::size_t) <= 4)
+            return false;
+        value |= ((std::size_t)high << 16) << 16;
+        return true;
+    }
+
+    void writePadding(std::ofstream& output, std::size_t& offset)
+    {
+        static char const zero[8] = { 0 };
+        std::size_t aligned = alignOffset(offset);
+        output.write(zero, (std::streamsize)(aligned - offset));
+        offset = aligned;
+    }
+}
+
+ProxySnapshot::ProxySnapshot(std::string const& path)
+    : _entries(NULL)
+    , _count(0)
+{
+    if (!path.empty())
+        open(path);
+}
+
+std::size_t ProxySnapshot::save(IModel const& model, std::string const& path)
+{
+    std::vector<SavedProxy> proxies;
+    do
+    {
+        IModel::ProxyNames names = model.listProxyNames();
+        IModel::ProxyNames::element_type::Iterator iterator = names->getIterator();
+        while (iterator->moveNext())
+        {
+            // a proxy whose factory was not used, or was evicted, has no state to save
+            IProxy const* proxy = model.tryRetrieveBuiltProxy(iterator->getCurrent());
+            ISerializable const* image = dynamic_cast<ISerializable const*>(proxy);
+            if (image == NULL)
+                continue;
+            SavedProxy saved;
+            saved.name = iterator->getCurrent();
+            saved.image = image;
+            saved.size = image->getSerializedSize();
+            proxies.push_back(saved);
+        }
+    } while (false);
+
+    std::size_t count = proxies.size();
+    std::size_t offset = MappedFileHeader::SIZE + count * sizeof(Entry);
+    std::vector<Entry> entries(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        entries[i].name_offset = (unsigned int)offset;
+        entries[i].name_size = (unsigned int)proxies[i].name.size();
+        entries[i].serial_type = proxies[i].image->getSerialType();
+        entries[i].reserved = 0;
+        offset += proxies[i].name.size();
+        if (offset > 0xFFFFFFFFUL)
+            throwException<std::runtime_error>("Too many proxy names for snapshot: [%s].", path.c_str());
+    }
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        offset = alignOffset(offset);
+        splitOffset(offset, entries[i].data_offset_low, entries[i].data_offset_high);
+        splitOffset(proxies[i].size, entries[i].data_size_low, entries[i].data_size_high);
+        offset += proxies[i].size;
+    }
+
+    MappedFileHeader header;
+    std::memcpy(header.magic, MappedFileHeader::getMagic(), sizeof(header.magic));
+    header.version = MappedFileHeader::VERSION;
+    header.data_offset = MappedFileHeader::SIZE;
+    header.record_size = sizeof(Entry);
+    header.record_type = RECORD_TYPE;
+    splitOffset(count, header.count_low, header.count_high);
+
+    // Replace the previous snapshot only once the new one is complete.
+    std::string temporary = path + ".tmp";
+    do
+    {
+        std::ofstream output(temporary.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        output.write((char const*)&header, sizeof(header));
+        if (count != 0)
+            output.write((char const*)&entries[0], (std::streamsize)(count * sizeof(Entry)));
+        offset = MappedFileHeader::SIZE + count * sizeof(Entry);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            output.write(proxies[i].name.data(), (std::streamsize)proxies[i].name.size());
+            offset += proxies[i].name.size();
+        }
+        std::vector<char> buffer;
+        for (std::size_t i = 0; i < count && output.good(); ++i)
+        {
+            writePadding(output, offset);
+            if (proxies[i].size == 0)
+                continue;
+            buffer.assign(proxies[i].size, 0);
+            proxies[i].image->serialize(&buffer[0]);
+            output.write(&buffer[0], (std::streamsize)buffer.size());
+            offset += buffer.size();
+        }
+        output.close();
+        if (output.fail())
+        {
+            std::remove(temporary.c_str());
+            throwException<std::runtime_error>("Cannot write snapshot: [%s].", temporary.c_str());
+        }
+    } while (false);
+    if (!replaceFile(temporary, path))
+    {
+        std::remove(temporary.c_str());
+        throwException<std::runtime_error>("Cannot write snapshot: [%s].", path.c_str());
+    }
+    return count;
+}
+
+void ProxySnapshot::open(std::string const& path)
+{
+    close();
+    _file.open(path);
+    std::size_t size = _file.getSize();
+    char const* data = (char const*)_file.getData();
+    MappedFileHeader header;
+    if (size < (std::size_t)MappedFileHeader::SIZE)
+        fail("File is too small for a header", path);
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, MappedFileHeader::getMagic(), sizeof(header.magic)) != 0)
+        fail("Invalid file format", path);
+    if (header.version != MappedFileHeader::VERSION)
+        fail("Unsupported version or byte order", path);
+    if (header.record_size != sizeof(Entry) || header.record_type != RECORD_TYPE)
+        fail("File is not a proxy snapshot", path);
+    if (header.data_offset < (unsigned int)MappedFileHeader::SIZE || header.data_offset % 8 != 0 || header.data_offset > size)
+        fail("Invalid data offset", path);
+    std::size_t count;
+    if (!joinOffset(header.count_low, header.count_high, count) || count > (size - header.data_offset) / sizeof(Entry))
+        fail("File is truncated", path);
+    Entry const* entries = (Entry const*)(data + header.data_offset);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::size_t offset, length;
+        if ((std::size_t)entries[i].name_offset > size || (std::size_t)entries[i].name_size > size - entries[i].name_offset)
+            fail("File is truncated", path);
+        if (!joinOffset(entries[i].data_offset_low, entries[i].data_offset_high, offset)
+            || !joinOffset(entries[i].data_size_low, entries[i].data_size_high, length)
+            || offset % 8 != 0 || offset > size || length > size - offset)
+            fail("File is truncated", path);
+    }
+    _entries = entries;
+    _count = count;
+}
+
+void ProxySnapshot::close(void)
+{
+    _entries = NULL;
+    _count = 0;
+    _file.close();
+}
+
+bool ProxySnapshot::isOpen(void) const
+{
+    return _file.isOpen();
+}
+
+std::size_t ProxySnapshot::getCount(void) const
+{
+    return _count;
+}
+
+void ProxySnapshot::registerFactory(unsigned int serial_type, IProxyFactory* factory)
+{
+    if (factory == NULL)
+        return;
+    FactoryMap::iterator result = _factory_map.find(serial_type);
+    if (result != _factory_map.end())
+    {
+        if (result->second != factory)
+            delete result->second;
+        result->second = factory;
+        return;
+    }
+    _factory_map.insert(std::make_pair(serial_type, factory));
+}
+
+std::size_t ProxySnapshot::restore(IModel& model)
+{
+    if (!isOpen())
+        throw std::runtime_error("Proxy snapshot is not open.");
+
+    char const* data = (char const*)_file.getData();
+    std::size_t restored = 0;
+    for (std::size_t i = 0; i < _count; ++i)
+    {
+        Entry const& entry = _entries[i];
+        std::string name(data + entry.name_offset, entry.name_size);
+        std::size_t offset, size;
+        joinOffset(entry.data_offset_low, entry.data_offset_high, offset);
+        joinOffset(entry.data_size_low, entry.data_size_high, size);
+
+        IProxy* proxy = model.tryRetrieveProxy(name);
+        if (proxy != NULL)
+        {
+            ISerializable* image = dynamic_cast<ISerializable*>(proxy);
+            if (image == NULL || image->getSerialType() != entry.serial_type)
+                throwException<std::runtime_error>("Registered proxy does not match its snapshot: [%s].", name.c_str());
+            image->deserialize(data + offset, size);
+            ++restored;
+            continue;
+        }
+
+        FactoryMap::iterator factory = _factory_map.find(entry.serial_type);
+        if (factory == _factory_map.end())
+            continue;
+        proxy = factory->second->createProxy(name);
+        if (proxy == NULL)
+            throwException<std::runtime_error>("Cannot create proxy with name: [%s]. Factory returned null.", name.c_str());
+        try
+        {
+            ISerializable* image = dynamic_cast<ISerializable*>(proxy);
+            if (image == NULL || image->getSerialType() != entry.serial_type)
+                throwException<std::runtime_error>("Factory built a proxy not matching its snapshot: [%s].", name.c_str());
+            image->deserialize(data + offset, size);
+        }
+        catch (...)
+        {
+            delete proxy;
+            throw;
+        }
+        model.registerProxy(proxy);
+        ++restored;
+    }
+    return restored;
+}
+
+void ProxySnapshot::fail(char const* reason, std::string const& path)
+{
+    close();
+    throwException<std::runtime_error>("%s: [%s].", reason, path.c_str());
+}
+
+ProxySnapshot::~ProxySnapshot(void)
+{
+    close();
+    for (FactoryMap::iterator result = _factory_map.begin(); result != _factory_map.end(); ++result)
+        delete result->second;
+}
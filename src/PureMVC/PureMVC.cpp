@@ -7,6 +7,9 @@
 //
 
 #include "Common.hpp"
+// STL include
+#include <vector>
+#include <map>
 // 
 #if defined(_WIN32) || defined(_WIN64)
 #include <windows.h>
@@ -27,10 +30,23 @@ extern "C" WINBASEAPI BOOL WINAPI TryEnterCriticalSection(LPCRITICAL_SECTION);
 #include <pthread.h>
 #include <errno.h>
 #include <sys/time.h>
+#include <time.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <stdio.h>
 typedef pthread_mutex_t puremvc_mutex_t;
 typedef pthread_mutex_t puremvc_fast_mutex_t;
 typedef std::pair<pthread_t, std::pair<bool, pthread_cond_t> > puremvc_thread_t;
+struct puremvc_event_t
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    bool auto_reset;
+    bool state;
+};
 #endif
 
 #if defined(__APPLE__)
@@ -261,6 +277,437 @@ FastMutex::~FastMutex(void)
     _mutex = NULL;
 }
 
+Event::Event(bool auto_reset)
+    : _event(NULL)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    _event = ::CreateEvent((LPSECURITY_ATTRIBUTES) 0, auto_reset ? FALSE : TRUE, FALSE, (LPCTSTR) 0);
+    if (!_event)
+        throw std::runtime_error("Cannot create event!");
+#else
+    register int rc;
+    puremvc_event_t* event = new puremvc_event_t();
+    event->auto_reset = auto_reset;
+    event->state = false;
+    if ((rc = ::pthread_mutex_init(&event->mutex, NULL)))
+    {
+        delete event;
+        std::cerr << strerror(rc) << std::endl;
+        throw std::runtime_error("Cannot create event!");
+    }
+    if ((rc = ::pthread_cond_init(&event->cond, NULL)))
+    {
+        ::pthread_mutex_destroy(&event->mutex);
+        delete event;
+        std::cerr << strerror(rc) << std::endl;
+        throw std::runtime_error("Cannot create event!");
+    }
+    _event = event;
+#endif
+}
+
+void Event::set(void)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    if (!::SetEvent(_event))
+        throw std::runtime_error("Cannot signal event!");
+#else
+    puremvc_event_t* event = (puremvc_event_t*)_event;
+    ::pthread_mutex_lock(&event->mutex);
+    event->state = true;
+    register int rc = event->auto_reset
+        ? ::pthread_cond_signal(&event->cond)
+        : ::pthread_cond_broadcast(&event->cond);
+    ::pthread_mutex_unlock(&event->mutex);
+    if (rc)
+    {
+        std::cerr << strerror(rc) << std::endl;
+        throw std::runtime_error("Cannot signal event!");
+    }
+#endif
+}
+
+void Event::reset(void)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    if (!::ResetEvent(_event))
+        throw std::runtime_error("Cannot reset event!");
+#else
+    puremvc_event_t* event = (puremvc_event_t*)_event;
+    ::pthread_mutex_lock(&event->mutex);
+    event->state = false;
+    ::pthread_mutex_unlock(&event->mutex);
+#endif
+}
+
+void Event::wait(void)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    if (::WaitForSingleObject(_event, INFINITE) != WAIT_OBJECT_0)
+        throw std::runtime_error("Cannot wait for event!");
+#else
+    register int rc = 0;
+    puremvc_event_t* event = (puremvc_event_t*)_event;
+    ::pthread_mutex_lock(&event->mutex);
+    while (!event->state && rc == 0)
+        rc = ::pthread_cond_wait(&event->cond, &event->mutex);
+    if (rc == 0 && event->auto_reset)
+        event->state = false;
+    ::pthread_mutex_unlock(&event->mutex);
+    if (rc)
+    {
+        std::cerr << strerror(rc) << std::endl;
+        throw std::runtime_error("Cannot wait for event!");
+    }
+#endif
+}
+
+bool Event::tryWait(long milliseconds)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    switch (::WaitForSingleObject(_event, milliseconds < 0 ? 0 : (DWORD)milliseconds))
+    {
+    case WAIT_TIMEOUT:
+        return false;
+    case WAIT_OBJECT_0:
+        return true;
+    default:
+        throw std::runtime_error("Cannot wait for event!");
+    }
+#else
+    register int rc;
+    struct timespec   ts;
+    struct timeval    tp;
+    if (milliseconds < 0)
+        milliseconds = 0;
+    if ((rc = ::gettimeofday(&tp, NULL)))
+    {
+        std::cerr << strerror(rc) << std::endl;
+        throw std::runtime_error("Cannot calculate time!");
+    }
+
+    ts.tv_sec  = tp.tv_sec + milliseconds / 1000;
+    ts.tv_nsec = tp.tv_usec*1000 + (milliseconds % 1000)*1000000;
+    if (ts.tv_nsec >= 1000000000)
+    {
+        ts.tv_nsec -= 1000000000;
+        ts.tv_sec++;
+    }
+
+    rc = 0;
+    puremvc_event_t* event = (puremvc_event_t*)_event;
+    ::pthread_mutex_lock(&event->mutex);
+    while (!event->state && rc == 0)
+        rc = ::pthread_cond_timedwait(&event->cond, &event->mutex, &ts);
+    bool result = event->state;
+    if (result && event->auto_reset)
+        event->state = false;
+    ::pthread_mutex_unlock(&event->mutex);
+    if (rc && rc != ETIMEDOUT)
+    {
+        std::cerr << strerror(rc) << std::endl;
+        throw std::runtime_error("Cannot wait for event!");
+    }
+    return result;
+#endif
+#if defined(__DMC__)
+    return false;
+#endif
+}
+
+Event::~Event(void)
+{
+    if (_event == NULL) return;
+#if defined(_WIN32) || defined(_WIN64)
+    ::CloseHandle(_event);
+#else
+    puremvc_event_t* event = (puremvc_event_t*)_event;
+    ::pthread_cond_destroy(&event->cond);
+    ::pthread_mutex_destroy(&event->mutex);
+    delete event;
+#endif
+    _event = NULL;
+}
+
+#if !defined(_WIN32) && !defined(_WIN64) && !(defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 1)))
+#define PUREMVC_USES_ATOMIC_MUTEX
+static FastMutex& getAtomicMutex(void)
+{
+    static FastMutex mutex;
+    return mutex;
+}
+#endif
+
+long PureMVC::atomicIncrement(long volatile* value)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    return ::InterlockedIncrement(value);
+#elif defined(PUREMVC_USES_ATOMIC_MUTEX)
+    FastMutex::ScopedLock _(getAtomicMutex());
+    return ++(*value);
+#else
+    return __sync_add_and_fetch(value, 1L);
+#endif
+}
+
+long PureMVC::atomicDecrement(long volatile* value)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    return ::InterlockedDecrement(value);
+#elif defined(PUREMVC_USES_ATOMIC_MUTEX)
+    FastMutex::ScopedLock _(getAtomicMutex());
+    return --(*value);
+#else
+    return __sync_sub_and_fetch(value, 1L);
+#endif
+}
+
+long PureMVC::atomicExchange(long volatile* value, long exchange)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    return ::InterlockedExchange(value, exchange);
+#elif defined(PUREMVC_USES_ATOMIC_MUTEX)
+    FastMutex::ScopedLock _(getAtomicMutex());
+    long result = *value;
+    *value = exchange;
+    return result;
+#else
+    // __sync_lock_test_and_set is only an acquire barrier
+    long result = *value;
+    long current;
+    while ((current = __sync_val_compare_and_swap(value, result, exchange)) != result)
+        result = current;
+    return result;
+#endif
+}
+
+long PureMVC::atomicCompareExchange(long volatile* value, long exchange, long comparand)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    return ::InterlockedCompareExchange(value, exchange, comparand);
+#elif defined(PUREMVC_USES_ATOMIC_MUTEX)
+    FastMutex::ScopedLock _(getAtomicMutex());
+    long result = *value;
+    if (result == comparand)
+        *value = exchange;
+    return result;
+#else
+    return __sync_val_compare_and_swap(value, comparand, exchange);
+#endif
+}
+
+long PureMVC::atomicLoad(long volatile const* value)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    return ::InterlockedCompareExchange(const_cast<long volatile*>(value), 0, 0);
+#elif defined(PUREMVC_USES_ATOMIC_MUTEX)
+    FastMutex::ScopedLock _(getAtomicMutex());
+    return *value;
+#else
+    // A plain read between barriers, without taking the cache line exclusively.
+    __sync_synchronize();
+    long result = *value;
+    __sync_synchronize();
+    return result;
+#endif
+}
+
+void* PureMVC::atomicExchangePointer(void* volatile* value, void* exchange)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    return ::InterlockedExchangePointer(value, exchange);
+#elif defined(PUREMVC_USES_ATOMIC_MUTEX)
+    FastMutex::ScopedLock _(getAtomicMutex());
+    void* result = *value;
+    *value = exchange;
+    return result;
+#else
+    void* result = *value;
+    void* current;
+    while ((current = __sync_val_compare_and_swap(value, result, exchange)) != result)
+        result = current;
+    return result;
+#endif
+}
+
+void* PureMVC::atomicCompareExchangePointer(void* volatile* value, void* exchange, void* comparand)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    return ::InterlockedCompareExchangePointer(value, exchange, comparand);
+#elif defined(PUREMVC_USES_ATOMIC_MUTEX)
+    FastMutex::ScopedLock _(getAtomicMutex());
+    void* result = *value;
+    if (result == comparand)
+        *value = exchange;
+    return result;
+#else
+    return __sync_val_compare_and_swap(value, comparand, exchange);
+#endif
+}
+
+void* PureMVC::atomicLoadPointer(void* volatile const* value)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    return ::InterlockedCompareExchangePointer(const_cast<void* volatile*>(value), NULL, NULL);
+#elif defined(PUREMVC_USES_ATOMIC_MUTEX)
+    FastMutex::ScopedLock _(getAtomicMutex());
+    return *value;
+#else
+    __sync_synchronize();
+    void* result = *value;
+    __sync_synchronize();
+    return result;
+#endif
+}
+
+MemoryMappedFile::MemoryMappedFile(void)
+    : _data(NULL)
+    , _size(0)
+{ }
+
+MemoryMappedFile::MemoryMappedFile(std::string const& path)
+    : _data(NULL)
+    , _size(0)
+{
+    open(path);
+}
+
+void MemoryMappedFile::open(std::string const& path)
+{
+    close();
+#if defined(_WIN32) || defined(_WIN64)
+    HANDLE file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        throwException<std::runtime_error>("Cannot open file: [%s].", path.c_str());
+    DWORD high = 0;
+    DWORD low = ::GetFileSize(file, &high);
+    unsigned __int64 size = ((unsigned __int64)high << 32) | low;
+    if ((std::size_t)size != size)
+    {
+        ::CloseHandle(file);
+        throwException<std::runtime_error>("File is too large to be mapped: [%s].", path.c_str());
+    }
+    if (size == 0)
+    {
+        ::CloseHandle(file);
+        throwException<std::runtime_error>("Cannot map empty file: [%s].", path.c_str());
+    }
+    HANDLE mapping = ::CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    ::CloseHandle(file);
+    if (mapping == NULL)
+        throwException<std::runtime_error>("Cannot map file: [%s].", path.c_str());
+    // The view keeps the mapping alive.
+    void* data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    ::CloseHandle(mapping);
+    if (data == NULL)
+        throwException<std::runtime_error>("Cannot map file: [%s].", path.c_str());
+#else
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file == -1)
+        throwException<std::runtime_error>("Cannot open file: [%s].", path.c_str());
+    struct stat status;
+    if (::fstat(file, &status) == -1)
+    {
+        ::close(file);
+        throwException<std::runtime_error>("Cannot get size of file: [%s].", path.c_str());
+    }
+    std::size_t size = (std::size_t)status.st_size;
+    if ((off_t)size != status.st_size)
+    {
+        ::close(file);
+        throwException<std::runtime_error>("File is too large to be mapped: [%s].", path.c_str());
+    }
+    if (size == 0)
+    {
+        ::close(file);
+        throwException<std::runtime_error>("Cannot map empty file: [%s].", path.c_str());
+    }
+    // The mapping stays valid after the descriptor is closed.
+    void* data = ::mmap(NULL, size, PROT_READ, MAP_SHARED, file, 0);
+    ::close(file);
+    if (data == MAP_FAILED)
+        throwException<std::runtime_error>("Cannot map file: [%s].", path.c_str());
+#endif
+    _data = data;
+    _size = (std::size_t)size;
+}
+
+void MemoryMappedFile::close(void)
+{
+    if (_data != NULL)
+    {
+#if defined(_WIN32) || defined(_WIN64)
+        ::UnmapViewOfFile(_data);
+#else
+        ::munmap(const_cast<void*>(_data), _size);
+#endif
+    }
+    _data = NULL;
+    _size = 0;
+}
+
+bool MemoryMappedFile::isOpen(void) const
+{
+    return _data != NULL;
+}
+
+void const* MemoryMappedFile::getData(void) const
+{
+    return _data;
+}
+
+std::size_t MemoryMappedFile::getSize(void) const
+{
+    return _size;
+}
+
+MemoryMappedFile::~MemoryMappedFile(void)
+{
+    close();
+}
+
+bool PureMVC::replaceFile(std::string const& source, std::string const& target)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    return ::MoveFileExA(source.c_str(), target.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return ::rename(source.c_str(), target.c_str()) == 0;
+#endif
+}
+
+bool PureMVC::listFiles(std::string const& directory, std::vector<std::string>& names)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    std::string pattern = directory;
+    if (!pattern.empty() && pattern[pattern.size() - 1] != '\\' && pattern[pattern.size() - 1] != '/')
+        pattern += '\\';
+    pattern += '*';
+    WIN32_FIND_DATAA data;
+    HANDLE find = ::FindFirstFileA(pattern.c_str(), &data);
+    if (find == INVALID_HANDLE_VALUE)
+        return ::GetLastError() == ERROR_FILE_NOT_FOUND;
+    do
+    {
+        if (!(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+            names.push_back(data.cFileName);
+    } while (::FindNextFileA(find, &data));
+    ::FindClose(find);
+    return true;
+#else
+    DIR* dir = ::opendir(directory.empty() ? "." : directory.c_str());
+    if (dir == NULL)
+        return false;
+    struct dirent* entry;
+    while ((entry = ::readdir(dir)) != NULL)
+    {
+        if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0)
+            names.push_back(entry->d_name);
+    }
+    ::closedir(dir);
+    return true;
+#endif
+}
+
 Thread::Thread(ICommand& command)
     : _auto_destroy(false)
     , _command(&command)
@@ -650,8 +1097,539 @@ Thread::~Thread(void)
     _command = NULL;
 }
 
+namespace
+{
+    enum
+    {
+        TIMER_WHEEL_BITS = 8,
+        TIMER_WHEEL_SIZE = 1 << TIMER_WHEEL_BITS,
+        TIMER_WHEEL_MASK = TIMER_WHEEL_SIZE - 1,
+        TIMER_WHEEL_LEVELS = 4,
+        TIMER_CHUNK_BITS = 10,
+        TIMER_CHUNK_SIZE = 1 << TIMER_CHUNK_BITS,
+        TIMER_INDEX_BITS = 22
+    };
+
+    enum
+    {
+        TIMER_FREE,
+        TIMER_QUEUED,
+        TIMER_EXECUTING,
+        TIMER_CANCELLED
+    };
+
+    // Entries are pooled in chunks and linked into the slots of the wheel.
+    struct puremvc_timer_entry_t
+    {
+        puremvc_timer_entry_t* next;
+        puremvc_timer_entry_t* prev;
+        puremvc_timer_entry_t* command_next;
+        puremvc_timer_entry_t* command_prev;
+        unsigned long index;
+        unsigned long generation;
+        unsigned long expires;
+        long period;
+        ICommand* command;
+        INotification const* notification;
+        int state;
+    };
+
+    // Hierarchical hashed timer wheel: level n holds the timers expiring
+    // within 2^(8 * (n + 1)) ticks of one millisecond. Insert and cancel are
+    // O(1), a timer is moved down a level when its slot comes round. The
+    // thread sleeps until the next occupied slot, or until a schedule when
+    // no timer is pending.
+    class TimerService : public SimpleCommand
+    {
+    public:
+        typedef std::map<ICommand const*, puremvc_timer_entry_t*> CommandMap;
+    public:
+        mutable FastMutex mutex;
+        puremvc_timer_entry_t slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SIZE];
+        std::vector<puremvc_timer_entry_t*> chunks;
+        CommandMap commands;
+        puremvc_timer_entry_t* free_list;
+        puremvc_timer_entry_t* executing;
+        std::size_t pending;
+        unsigned long current;
+        unsigned long epoch;
+        unsigned long deadline;
+        bool sleeping;
+        bool forever;
+        bool volatile running;
+        Event wakeup;
+        Event executed;
+        std::string thread_id;
+        Thread* thread;
+        Notification start_notification;
+    public:
+        TimerService(void)
+            : INotifier()
+            , ICommand()
+            , SimpleCommand()
+            , free_list(NULL)
+            , executing(NULL)
+            , pending(0)
+            , current(0)
+            , epoch(Timer::getTickCount())
+            , deadline(0)
+            , sleeping(false)
+            , forever(false)
+            , running(false)
+            , wakeup(true)
+            , executed(false)
+            , thread(NULL)
+            , start_notification("")
+        {
+            for (int level = 0; level < TIMER_WHEEL_LEVELS; ++level)
+            {
+                for (int i = 0; i < TIMER_WHEEL_SIZE; ++i)
+                    slots[level][i].next = slots[level][i].prev = &slots[level][i];
+            }
+            executed.set();
+        }
+
+        unsigned long now(void) const
+        {
+            return Timer::getTickCount() - epoch;
+        }
+
+        static Timer::TimerId getId(puremvc_timer_entry_t const* entry)
+        {
+            return (entry->generation << TIMER_INDEX_BITS) | entry->index;
+        }
+
+        puremvc_timer_entry_t* find(Timer::TimerId timer_id) const
+        {
+            unsigned long index = timer_id & ((1UL << TIMER_INDEX_BITS) - 1);
+            if ((index >> TIMER_CHUNK_BITS) >= chunks.size())
+                return NULL;
+            puremvc_timer_entry_t* entry = &chunks[index >> TIMER_CHUNK_BITS][index & (TIMER_CHUNK_SIZE - 1)];
+            if (entry->state == TIMER_FREE || getId(entry) != timer_id)
+                return NULL;
+            return entry;
+        }
+
+        puremvc_timer_entry_t* allocate(void)
+        {
+            if (free_list == NULL)
+            {
+                unsigned long first = (unsigned long)chunks.size() << TIMER_CHUNK_BITS;
+                if (first + TIMER_CHUNK_SIZE > (1UL << TIMER_INDEX_BITS))
+                    throw std::runtime_error("Too many pending timers.");
+                puremvc_timer_entry_t* chunk = new puremvc_timer_entry_t[TIMER_CHUNK_SIZE];
+                chunks.push_back(chunk);
+                for (int i = TIMER_CHUNK_SIZE - 1; i >= 0; --i)
+                {
+                    chunk[i].index = first + i;
+                    chunk[i].generation = 0;
+                    chunk[i].state = TIMER_FREE;
+                    chunk[i].next = free_list;
+                    free_list = &chunk[i];
+                }
+            }
+            puremvc_timer_entry_t* entry = free_list;
+            free_list = entry->next;
+            // The generation tells a recycled entry from the timer it replaced.
+            entry->generation = (entry->generation + 1) & (~0UL >> TIMER_INDEX_BITS);
+            if (entry->generation == 0)
+                entry->generation = 1;
+            return entry;
+        }
+
+        // Links the entry into the timers of its command, for cancelAll.
+        void attach(puremvc_timer_entry_t* entry)
+        {
+            puremvc_timer_entry_t*& head = commands[entry->command];
+            entry->command_prev = NULL;
+            entry->command_next = head;
+            if (head != NULL)
+                head->command_prev = entry;
+            head = entry;
+        }
+
+        void detach(puremvc_timer_entry_t* entry)
+        {
+            if (entry->command_next != NULL)
+                entry->command_next->command_prev = entry->command_prev;
+            if (entry->command_prev != NULL)
+                entry->command_prev->command_next = entry->command_next;
+            else if (entry->command_next != NULL)
+                commands[entry->command] = entry->command_next;
+            else
+                commands.erase(entry->command);
+        }
+
+        void release(puremvc_timer_entry_t* entry)
+        {
+            detach(entry);
+            delete entry->notification;
+            entry->notification = NULL;
+            entry->command = NULL;
+            entry->state = TIMER_FREE;
+            entry->next = free_list;
+            free_list = entry;
+        }
+
+        void link(puremvc_timer_entry_t* entry)
+        {
+            unsigned long delta = entry->expires - current;
+            puremvc_timer_entry_t* head;
+            if (delta < (1UL << TIMER_WHEEL_BITS))
+                head = &slots[0][entry->expires & TIMER_WHEEL_MASK];
+            else if (delta < (1UL << (2 * TIMER_WHEEL_BITS)))
+                head = &slots[1][(entry->expires >> TIMER_WHEEL_BITS) & TIMER_WHEEL_MASK];
+            else if (delta < (1UL << (3 * TIMER_WHEEL_BITS)))
+                head = &slots[2][(entry->expires >> (2 * TIMER_WHEEL_BITS)) & TIMER_WHEEL_MASK];
+            else
+                head = &slots[3][(entry->expires >> (3 * TIMER_WHEEL_BITS)) & TIMER_WHEEL_MASK];
+            entry->prev = head->prev;
+            entry->next = head;
+            head->prev->next = entry;
+            head->prev = entry;
+            entry->state = TIMER_QUEUED;
+        }
+
+        static void unlink(puremvc_timer_entry_t* entry)
+        {
+            entry->prev->next = entry->next;
+            entry->next->prev = entry->prev;
+            entry->next = entry->prev = NULL;
+        }
+
+        void schedule(puremvc_timer_entry_t* entry, unsigned long delay)
+        {
+            if (delay == 0)
+                delay = 1;
+            // Delays are limited to one revolution of the last level.
+            if (delay > 0xFFFFFFFFUL)
+                delay = 0xFFFFFFFFUL;
+            // an empty wheel is not ticked while the thread sleeps
+            unsigned long target = now();
+            if (pending == 0 && executing == NULL && (long)(target - current) > 0)
+                current = target;
+            entry->expires = target + delay;
+            if ((long)(entry->expires - current) <= 0)
+                entry->expires = current + 1;
+            link(entry);
+            // wake the thread if it sleeps past the new timer
+            if (sleeping && (forever || (long)(entry->expires - deadline) < 0))
+            {
+                sleeping = false;
+                wakeup.set();
+            }
+        }
+
+        // Ticks to the next occupied slot of the first level, or to the next
+        // cascade from the other levels.
+        unsigned long getNextDelay(void) const
+        {
+            unsigned long delay = 1;
+            for (; delay < TIMER_WHEEL_SIZE; ++delay)
+            {
+                unsigned long position = (current + delay) & TIMER_WHEEL_MASK;
+                if (position == 0 || slots[0][position].next != &slots[0][position])
+                    break;
+            }
+            return delay;
+        }
+
+        void stop(void)
+        {
+            running = false;
+            wakeup.set();
+        }
+
+        void cascade(int level)
+        {
+            puremvc_timer_entry_t* head = &slots[level][(current >> (level * TIMER_WHEEL_BITS)) & TIMER_WHEEL_MASK];
+            puremvc_timer_entry_t* entry = head->next;
+            head->next = head->prev = head;
+            while (entry != head)
+            {
+                puremvc_timer_entry_t* next = entry->next;
+                link(entry);
+                entry = next;
+            }
+        }
+
+        // Called with the mutex locked, unlocks it while executing commands.
+        void tick(void)
+        {
+            ++current;
+            for (int level = 1; level < TIMER_WHEEL_LEVELS; ++level)
+            {
+                if (((current >> ((level - 1) * TIMER_WHEEL_BITS)) & TIMER_WHEEL_MASK) != 0)
+                    break;
+                cascade(level);
+            }
+
+            puremvc_timer_entry_t* head = &slots[0][current & TIMER_WHEEL_MASK];
+            while (head->next != head)
+            {
+                puremvc_timer_entry_t* entry = head->next;
+                unlink(entry);
+                entry->state = TIMER_EXECUTING;
+                executing = entry;
+                executed.reset();
+
+                mutex.unlock();
+                try
+                {
+                    entry->command->execute(*entry->notification);
+                }
+                catch(std::exception const& ex)
+                {
+                    std::cerr << ex.what() << std::endl;
+                }
+                catch(...)
+                {
+                    std::cerr << "Cannot handle exception from timer." << std::endl;
+                }
+                mutex.lock();
+
+                executing = NULL;
+                executed.set();
+                if (entry->state == TIMER_CANCELLED)
+                    release(entry);
+                else if (entry->period <= 0)
+                {
+                    --pending;
+                    release(entry);
+                }
+                else
+                {
+                    entry->expires = current + (unsigned long)entry->period;
+                    link(entry);
+                }
+            }
+        }
+
+        bool cancel(puremvc_timer_entry_t* entry)
+        {
+            if (entry->state == TIMER_QUEUED)
+            {
+                unlink(entry);
+                release(entry);
+                --pending;
+                return true;
+            }
+            if (entry->state != TIMER_EXECUTING)
+                return false;
+
+            // Being executed, the timer thread releases it.
+            entry->state = TIMER_CANCELLED;
+            --pending;
+            if (thread_id != Thread::getCurrentThreadId())
+            {
+                // the timer thread signals the end of every execution
+                while (executing == entry)
+                {
+                    mutex.unlock();
+                    executed.wait();
+                    mutex.lock();
+                }
+            }
+            return true;
+        }
+
+        virtual void execute(INotification const&)
+        {
+            FastMutex::ScopedLock lock(mutex);
+            thread_id = Thread::getCurrentThreadId();
+
+            while (running)
+            {
+                unsigned long target = now();
+                while (running && (long)(target - current) > 0)
+                {
+                    if (pending == 0)
+                    {
+                        current = target;
+                        break;
+                    }
+                    tick();
+                }
+                if (!running)
+                    break;
+
+                long delay = 0;
+                forever = pending == 0;
+                if (!forever)
+                {
+                    deadline = current + getNextDelay();
+                    delay = (long)(deadline - now());
+                    if (delay <= 0)
+                        continue;
+                }
+                sleeping = true;
+                mutex.unlock();
+                if (forever)
+                    wakeup.wait();
+                else
+                    wakeup.tryWait(delay);
+                mutex.lock();
+                sleeping = false;
+            }
+        }
+
+        ~TimerService(void)
+        {
+            std::vector<puremvc_timer_entry_t*>::iterator result = chunks.begin();
+            for (; result != chunks.end(); ++result)
+            {
+                for (int i = 0; i < TIMER_CHUNK_SIZE; ++i)
+                    delete (*result)[i].notification;
+                delete[] *result;
+            }
+        }
+    };
+}
+
+namespace
+{
+    // Never destroyed: cores removed during static destruction still cancel their timers.
+    void* volatile puremvc_timer_instance = NULL;
+    TimerService* volatile puremvc_timer_service = NULL;
+
+    // Defined after the instance maps, so it stops the timer thread before they are cleaned.
+    struct TimerShutdown
+    {
+        ~TimerShutdown(void)
+        {
+            TimerService* service = puremvc_timer_service;
+            if (service == NULL || service->thread == NULL)
+                return;
+            service->stop();
+            service->thread->join();
+            FastMutex::ScopedLock lock(service->mutex);
+            delete service->thread;
+            service->thread = NULL;
+        }
+    } puremvc_timer_shutdown;
+}
+
+Timer::Timer(void)
+    : _timer_handler(new TimerService())
+{ }
+
+Timer& Timer::getInstance(void)
+{
+    if (puremvc_timer_instance == NULL)
+    {
+        Timer* instance = new Timer();
+        if (atomicCompareExchangePointer(&puremvc_timer_instance, instance, NULL) != NULL)
+            delete instance;
+        else
+            puremvc_timer_service = (TimerService*)instance->_timer_handler;
+    }
+    return *(Timer*)puremvc_timer_instance;
+}
+
+unsigned long Timer::getTickCount(void)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    return (unsigned long)::GetTickCount();
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long)ts.tv_sec * 1000UL + (unsigned long)(ts.tv_nsec / 1000000);
+#else
+    struct timeval tv;
+    ::gettimeofday(&tv, NULL);
+    return (unsigned long)tv.tv_sec * 1000UL + (unsigned long)(tv.tv_usec / 1000);
+#endif
+}
+
+Timer::TimerId Timer::schedule(ICommand& command, INotification const* destroyable_notification, long delay, long period)
+{
+    if (destroyable_notification == NULL)
+        throw std::runtime_error("Notification parameter is null.");
+
+    TimerService* service = (TimerService*)_timer_handler;
+    FastMutex::ScopedLock lock(service->mutex);
+
+    puremvc_timer_entry_t* entry = service->allocate();
+    entry->command = &command;
+    entry->notification = destroyable_notification;
+    entry->period = period;
+    service->attach(entry);
+    service->schedule(entry, (unsigned long)(delay < 0 ? 0 : delay));
+    ++service->pending;
+
+    if (service->thread == NULL)
+    {
+        service->running = true;
+        service->thread = new Thread(*service);
+        service->thread->start(service->start_notification);
+    }
+    return TimerService::getId(entry);
+}
+
+bool Timer::cancel(TimerId timer_id)
+{
+    TimerService* service = (TimerService*)_timer_handler;
+    FastMutex::ScopedLock lock(service->mutex);
+
+    puremvc_timer_entry_t* entry = service->find(timer_id);
+    if (entry == NULL)
+        return false;
+    return service->cancel(entry);
+}
+
+std::size_t Timer::cancelAll(ICommand const& command)
+{
+    TimerService* service = (TimerService*)_timer_handler;
+    FastMutex::ScopedLock lock(service->mutex);
+
+    TimerService::CommandMap::iterator result = service->commands.find(&command);
+    if (result == service->commands.end())
+        return 0;
+    // cancelling an executing timer unlocks the mutex, the list may change meanwhile
+    std::vector<Timer::TimerId> timer_ids;
+    for (puremvc_timer_entry_t* entry = result->second; entry != NULL; entry = entry->command_next)
+        timer_ids.push_back(TimerService::getId(entry));
+
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < timer_ids.size(); ++i)
+    {
+        puremvc_timer_entry_t* entry = service->find(timer_ids[i]);
+        if (entry != NULL && service->cancel(entry))
+            ++count;
+    }
+    return count;
+}
+
+std::size_t Timer::getPendingCount(void) const
+{
+    TimerService* service = (TimerService*)_timer_handler;
+    FastMutex::ScopedLock lock(service->mutex);
+    return service->pending;
+}
+
+Timer::~Timer(void)
+{
+    TimerService* service = (TimerService*)_timer_handler;
+    if (service->thread != NULL)
+    {
+        service->stop();
+        service->thread->join();
+        delete service->thread;
+        service->thread = NULL;
+    }
+    delete service;
+    _timer_handler = NULL;
+}
+
+std::string const* IMediator::getNotificationInterests(std::size_t& count) const
+{
+    count = 0;
+    return NULL;
+}
+
 ICommand::~ICommand(void) { }
 IController::~IController(void) { }
+IEvictable::~IEvictable(void) { }
 IFacade::~IFacade(void) { }
 IMediator::~IMediator(void) { }
 IModel::~IModel(void) { }
@@ -659,6 +1637,8 @@ INotification::~INotification(void) { }
 INotifier::~INotifier(void) { }
 IObserver::~IObserver(void) { }
 IProxy::~IProxy(void) { }
+IProxyFactory::~IProxyFactory(void) { }
+ISerializable::~ISerializable(void) { }
 IView::~IView(void) { }
 
 #if defined (PURE_MVC_CREATE_CACHE)
@@ -11,6 +11,8 @@
 #pragma warning( disable : 4355 ) // The this pointer is valid only within nonstatic member functions. It cannot be used in the initializer list for a base class.ck(16)
 #endif
 
+#include <vector>
+#include <algorithm>
 #include <tut/tut.hpp>
 #include <tut_reporter.h>
 #include <PureMVC/PureMVC.hpp>
@@ -19,6 +21,9 @@
 #include "ControllerTestCommand.hpp"
 #include "ControllerTestCommand2.hpp"
 #include "ControllerTestVO.hpp"
+#include "ControllerTestPooledCommand.hpp"
+#include "ControllerTestCoroutineCommand.hpp"
+#include "ControllerTestCachedCommand.hpp"
 
 namespace data
 {
@@ -28,6 +33,14 @@ namespace data
     };
 }
 
+long volatile data::ControllerTestPooledCommand::instances = 0;
+long volatile data::ControllerTestBusyCommand::instances = 0;
+long volatile data::ControllerTestBusyCommand::shared = 0;
+#if defined(PUREMVC_USES_COROUTINE)
+long volatile data::ControllerTestFrameGuard::destroyed = 0;
+std::string const data::ControllerTestResendMediator::INTERESTS[1] = { "ControllerCoroutineAgain" };
+#endif
+
 namespace testgroup
 {
     typedef tut::test_group<data::ControllerTest> controller_test_t;
@@ -42,6 +55,7 @@ namespace tut
     using PureMVC::Thread;
     using PureMVC::Interfaces::IController;
     using PureMVC::Interfaces::INotification;
+    using PureMVC::Interfaces::ICommand;
     using PureMVC::Interfaces::IView;
     using PureMVC::Interfaces::IIterator;
     using PureMVC::Interfaces::IAggregate;
@@ -51,6 +65,12 @@ namespace tut
     using PureMVC::Patterns::Notification;
     using PureMVC::Patterns::DelegateCommand;
     using PureMVC::Patterns::createCommand;
+    using PureMVC::Patterns::createPooledCommand;
+    using PureMVC::Patterns::createCachedCommand;
+    using PureMVC::Patterns::createObserver;
+    using PureMVC::Patterns::CachedCommand;
+    using PureMVC::Patterns::Facade;
+    using PureMVC::Interfaces::IFacade;
 
     template<> template<>
     void object::test<1>(void)
@@ -301,19 +321,15 @@ namespace tut
 
             // Reset again iterator
             iterator->reset();
-            // Move next to counter item
-            ensure("Expecting iterator->moveNext() == true", iterator->moveNext());
-#if !defined(PUREMVC_USES_TR1)
-            ensure_equals("Expecting iterator->getCurrent() == ControllerTestKey6_2", iterator->getCurrent(), "ControllerTestKey6_2");
-#endif
-            ensure("Expecting iterator->moveNext() == true", iterator->moveNext());
-#if !defined(PUREMVC_USES_TR1)
-            ensure_equals( "Expecting iterator->getCurrent() == ControllerTestKey6_4", iterator->getCurrent(), "ControllerTestKey6_4");
-#endif
-            ensure("Expecting iterator->moveNext() == true", iterator->moveNext());
-#if !defined(PUREMVC_USES_TR1)
-            ensure_equals( "Expecting iterator->getCurrent() == ControllerTestKey6_5", iterator->getCurrent(), "ControllerTestKey6_5");
-#endif
+            // The names are hashed, collect them in order
+            std::vector<std::string> names;
+            while(iterator->moveNext())
+                names.push_back(iterator->getCurrent());
+            std::sort(names.begin(), names.end());
+            ensure_equals("Expecting 3 names", names.size(), (std::size_t)3);
+            ensure_equals("Expecting names[0] == ControllerTestKey6_2", names[0], "ControllerTestKey6_2");
+            ensure_equals("Expecting names[1] == ControllerTestKey6_4", names[1], "ControllerTestKey6_4");
+            ensure_equals("Expecting names[2] == ControllerTestKey6_5", names[2], "ControllerTestKey6_5");
             ensure("Expecting iterator->moveNext() == false", iterator->moveNext() == false);
         
             bool bool_exception = false;
@@ -387,4 +403,233 @@ namespace tut
             iter = threads.begin();
         }
     }
+
+    template<> template<>
+    void object::test<9>(void)
+    {
+        do
+        {
+            PureMVC::FastMutex::ScopedLock _(_mutex);
+            set_test_name("testRegisterAndExecutePooledCommand");
+        }while (false);
+
+        IController& controller = Controller::getInstance("ControllerTestKey9");
+
+        ICommand* pooled = createPooledCommand<data::ControllerTestPooledCommand>(4);
+        controller.registerCommand("ControllerPooledTest", pooled);
+
+        ensure_equals("Expecting no instance before first execution", data::ControllerTestPooledCommand::instances, 0L);
+
+        for (int i = 0; i < 10; ++i)
+        {
+            data::ControllerTestVO vo(i);
+            Notification note("ControllerPooledTest", &vo);
+            controller.executeCommand(note);
+            ensure_equals("Expecting vo.result == 2 * vo.input", vo.result, 2 * i);
+        }
+
+        // sequential executions reuse the same pooled instance
+        ensure_equals("Expecting one pooled instance", data::ControllerTestPooledCommand::instances, 1L);
+
+        controller.removeCommand("ControllerPooledTest");
+        delete pooled;
+
+        ensure_equals("Expecting pooled instances destroyed", data::ControllerTestPooledCommand::instances, 0L);
+
+        data::ControllerTestPooledCommand prototype(3);
+        pooled = createPooledCommand(prototype);
+        controller.registerCommand("ControllerPooledTest", pooled);
+
+        data::ControllerTestVO vo(5);
+        Notification note("ControllerPooledTest", &vo);
+        controller.executeCommand(note);
+        ensure_equals("Expecting vo.result == 15", vo.result, 15);
+
+        controller.removeCommand("ControllerPooledTest");
+        delete pooled;
+    }
+
+#if defined(PUREMVC_USES_COROUTINE)
+    template<> template<>
+    void object::test<10>(void)
+    {
+        do
+        {
+            PureMVC::FastMutex::ScopedLock _(_mutex);
+            set_test_name("testCoroutineCommandResumesOnNotification");
+        }while (false);
+
+        IController& controller = Controller::getInstance("ControllerTestKey10");
+        IView& view = View::getInstance("ControllerTestKey10");
+
+        ICommand* command = new data::ControllerTestCoroutineCommand();
+        controller.registerCommand("ControllerCoroutineTest", command);
+
+        data::ControllerTestVO vo(4);
+        view.notifyObservers(Notification("ControllerCoroutineTest", &vo));
+        ensure_equals("Expecting vo.result == 4", vo.result, 4);
+
+        int three = 3;
+        view.notifyObservers(Notification("ControllerCoroutineNext", &three));
+        ensure_equals("Expecting vo.result == 7", vo.result, 7);
+
+        int two = 2;
+        view.notifyObservers(Notification("ControllerCoroutineNext", &two));
+        ensure_equals("Expecting vo.result == 14", vo.result, 14);
+
+        // the coroutine completed, its observer is gone
+        view.notifyObservers(Notification("ControllerCoroutineNext", &two));
+        ensure_equals("Expecting vo.result == 14", vo.result, 14);
+
+        controller.removeCommand("ControllerCoroutineTest");
+        delete command;
+    }
+#endif
+
+    template<> template<>
+    void object::test<11>(void)
+    {
+        do
+        {
+            PureMVC::FastMutex::ScopedLock _(_mutex);
+            set_test_name("testCachedCommandSkipsRepeatedComputation");
+        }while (false);
+
+        typedef CachedCommand<data::ControllerTestCacheKey, data::ControllerTestCacheCompute> cached_command_t;
+
+        IFacade& facade = Facade::getInstance("ControllerTestKey11");
+        IController& controller = Controller::getInstance("ControllerTestKey11");
+        IView& view = View::getInstance("ControllerTestKey11");
+
+        int calls = 0;
+        data::ControllerTestCacheResult result;
+        view.registerObserver("ControllerCachedResult", createObserver(&data::ControllerTestCacheResult::handleResult, &result));
+
+        ICommand* command = createCachedCommand(data::ControllerTestCacheKey(), data::ControllerTestCacheCompute(&calls), "ControllerCachedResult", "", 2);
+        controller.registerCommand("ControllerCachedTest", command);
+
+        int inputs[] = { 3, 3, 4, 5, 3 };
+        int expected_calls[] = { 1, 1, 2, 3, 4 };
+        for (int i = 0; i < 5; ++i)
+        {
+            data::ControllerTestVO vo(inputs[i]);
+            facade.sendNotification("ControllerCachedTest", &vo);
+            ensure_equals("Expecting result == input * input", result.last, inputs[i] * inputs[i]);
+            ensure_equals("Expecting result count == i + 1", result.count, i + 1);
+            ensure_equals("Expecting computation skipped on hit", calls, expected_calls[i]);
+        }
+
+        cached_command_t* cached = dynamic_cast<cached_command_t*>(command);
+        ensure("Expecting command is a CachedCommand", cached != NULL);
+        ensure_equals("Expecting one hit", cached->getHitCount(), (std::size_t)1);
+        ensure_equals("Expecting four misses", cached->getMissCount(), (std::size_t)4);
+        ensure_equals("Expecting cache bounded to 2", cached->getSize(), (std::size_t)2);
+
+        controller.removeCommand("ControllerCachedTest");
+        view.removeObserver("ControllerCachedResult", &result);
+        delete command;
+        Facade::removeCore("ControllerTestKey11");
+    }
+
+    template<> template<>
+    void object::test<12>(void)
+    {
+        set_test_name("testTryRetrieveCommand");
+
+        static data::ControllerTestCommand command;
+        IController& controller = Controller::getInstance("ControllerTestKey12");
+
+        controller.registerCommand("ControllerTryRetrieveTest", &command);
+
+        ensure("Expecting controller.tryRetrieveCommand('ControllerTryRetrieveTest') == &command",
+               controller.tryRetrieveCommand("ControllerTryRetrieveTest") == &command);
+        IController const& const_controller = controller;
+        ensure("Expecting const controller.tryRetrieveCommand('ControllerTryRetrieveTest') == &command",
+               const_controller.tryRetrieveCommand("ControllerTryRetrieveTest") == &command);
+        ensure("Expecting controller.tryRetrieveCommand('Unknown') == NULL",
+               controller.tryRetrieveCommand("Unknown") == NULL);
+
+        controller.removeCommand("ControllerTryRetrieveTest");
+        ensure("Expecting controller.tryRetrieveCommand('ControllerTryRetrieveTest') == NULL after removal",
+               controller.tryRetrieveCommand("ControllerTryRetrieveTest") == NULL);
+    }
+
+    template<> template<>
+    void object::test<13>(void)
+    {
+        set_test_name("testConcurrentPooledCommand");
+
+        struct Action {
+            static void execute(INotification const& notification) {
+                IController& controller = *(IController*)notification.getBody();
+                Notification note("ControllerPooledBusyTest");
+                for (int i = 0; i < 50; ++i)
+                    controller.executeCommand(note);
+            }
+        };
+
+        IController& controller = Controller::getInstance("ControllerTestKey13");
+        ICommand* pooled = createPooledCommand<data::ControllerTestBusyCommand>(4);
+        controller.registerCommand("ControllerPooledBusyTest", pooled);
+
+        typedef std::list<Thread*> thread_list_t;
+        thread_list_t threads;
+        for (std::size_t i = 0; i < 8; ++i)
+            threads.push_back(new Thread(createCommand(Action::execute)));
+
+        // 8 threads on 4 slots, the others run temporary instances
+        Notification notification("IController", &controller);
+        thread_list_t::iterator iter = threads.begin();
+        for (; iter != threads.end(); ++iter)
+            (*iter)->start(notification);
+        for (iter = threads.begin(); iter != threads.end(); ++iter)
+        {
+            (*iter)->join();
+            delete *iter;
+        }
+
+        ensure_equals("Expecting no instance executed by two threads at once", data::ControllerTestBusyCommand::shared, 0L);
+        ensure("Expecting at most 4 pooled instances kept", data::ControllerTestBusyCommand::instances <= 4L);
+
+        controller.removeCommand("ControllerPooledBusyTest");
+        delete pooled;
+        ensure_equals("Expecting pooled instances destroyed", data::ControllerTestBusyCommand::instances, 0L);
+    }
+
+#if defined(PUREMVC_USES_COROUTINE)
+    template<> template<>
+    void object::test<14>(void)
+    {
+        do
+        {
+            PureMVC::FastMutex::ScopedLock _(_mutex);
+            set_test_name("testCoroutineResumedOnceAndDestroyedWithCore");
+        }while (false);
+
+        IFacade& facade = Facade::getInstance("ControllerTestKey14");
+        data::ControllerTestResendMediator mediator;
+        data::ControllerTestWaitingCoroutineCommand command;
+        facade.registerMediator(&mediator);
+        facade.registerCommand("ControllerCoroutineStart", &command);
+        data::ControllerTestFrameGuard::destroyed = 0;
+
+        facade.sendNotification("ControllerCoroutineStart");
+        ensure_equals("Expecting the coroutine suspended", command.resumed, 0);
+
+        // the mediator sends the name again before the first dispatch reaches the coroutine
+        facade.sendNotification("ControllerCoroutineAgain");
+        ensure("Expecting the notification sent again", mediator.sent);
+        ensure_equals("Expecting one resume for nested dispatches", command.resumed, 1);
+        facade.sendNotification("ControllerCoroutineAgain");
+        ensure_equals("Expecting the second wait resumed", command.resumed, 2);
+
+        // the coroutine waits for a notification never sent, the view is deleted
+        facade.removeMediator("ControllerTestResendMediator");
+        facade.removeCommand("ControllerCoroutineStart");
+        delete &View::getInstance("ControllerTestKey14");
+        Facade::removeCore("ControllerTestKey14");
+        ensure_equals("Expecting the suspended coroutine destroyed", data::ControllerTestFrameGuard::destroyed, 1L);
+        ensure_equals("Expecting the coroutine not resumed by the teardown", command.resumed, 2);
+    }
+#endif
 }
@@ -0,0 +1,76 @@
+//  ControllerTestCachedCommand.hpp
+//  PureMVC_C++ Test suite
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__CONTROLLER_TEST_CACHED_COMMAND_HPP__)
+#define __CONTROLLER_TEST_CACHED_COMMAND_HPP__
+
+#include <PureMVC/PureMVC.hpp>
+#include "ControllerTestVO.hpp"
+
+namespace data
+{
+    using PureMVC::Interfaces::INotification;
+
+    /**
+     * Key extractor used by ControllerTest to test cached commands.
+     */
+    struct ControllerTestCacheKey
+    {
+        typedef int result_type;
+
+        int operator()(INotification const& note) const
+        {
+            return ((ControllerTestVO const*)note.getBody())->input;
+        }
+    };
+
+    /**
+     * Computation used by ControllerTest to test cached commands.
+     */
+    struct ControllerTestCacheCompute
+    {
+        typedef int result_type;
+        int* calls;
+
+        explicit ControllerTestCacheCompute(int* calls)
+            :calls(calls)
+        { }
+
+        /**
+         * Fabricate a result by squaring the input.
+         */
+        int operator()(INotification const& note) const
+        {
+            ++*calls;
+            int input = ((ControllerTestVO const*)note.getBody())->input;
+            return input * input;
+        }
+    };
+
+    /**
+     * Observer context recording the result notifications of cached commands.
+     */
+    struct ControllerTestCacheResult
+    {
+        int last;
+        int count;
+
+        ControllerTestCacheResult(void)
+            :last(0)
+            ,count(0)
+        { }
+
+        void handleResult(INotification const& note)
+        {
+            last = *(int const*)note.getBody();
+            ++count;
+        }
+    };
+}
+
+#endif /* __CONTROLLER_TEST_CACHED_COMMAND_HPP__ */
@@ -0,0 +1,116 @@
+//  ControllerTestCoroutineCommand.hpp
+//  PureMVC_C++ Test suite
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__CONTROLLER_TEST_COROUTINE_COMMAND_HPP__)
+#define __CONTROLLER_TEST_COROUTINE_COMMAND_HPP__
+
+#include <PureMVC/PureMVC.hpp>
+#include "ControllerTestVO.hpp"
+
+#if defined(PUREMVC_USES_COROUTINE)
+
+namespace data
+{
+    using PureMVC::Patterns::CoroutineCommand;
+    using PureMVC::Patterns::CoroutineTask;
+    using PureMVC::Interfaces::INotification;
+    /**
+     * A CoroutineCommand subclass used by ControllerTest.
+     */
+    struct ControllerTestCoroutineCommand: public CoroutineCommand
+    {
+        ControllerTestCoroutineCommand(void)
+            :CoroutineCommand()
+        { }
+
+        /**
+         * Add the body of the first "ControllerCoroutineNext" notification to the input,
+         * then multiply by the body of the second one.
+         * 
+         * @param note the note carrying the ControllerTestVO
+         */
+        virtual CoroutineTask executeCoroutine(INotification const& note)
+        {
+            ControllerTestVO* vo = (ControllerTestVO*)note.getBody();
+            vo->result = vo->input;
+
+            INotification const& first = co_await nextNotification("ControllerCoroutineNext");
+            vo->result += *(int const*)first.getBody();
+
+            INotification const& second = co_await nextNotification("ControllerCoroutineNext");
+            vo->result *= *(int const*)second.getBody();
+        }
+    };
+
+    /**
+     * Counts the destruction of the coroutine frame holding it.
+     */
+    struct ControllerTestFrameGuard
+    {
+        static long volatile destroyed;
+
+        ~ControllerTestFrameGuard(void)
+        {
+            PureMVC::atomicIncrement(&destroyed);
+        }
+    };
+
+    /**
+     * A CoroutineCommand waiting twice for "ControllerCoroutineAgain", then for
+     * a notification never sent.
+     */
+    struct ControllerTestWaitingCoroutineCommand: public CoroutineCommand
+    {
+        int resumed;
+
+        ControllerTestWaitingCoroutineCommand(void)
+            :CoroutineCommand()
+            ,resumed(0)
+        { }
+
+        virtual CoroutineTask executeCoroutine(INotification const& note)
+        {
+            (void)note;
+            ControllerTestFrameGuard guard;
+            co_await nextNotification("ControllerCoroutineAgain");
+            ++resumed;
+            co_await nextNotification("ControllerCoroutineAgain");
+            ++resumed;
+            co_await nextNotification("ControllerCoroutineNever");
+            ++resumed;
+        }
+    };
+
+    /**
+     * A Mediator sending "ControllerCoroutineAgain" again from its first handling.
+     */
+    struct ControllerTestResendMediator: public PureMVC::Patterns::Mediator
+    {
+        static std::string const INTERESTS[1];
+        bool sent;
+
+        ControllerTestResendMediator(void)
+            :PureMVC::Patterns::Mediator("ControllerTestResendMediator")
+            ,sent(false)
+        {
+            setNotificationInterests(INTERESTS);
+        }
+
+        virtual void handleNotification(INotification const& note)
+        {
+            if (sent)
+                return;
+            sent = true;
+            sendNotification(note.getName());
+        }
+    };
+}
+
+#endif /* PUREMVC_USES_COROUTINE */
+
+#endif /* __CONTROLLER_TEST_COROUTINE_COMMAND_HPP__ */
@@ -0,0 +1,115 @@
+//  ControllerTestPooledCommand.hpp
+//  PureMVC_C++ Test suite
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__CONTROLLER_TEST_POOLED_COMMAND_HPP__)
+#define __CONTROLLER_TEST_POOLED_COMMAND_HPP__
+
+#include <PureMVC/PureMVC.hpp>
+#include "ControllerTestVO.hpp"
+
+namespace data
+{
+    using PureMVC::Patterns::SimpleCommand;
+    using PureMVC::Interfaces::INotification;
+    using PureMVC::Interfaces::ICommand;
+    /**
+     * A stateful SimpleCommand subclass used by ControllerTest
+     * to test pooled command instances.
+     */
+    struct ControllerTestPooledCommand
+        : public virtual ICommand
+        , public SimpleCommand
+    {
+        static long volatile instances;
+        int factor;
+
+        /**
+         * Constructor.
+         */
+        ControllerTestPooledCommand(int factor = 2)
+            :SimpleCommand()
+            ,factor(factor)
+        {
+            PureMVC::atomicIncrement(&instances);
+        }
+
+        /**
+         * Copy constructor.
+         */
+        ControllerTestPooledCommand(ControllerTestPooledCommand const& arg)
+            :SimpleCommand(arg)
+            ,factor(arg.factor)
+        {
+            PureMVC::atomicIncrement(&instances);
+        }
+
+        /**
+         * Fabricate a result by multiplying the input by factor
+         * 
+         * @param note the note carrying the ControllerTestVO
+         */
+        virtual void execute(INotification const& note)
+        {
+            ControllerTestVO& vo= *(ControllerTestVO*)note.getBody();
+            // Fabricate a result
+            vo.result = factor * vo.input;
+        }
+
+        /**
+         * Destructor.
+         */
+        ~ControllerTestPooledCommand(void)
+        {
+            PureMVC::atomicDecrement(&instances);
+        }
+    };
+
+    /**
+     * A SimpleCommand subclass used by ControllerTest to detect
+     * a pooled instance executed by two threads at once.
+     */
+    struct ControllerTestBusyCommand
+        : public virtual ICommand
+        , public SimpleCommand
+    {
+        static long volatile instances;
+        static long volatile shared;
+        long volatile busy;
+
+        /**
+         * Constructor.
+         */
+        ControllerTestBusyCommand(void)
+            :SimpleCommand()
+            ,busy(0)
+        {
+            PureMVC::atomicIncrement(&instances);
+        }
+
+        /**
+         * Stay busy for a while, counting the overlapping executions.
+         */
+        virtual void execute(INotification const&)
+        {
+            if (PureMVC::atomicIncrement(&busy) != 1)
+                PureMVC::atomicIncrement(&shared);
+            PureMVC::Thread::sleep(1);
+            PureMVC::atomicDecrement(&busy);
+        }
+
+        /**
+         * Destructor.
+         */
+        ~ControllerTestBusyCommand(void)
+        {
+            PureMVC::atomicDecrement(&instances);
+        }
+    };
+}
+
+#endif /* __CONTROLLER_TEST_POOLED_COMMAND_HPP__ */ 
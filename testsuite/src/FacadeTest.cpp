@@ -11,17 +11,28 @@
 #pragma warning( disable : 4355 ) // The this pointer is valid only within nonstatic member functions. It cannot be used in the initializer list for a base class.ck(16)
 #endif
 
+#include <vector>
+#include <cstdio>
 #include <tut/tut.hpp>
 #include <tut_reporter.h>
 #include <PureMVC/PureMVC.hpp>
 
 #include "FacadeTestCommand.hpp"
 #include "FacadeTestInheritance.hpp"
+#include "FacadeTestMediator.hpp"
 
 namespace data
 {
     struct FacadeTest
     { };
+
+    long volatile facade_timer_count = 0;
+
+    struct FacadeTimerAction {
+        static void execute(PureMVC::Interfaces::INotification const&) {
+            PureMVC::atomicIncrement(&facade_timer_count);
+        }
+    };
 }
 
 namespace testgroup
@@ -36,6 +47,7 @@ namespace tut
     using namespace testgroup;
 
     using PureMVC::Interfaces::IFacade;
+    using PureMVC::Interfaces::INotification;
     using PureMVC::Interfaces::IProxy;
     using PureMVC::Interfaces::IMediator;
     using PureMVC::Interfaces::IAggregate;
@@ -43,6 +55,8 @@ namespace tut
     using PureMVC::Patterns::Facade;
     using PureMVC::Patterns::Proxy;
     using PureMVC::Patterns::Mediator;
+    using PureMVC::Patterns::DelegateCommand;
+    using PureMVC::Thread;
 
     template<> template<> 
     void object::test<1>(void)
@@ -374,4 +388,111 @@ namespace tut
 
         ensure_equals("Expecting facade.initializeFacadeCalled = Called!!!", (*facade.initializeFacadeCalled), "Called!!!");
     }
+
+    template<> template<>
+    void object::test<13>(void)
+    {
+        set_test_name("testSendNotificationAfterAndEvery");
+
+        IFacade& facade = Facade::getInstance("FacadeTestKey13");
+        DelegateCommand<void(*)(INotification const&)> command(data::FacadeTimerAction::execute);
+        facade.registerCommand("FacadeTimerNote", &command);
+
+        data::facade_timer_count = 0;
+        facade.sendNotificationAfter(20, "FacadeTimerNote");
+        unsigned long cancelled = facade.sendNotificationAfter(20, "FacadeTimerNote");
+        ensure("Expecting cancelNotification return true", facade.cancelNotification(cancelled));
+        // beyond the first level of the wheel
+        facade.sendNotificationAfter(300, "FacadeTimerNote");
+
+        Thread::sleep(150);
+        ensure_equals("Expecting one notification after 150ms", data::facade_timer_count, 1L);
+        Thread::sleep(400);
+        ensure_equals("Expecting two notifications after 550ms", data::facade_timer_count, 2L);
+
+        data::facade_timer_count = 0;
+        unsigned long periodic = facade.sendNotificationEvery(10, "FacadeTimerNote");
+        Thread::sleep(300);
+        ensure("Expecting cancelNotification return true", facade.cancelNotification(periodic));
+        ensure("Expecting several notifications", data::facade_timer_count >= 3);
+
+        // removing the core cancels its pending notifications
+        facade.sendNotificationEvery(10, "FacadeTimerNote");
+        facade.removeCommand("FacadeTimerNote");
+        Facade::removeCore("FacadeTestKey13");
+        ensure_equals("Expecting no pending timer", PureMVC::Timer::getInstance().getPendingCount(), (std::size_t)0);
+    }
+
+    template<> template<>
+    void object::test<14>(void)
+    {
+        set_test_name("testBulkRegistration");
+
+        IFacade& facade = Facade::getInstance("FacadeTestKey14");
+
+        Proxy proxy1("BulkProxy1");
+        Proxy proxy2("BulkProxy2");
+        IProxy* proxies[] = { &proxy1, &proxy2 };
+        facade.registerProxies(proxies, 2);
+        ensure("Expecting facade.hasProxy('BulkProxy1') == true", facade.hasProxy("BulkProxy1"));
+        ensure("Expecting facade.hasProxy('BulkProxy2') == true", facade.hasProxy("BulkProxy2"));
+
+        data::FacadeTestMediator mediator1("BulkMediator1");
+        data::FacadeTestMediator mediator2("BulkMediator2");
+        data::FacadeTestMediator duplicate("BulkMediator1");
+        IMediator* mediators[] = { &mediator1, &mediator2, &duplicate };
+        facade.registerMediators(mediators, 3);
+        ensure("Expecting facade.hasMediator('BulkMediator2') == true", facade.hasMediator("BulkMediator2"));
+        ensure("Expecting the first mediator to be kept", &facade.retrieveMediator("BulkMediator1") == &mediator1);
+
+        DelegateCommand<void(*)(INotification const&)> command(data::FacadeTimerAction::execute);
+        std::string names[] = { "BulkNote1", "BulkNote2", "BulkNote1" };
+        PureMVC::Interfaces::ICommand* commands[] = { &command, &command, &command };
+        facade.registerCommands(names, commands, 3);
+        ensure("Expecting facade.hasCommand('BulkNote2') == true", facade.hasCommand("BulkNote2"));
+
+        data::facade_timer_count = 0;
+        facade.sendNotification("BulkNote1");
+        facade.sendNotification("BulkNote2");
+        ensure_equals("Expecting one execution per notification", data::facade_timer_count, 2L);
+        ensure_equals("Expecting mediator1 notified of both interests", mediator1.handled, 2);
+        ensure_equals("Expecting mediator2 notified of both interests", mediator2.handled, 2);
+        ensure_equals("Expecting the duplicate mediator not notified", duplicate.handled, 0);
+
+        facade.removeCommand("BulkNote1");
+        facade.removeCommand("BulkNote2");
+        facade.removeMediator("BulkMediator1");
+        facade.removeMediator("BulkMediator2");
+        facade.sendNotification("BulkNote1");
+        ensure_equals("Expecting removed mediators not notified", mediator1.handled + mediator2.handled, 4);
+        facade.removeProxy("BulkProxy1");
+        facade.removeProxy("BulkProxy2");
+        Facade::removeCore("FacadeTestKey14");
+    }
+
+    template<> template<>
+    void object::test<15>(void)
+    {
+        set_test_name("testCoreCapacity");
+
+        IFacade& facade = Facade::getInstance("FacadeTestKey15", PureMVC::CoreCapacity(64, 8, 8, 256));
+
+        std::vector<IProxy*> proxies;
+        for (int i = 0; i < 100; ++i)
+        {
+            char name[32];
+            sprintf(name, "CapacityProxy%d", i);
+            proxies.push_back(new Proxy(name));
+        }
+        facade.registerProxies(&proxies[0], proxies.size());
+        // growing an existing core keeps its content, a smaller capacity does not shrink it
+        Facade::getInstance("FacadeTestKey15", PureMVC::CoreCapacity(1000, 100, 100, 10000));
+        facade.reserve(PureMVC::CoreCapacity(1, 1, 1, 1));
+        for (std::size_t i = 0; i < proxies.size(); ++i)
+            ensure("Expecting the proxy to be registered", facade.tryRetrieveProxy(proxies[i]->getProxyName()) == proxies[i]);
+
+        for (std::size_t i = 0; i < proxies.size(); ++i)
+            delete facade.removeProxy(proxies[i]->getProxyName());
+        Facade::removeCore("FacadeTestKey15");
+    }
 }
@@ -0,0 +1,45 @@
+//  FacadeTestMediator.hpp
+//  PureMVC_C++ Test suite
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__FACADE_TEST_MEDIATOR_HPP__)
+#define __FACADE_TEST_MEDIATOR_HPP__
+
+#include <string>
+#include <PureMVC/PureMVC.hpp>
+
+namespace data
+{
+    using PureMVC::Interfaces::INotification;
+    using PureMVC::Patterns::Mediator;
+
+    /**
+     * A Mediator used by FacadeTest, counting the notifications it handles.
+     */
+    struct FacadeTestMediator : public Mediator
+    {
+        static std::string const INTERESTS[2];
+        int handled;
+
+        explicit FacadeTestMediator(std::string const& name)
+            :Mediator(name)
+            ,handled(0)
+        {
+            setNotificationInterests(INTERESTS);
+        }
+
+        virtual void handleNotification(INotification const& notification)
+        {
+            (void)notification;
+            ++handled;
+        }
+    };
+
+    std::string const FacadeTestMediator::INTERESTS[2] = { "BulkNote1", "BulkNote2" };
+}
+
+#endif /* __FACADE_TEST_MEDIATOR_HPP__ */
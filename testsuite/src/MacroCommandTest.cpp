@@ -19,6 +19,7 @@
 #include "MacroCommandTestVO.hpp"
 #include "MacroCommandTestSub1Command.hpp"
 #include "MacroCommandTestSub2Command.hpp"
+#include "MacroCommandTestGateCommand.hpp"
 
 namespace data 
 {
@@ -40,7 +41,10 @@ namespace tut
     using PureMVC::Interfaces::INotification;
     using PureMVC::Interfaces::ICommand;
     using PureMVC::Patterns::MacroCommand;
+    using PureMVC::Patterns::PipelineCommand;
     using PureMVC::Patterns::Notification;
+    using PureMVC::Patterns::createCommand;
+    using PureMVC::Thread;
 
     template<> template<> 
     void object::test<1>(void)
@@ -102,4 +106,126 @@ namespace tut
         ensure_equals( "Expecting vo.result1 == 10", vo.result1, 16);
         ensure_equals( "Expecting vo.result2 == 49", vo.result2, 64);
     }
+
+    template<> template<> 
+    void object::test<4>(void)
+    {
+        set_test_name("testMacroCommandReExecute");
+
+        data::MacroCommandTestSub1Command* sub1 = new data::MacroCommandTestSub1Command();
+        data::MacroCommandTestSub2Command* sub2 = new data::MacroCommandTestSub2Command();
+        ICommand* command_array[] = { sub1, sub2 };
+
+        MacroCommand command(command_array, command_array + getSize(command_array));
+        command.initializeNotifier("MacroCommandTestKey");
+
+        ensure_equals( "Expecting sub1 multiton key == MacroCommandTestKey", sub1->getMultitonKey(), std::string("MacroCommandTestKey"));
+        ensure_equals( "Expecting sub2 multiton key == MacroCommandTestKey", sub2->getMultitonKey(), std::string("MacroCommandTestKey"));
+
+        data::MacroCommandTestVO vo1(3);
+        Notification note1("MacroCommandReExecuteTest", &vo1);
+        command.execute((INotification&)note1);
+
+        ensure_equals( "Expecting vo1.result1 == 6", vo1.result1, 6);
+        ensure_equals( "Expecting vo1.result2 == 9", vo1.result2, 9);
+
+        data::MacroCommandTestVO vo2(4);
+        Notification note2("MacroCommandReExecuteTest", &vo2);
+        command.execute((INotification&)note2);
+
+        ensure_equals( "Expecting vo2.result1 == 8", vo2.result1, 8);
+        ensure_equals( "Expecting vo2.result2 == 16", vo2.result2, 16);
+
+        delete sub1;
+        delete sub2;
+    }
+
+    template<> template<> 
+    void object::test<5>(void)
+    {
+        set_test_name("testPipelineCommandExecute");
+
+        data::MacroCommandTestSub1Command sub1;
+        data::MacroCommandTestSub2Command sub2;
+        ICommand* command_array[] = { &sub1, &sub2 };
+
+        PipelineCommand command(command_array, getSize(command_array), 2);
+        command.initializeNotifier("PipelineCommandTestKey");
+
+        ensure_equals( "Expecting stage count == 2", command.getStageCount(), (std::size_t)2);
+        ensure_equals( "Expecting sub2 multiton key == PipelineCommandTestKey", sub2.getMultitonKey(), std::string("PipelineCommandTestKey"));
+
+        std::vector<data::MacroCommandTestVO*> vos;
+        for (int i = 0; i < 16; ++i)
+        {
+            vos.push_back(new data::MacroCommandTestVO(i));
+            Notification note("PipelineCommandTest", vos.back());
+            command.execute((INotification&)note);
+        }
+        command.flush();
+
+        ensure_equals( "Expecting completed count == 16", command.getCompletedCount(), (std::size_t)16);
+        for (int i = 0; i < 16; ++i)
+        {
+            ensure_equals( "Expecting vo.result1 == 2 * input", vos[i]->result1, 2 * i);
+            ensure_equals( "Expecting vo.result2 == input * input", vos[i]->result2, i * i);
+        }
+
+        command.stop();
+
+        data::MacroCommandTestVO vo(9);
+        Notification note("PipelineCommandTest", &vo);
+        command.execute((INotification&)note);
+        command.stop();
+
+        ensure_equals( "Expecting completed count == 17", command.getCompletedCount(), (std::size_t)17);
+        ensure_equals( "Expecting vo.result1 == 18", vo.result1, 18);
+        ensure_equals( "Expecting vo.result2 == 81", vo.result2, 81);
+
+        for (std::size_t i = 0; i < vos.size(); ++i)
+            delete vos[i];
+    }
+
+    template<> template<> 
+    void object::test<6>(void)
+    {
+        set_test_name("testPipelineCommandBackpressure");
+
+        struct Action {
+            static void execute(INotification const& notification) {
+                void** data = (void**)notification.getBody();
+                PipelineCommand& pipeline = *(PipelineCommand*)data[0];
+                long volatile* returned = (long volatile*)data[1];
+                Notification note("PipelineCommandTest");
+                for (int i = 0; i < 6; ++i)
+                {
+                    pipeline.execute(note);
+                    PureMVC::atomicIncrement(returned);
+                }
+            }
+        };
+
+        data::MacroCommandTestGateCommand gate;
+        ICommand* command_array[] = { &gate };
+        PipelineCommand command(command_array, getSize(command_array), 2);
+
+        long volatile returned = 0;
+        void* data[] = { &command, (void*)&returned };
+        Notification notification("PipelineCommand*,long*", data);
+        Thread producer(createCommand(Action::execute));
+        producer.start(notification);
+
+        // The stage holds one notification and its queue two, the fourth call must block.
+        Thread::sleep(200);
+        ensure_equals( "Expecting producer blocked after 3 calls", PureMVC::atomicLoad(&returned), 3L);
+        ensure_equals( "Expecting nothing executed", PureMVC::atomicLoad(&gate.executed), 0L);
+
+        gate.gate.set();
+        producer.join();
+        command.flush();
+
+        ensure_equals( "Expecting producer returned 6 times", PureMVC::atomicLoad(&returned), 6L);
+        ensure_equals( "Expecting completed count == 6", command.getCompletedCount(), (std::size_t)6);
+        ensure_equals( "Expecting gate executed 6 times", PureMVC::atomicLoad(&gate.executed), 6L);
+    }
 }
@@ -0,0 +1,40 @@
+//  MacroCommandTestGateCommand.hpp
+//  PureMVC_C++ Test suite
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__MACRO_COMMAND_TEST_GATE_COMMAND_HPP__)
+#define __MACRO_COMMAND_TEST_GATE_COMMAND_HPP__
+
+namespace data
+{
+    using PureMVC::Patterns::SimpleCommand;
+    using PureMVC::Patterns::INotification;
+    using PureMVC::Event;
+    /**
+     * A SimpleCommand subclass used by PipelineCommand tests, 
+     * blocks until the gate is opened.
+     */
+    struct MacroCommandTestGateCommand: public SimpleCommand
+    {
+        Event gate;
+        long volatile executed;
+
+        MacroCommandTestGateCommand(void)
+            :SimpleCommand()
+            ,gate(false)
+            ,executed(0)
+        { }
+
+        void execute(INotification const&)
+        {
+            gate.wait();
+            PureMVC::atomicIncrement(&executed);
+        }
+    };
+}
+
+#endif /* __MACRO_COMMAND_TEST_GATE_COMMAND_HPP__ */
@@ -45,6 +45,8 @@ namespace tut
     using PureMVC::Interfaces::INotification;
     using PureMVC::Core::Model;
     using PureMVC::Patterns::Proxy;
+    using PureMVC::Patterns::ProxyRef;
+    using PureMVC::Patterns::createProxyFactory;
     using PureMVC::Patterns::Notification;
     using PureMVC::Patterns::DelegateCommand;
     using PureMVC::Patterns::createCommand;
@@ -371,4 +373,242 @@ namespace tut
             iter = threads.begin();
         }
     }
+
+    template<> template<>
+    void object::test<9>(void)
+    {
+        set_test_name("testTryRetrieveProxy");
+
+        IModel& model = Model::getInstance("ModelTestKey9");
+
+        Proxy proxy("TryRetrieveProxy");
+        model.registerProxy(&proxy);
+
+        ensure("Expecting model.tryRetrieveProxy('TryRetrieveProxy') == &proxy",
+               model.tryRetrieveProxy("TryRetrieveProxy") == &proxy);
+        IModel const& const_model = model;
+        ensure("Expecting const model.tryRetrieveProxy('TryRetrieveProxy') == &proxy",
+               const_model.tryRetrieveProxy("TryRetrieveProxy") == &proxy);
+        ensure("Expecting model.tryRetrieveProxy('Unknown') == NULL",
+               model.tryRetrieveProxy("Unknown") == NULL);
+
+        model.removeProxy("TryRetrieveProxy");
+        ensure("Expecting model.tryRetrieveProxy('TryRetrieveProxy') == NULL after removal",
+               model.tryRetrieveProxy("TryRetrieveProxy") == NULL);
+
+        bool bool_exception = false;
+        try
+        {
+            model.retrieveProxy("TryRetrieveProxy");
+        }
+        catch (std::exception const&)
+        {
+            bool_exception = true;
+        }
+        ensure("Expecting model.retrieveProxy still throws on a miss", bool_exception);
+        Model::removeModel("ModelTestKey9");
+    }
+
+    template<> template<>
+    void object::test<10>(void)
+    {
+        set_test_name("testProxyRef");
+
+        IModel& model = Model::getInstance("ModelTestKey10");
+
+        data::ModelTestProxy proxy;
+        model.registerProxy(&proxy);
+        Proxy plain_proxy("ProxyRefPlain");
+        model.registerProxy(&plain_proxy);
+
+        ProxyRef<data::ModelTestProxy> ref(model, data::ModelTestProxy::NAME);
+        ensure("Expecting ref.get() == &proxy", ref.get() == &proxy);
+        ensure("Expecting ref->getProxyName() == ModelTestProxy::NAME",
+               ref->getProxyName() == data::ModelTestProxy::NAME);
+
+        ProxyRef<data::ModelTestProxy> wrong_type(model, "ProxyRefPlain");
+        ensure("Expecting ref of another proxy type to be NULL", wrong_type.get() == NULL);
+
+        long generation = model.getGeneration();
+        model.removeProxy("ProxyRefPlain");
+        ensure("Expecting removeProxy to change the generation", model.getGeneration() != generation);
+        ensure("Expecting ref.get() == &proxy after unrelated removal", ref.get() == &proxy);
+
+        model.removeProxy(data::ModelTestProxy::NAME);
+        ensure("Expecting ref.get() == NULL after removal", ref.get() == NULL);
+
+        bool bool_exception = false;
+        try
+        {
+            ref->getProxyName();
+        }
+        catch (std::exception const&)
+        {
+            bool_exception = true;
+        }
+        ensure("Expecting ref-> to throw when the proxy is missing", bool_exception);
+
+        data::ModelTestProxy other_proxy;
+        model.registerProxy(&other_proxy);
+        ensure("Expecting ref.get() == &other_proxy after registration", ref.get() == &other_proxy);
+        model.removeProxy(data::ModelTestProxy::NAME);
+    }
+
+    template<> template<>
+    void object::test<11>(void)
+    {
+        set_test_name("testRegisterProxyFactory");
+
+        IModel& model = Model::getInstance("ModelTestKey11");
+
+        model.registerProxyFactory(data::ModelTestLazyProxy::NAME, createProxyFactory<data::ModelTestLazyProxy>());
+        ensure_equals("Expecting no proxy built by registration", data::ModelTestLazyProxy::instances, 0L);
+
+        struct Action {
+            static void execute(INotification const& notification) {
+                IModel& model = *(IModel*)notification.getBody();
+                IProxy* proxy = &model.retrieveProxy(data::ModelTestLazyProxy::NAME);
+                if (proxy->getProxyName() != data::ModelTestLazyProxy::NAME)
+                    throw std::runtime_error("Unexpected proxy.");
+            }
+        };
+
+        typedef std::list<Thread*> thread_list_t;
+        thread_list_t threads;
+        for(std::size_t i = 0; i < 8; ++i)
+            threads.push_back(new Thread(createCommand(Action::execute)));
+
+        Notification notification("IModel", &model);
+        thread_list_t::iterator iter = threads.begin();
+        for(; iter != threads.end(); ++iter)
+            (*iter)->start(notification);
+        for(iter = threads.begin(); iter != threads.end(); ++iter)
+        {
+            (*iter)->join();
+            delete *iter;
+        }
+
+        ensure_equals("Expecting proxy built once", data::ModelTestLazyProxy::instances, 1L);
+        ensure_equals("Expecting onRegister called once", data::ModelTestLazyProxy::registrations, 1L);
+        ensure("Expecting model.hasProxy('ModelTestLazyProxy') == true", model.hasProxy(data::ModelTestLazyProxy::NAME));
+
+        IProxy* proxy = model.removeProxy(data::ModelTestLazyProxy::NAME);
+        ensure("Expecting removed proxy not null", proxy != NULL);
+        delete proxy;
+
+        model.registerProxyFactory("ModelTestUnusedProxy", createProxyFactory<data::ModelTestLazyProxy>());
+        ensure("Expecting removeProxy of a proxy never built == NULL", model.removeProxy("ModelTestUnusedProxy") == NULL);
+        ensure("Expecting model.hasProxy('ModelTestUnusedProxy') == false", !model.hasProxy("ModelTestUnusedProxy"));
+        ensure_equals("Expecting no proxy built for an unused factory", data::ModelTestLazyProxy::instances, 1L);
+    }
+
+    template<> template<>
+    void object::test<12>(void)
+    {
+        set_test_name("testEvictableProxy");
+
+        struct Built {
+            static bool check(IModel const& model, std::string const& proxy_name) {
+                IModel::ProxyNames aggregate = model.listProxyNames();
+                IModel::ProxyNames::element_type::Iterator iterator = aggregate->getIterator();
+                while (iterator->moveNext())
+                    if (iterator->getCurrent() == proxy_name)
+                        return true;
+                return false;
+            }
+        };
+
+        IModel& model = Model::getInstance("ModelTestKey12");
+        model.setMemoryBudget(250);
+        ensure_equals("Expecting memory budget", model.getMemoryBudget(), (std::size_t)250);
+        model.registerEvictableProxyFactory("ModelTestEvictableA", createProxyFactory(&data::createModelTestEvictableProxy));
+        model.registerEvictableProxyFactory("ModelTestEvictableB", createProxyFactory(&data::createModelTestEvictableProxy));
+        model.registerEvictableProxyFactory("ModelTestEvictableC", createProxyFactory(&data::createModelTestEvictableProxy));
+        ensure_equals("Expecting no proxy built by registration", data::ModelTestEvictableProxy::instances, 0L);
+
+        model.retrieveProxy("ModelTestEvictableA");
+        model.retrieveProxy("ModelTestEvictableB");
+        ensure_equals("Expecting memory charged", model.getMemoryUsage(), (std::size_t)200);
+        long generation = model.getGeneration();
+
+        // Over budget: the clock hand clears the marks, then evicts the oldest proxy.
+        IProxy* proxy = &model.retrieveProxy("ModelTestEvictableC");
+        ensure_equals("Expecting new proxy returned", proxy->getProxyName(), std::string("ModelTestEvictableC"));
+        ensure_equals("Expecting memory within budget", model.getMemoryUsage(), (std::size_t)200);
+        ensure_equals("Expecting evicted proxy deleted", data::ModelTestEvictableProxy::instances, 2L);
+        ensure_equals("Expecting onRemove on eviction", data::ModelTestEvictableProxy::removals, 1L);
+        ensure("Expecting generation changed by eviction", model.getGeneration() != generation);
+        ensure("Expecting evicted proxy not listed", !Built::check(model, "ModelTestEvictableA"));
+
+        // A used proxy survives the next eviction.
+        model.retrieveProxy("ModelTestEvictableB");
+        ensure("Expecting evicted proxy rebuilt on access", model.tryRetrieveProxy("ModelTestEvictableA") != NULL);
+        ensure("Expecting used proxy kept", Built::check(model, "ModelTestEvictableB"));
+        ensure("Expecting unused proxy evicted", !Built::check(model, "ModelTestEvictableC"));
+        ensure_equals("Expecting second eviction", data::ModelTestEvictableProxy::removals, 2L);
+
+        model.setMemoryBudget(100);
+        ensure_equals("Expecting eviction by a smaller budget", model.getMemoryUsage(), (std::size_t)100);
+        ensure_equals("Expecting one live proxy", data::ModelTestEvictableProxy::instances, 1L);
+
+        model.setMemoryBudget(1000);
+        model.retrieveProxy("ModelTestEvictableA");
+        model.retrieveProxy("ModelTestEvictableB");
+        model.retrieveProxy("ModelTestEvictableC");
+        proxy = model.removeProxy("ModelTestEvictableC");
+        ensure("Expecting removed evictable proxy returned", proxy != NULL);
+        delete proxy;
+        ensure_equals("Expecting memory released by removal", model.getMemoryUsage(), (std::size_t)200);
+        ensure("Expecting removed proxy not rebuilt", !model.hasProxy("ModelTestEvictableC"));
+
+        delete model.removeProxy("ModelTestEvictableA");
+        delete model.removeProxy("ModelTestEvictableB");
+        ensure_equals("Expecting no memory charged", model.getMemoryUsage(), (std::size_t)0);
+        ensure_equals("Expecting no live proxy", data::ModelTestEvictableProxy::instances, 0L);
+        Model::removeModel("ModelTestKey12");
+    }
+
+    template<> template<>
+    void object::test<13>(void)
+    {
+        set_test_name("testRegisterProxyOverEvictableProxy");
+
+        IModel& model = Model::getInstance("ModelTestKey13");
+        model.setMemoryBudget(1000);
+        model.registerEvictableProxyFactory("ModelTestEvictableA", createProxyFactory(&data::createModelTestEvictableProxy));
+        model.registerEvictableProxyFactory("ModelTestEvictableB", createProxyFactory(&data::createModelTestEvictableProxy));
+        model.registerEvictableProxyFactory("ModelTestEvictableC", createProxyFactory(&data::createModelTestEvictableProxy));
+        model.retrieveProxy("ModelTestEvictableA");
+        model.retrieveProxy("ModelTestEvictableB");
+        ensure_equals("Expecting two proxies built", data::ModelTestEvictableProxy::instances, 2L);
+
+        // a presence check neither builds nor evicts
+        model.setMemoryBudget(200);
+        ensure("Expecting model.hasProxy('ModelTestEvictableC') == true", model.hasProxy("ModelTestEvictableC"));
+        ensure_equals("Expecting no proxy built by hasProxy", data::ModelTestEvictableProxy::instances, 2L);
+        ensure_equals("Expecting memory unchanged by hasProxy", model.getMemoryUsage(), (std::size_t)200);
+
+        long removals = data::ModelTestEvictableProxy::removals;
+        long generation = model.getGeneration();
+        IProxy* proxy = new data::ModelTestEvictableProxy("ModelTestEvictableA");
+        model.registerProxy(proxy);
+        ensure_equals("Expecting built proxy deleted", data::ModelTestEvictableProxy::instances, 2L);
+        ensure_equals("Expecting onRemove on the built proxy", data::ModelTestEvictableProxy::removals, removals + 1);
+        ensure("Expecting generation changed", model.getGeneration() != generation);
+        ensure_equals("Expecting memory released", model.getMemoryUsage(), (std::size_t)100);
+        ensure("Expecting registered proxy retrieved", &model.retrieveProxy("ModelTestEvictableA") == proxy);
+
+        IProxy* proxies[] = { new data::ModelTestEvictableProxy("ModelTestEvictableB") };
+        model.registerProxies(proxies, 1);
+        ensure_equals("Expecting built proxy deleted by registerProxies", data::ModelTestEvictableProxy::instances, 2L);
+        ensure_equals("Expecting onRemove by registerProxies", data::ModelTestEvictableProxy::removals, removals + 2);
+        ensure_equals("Expecting no memory charged", model.getMemoryUsage(), (std::size_t)0);
+        ensure("Expecting registered proxy retrieved", &model.retrieveProxy("ModelTestEvictableB") == proxies[0]);
+
+        delete model.removeProxy("ModelTestEvictableA");
+        delete model.removeProxy("ModelTestEvictableB");
+        ensure("Expecting removeProxy of a proxy never built == NULL", model.removeProxy("ModelTestEvictableC") == NULL);
+        ensure_equals("Expecting no live proxy", data::ModelTestEvictableProxy::instances, 0L);
+        Model::removeModel("ModelTestKey13");
+    }
 }
@@ -35,7 +35,68 @@ namespace data
         }
     };
 
+    /**
+     * A Proxy registered through a factory, counting its instances.
+     */
+    struct ModelTestLazyProxy: public Proxy
+    {
+        static char const* const NAME;
+        static long volatile instances;
+        static long volatile registrations;
+
+        ModelTestLazyProxy() :Proxy(NAME, "")
+        {
+            PureMVC::atomicIncrement(&instances);
+            // widen the window for concurrent first retrievals
+            PureMVC::Thread::sleep(20);
+        }
+
+        virtual void onRegister(void)
+        {
+            PureMVC::atomicIncrement(&registrations);
+        }
+    };
+
+    /**
+     * A Proxy the model may evict, counting its live instances.
+     */
+    struct ModelTestEvictableProxy: public Proxy, public PureMVC::Interfaces::IEvictable
+    {
+        static long volatile instances;
+        static long volatile removals;
+
+        explicit ModelTestEvictableProxy(std::string const& name) :Proxy(name, "")
+        {
+            PureMVC::atomicIncrement(&instances);
+        }
+
+        virtual std::size_t getMemoryUsage(void) const
+        {
+            return 100;
+        }
+
+        virtual void onRemove(void)
+        {
+            PureMVC::atomicIncrement(&removals);
+        }
+
+        virtual ~ModelTestEvictableProxy(void)
+        {
+            PureMVC::atomicDecrement(&instances);
+        }
+    };
+
+    inline PureMVC::Interfaces::IProxy* createModelTestEvictableProxy(std::string const& name)
+    {
+        return new ModelTestEvictableProxy(name);
+    }
+
     char const* const ModelTestProxy::NAME = "ModelTestProxy";
+    char const* const ModelTestLazyProxy::NAME = "ModelTestLazyProxy";
+    long volatile ModelTestLazyProxy::instances = 0;
+    long volatile ModelTestLazyProxy::registrations = 0;
+    long volatile ModelTestEvictableProxy::instances = 0;
+    long volatile ModelTestEvictableProxy::removals = 0;
     char const* const ModelTestProxy::ON_REGISTER_CALLED = "onRegister Called";
     char const* const ModelTestProxy::ON_REMOVE_CALLED = "onRemove Called";
 }
@@ -11,10 +11,25 @@
 #pragma warning( disable : 4355 ) // The this pointer is valid only within nonstatic member functions. It cannot be used in the initializer list for a base class.ck(16)
 #endif
 
+#include <vector>
+#include <list>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
 #include <tut/tut.hpp>
 #include <tut_reporter.h>
 #include <PureMVC/PureMVC.hpp>
 
+#include "ProxyTestVersionedVO.hpp"
+#include "ProxyTestChangeTrackingProxy.hpp"
+#include "ProxyTestCollectionRecord.hpp"
+#include "ProxyTestEventSourcedProxy.hpp"
+#include "ProxyTestDerivedProxy.hpp"
+#include "ProxyTestAsyncProxy.hpp"
+#include "ProxyTestSerializableProxy.hpp"
+#include "ProxyTestCachingProxy.hpp"
+
 namespace data
 {
     struct ProxyTest
@@ -32,6 +47,27 @@ namespace tut
 {
     using namespace testgroup;
     using PureMVC::Patterns::Proxy;
+    using PureMVC::Patterns::VersionedProxy;
+    using PureMVC::Patterns::createCommand;
+    using PureMVC::Patterns::Notification;
+    using PureMVC::Interfaces::INotification;
+    using PureMVC::Thread;
+    using PureMVC::Interfaces::IFacade;
+    using PureMVC::Patterns::Facade;
+    using PureMVC::Patterns::ChangeTrackingProxy;
+    using PureMVC::Patterns::createObserver;
+    using PureMVC::Core::View;
+    using PureMVC::Patterns::CollectionProxy;
+    using PureMVC::Patterns::ColumnKernels;
+    using PureMVC::Patterns::MappedFileProxy;
+    using PureMVC::Patterns::AsyncProxy;
+    using PureMVC::Patterns::ProxySnapshot;
+    using PureMVC::Patterns::createProxyFactory;
+    using PureMVC::Interfaces::IProxy;
+    using PureMVC::Interfaces::IModel;
+    using PureMVC::Core::Model;
+    using PureMVC::Patterns::CachingProxy;
+    using PureMVC::Patterns::createCacheLoader;
 
     template<> template<> 
     void object::test<1>(void)
@@ -88,4 +124,688 @@ namespace tut
         delete proxy;
         delete data;
     }
+
+    template<> template<>
+    void object::test<5>(void)
+    {
+        set_test_name("testVersionedProxy");
+
+        typedef VersionedProxy<data::ProxyTestVersionedVO> versioned_proxy_t;
+
+        struct Reader {
+            static void execute(INotification const& notification) {
+                versioned_proxy_t& proxy = *(versioned_proxy_t*)notification.getBody();
+                long last = 0;
+                for (int i = 0; i < 20000; ++i)
+                {
+                    versioned_proxy_t::Snapshot snapshot = proxy.getSnapshot();
+                    if (!snapshot->isConsistent() || snapshot.getVersion() < last)
+                        throw std::runtime_error("Inconsistent snapshot.");
+                    last = snapshot.getVersion();
+                }
+            }
+        };
+
+        do
+        {
+            versioned_proxy_t proxy("VersionedProxy", data::ProxyTestVersionedVO(0));
+            ensure_equals("Expecting first version == 0", proxy.getVersion(), 0L);
+
+            versioned_proxy_t::Snapshot first = proxy.getSnapshot();
+            ensure_equals("Expecting publish to return version 1", proxy.publish(data::ProxyTestVersionedVO(1)), 1L);
+            ensure_equals("Expecting held snapshot to keep version 0", first->first, 0L);
+            ensure_equals("Expecting current version == 1", proxy.getSnapshot()->first, 1L);
+
+            typedef std::list<Thread*> thread_list_t;
+            thread_list_t threads;
+            for (std::size_t i = 0; i < 4; ++i)
+                threads.push_back(new Thread(createCommand(Reader::execute)));
+
+            Notification notification("VersionedProxy", &proxy);
+            thread_list_t::iterator iter = threads.begin();
+            for (; iter != threads.end(); ++iter)
+                (*iter)->start(notification);
+            for (long i = 2; i < 20000; ++i)
+                proxy.publish(data::ProxyTestVersionedVO(i));
+            for (iter = threads.begin(); iter != threads.end(); ++iter)
+            {
+                (*iter)->join();
+                delete *iter;
+            }
+
+            ensure_equals("Expecting last version == 19999", proxy.getVersion(), 19999L);
+            ensure_equals("Expecting only the current and the held versions alive",
+                          data::ProxyTestVersionedVO::instances, 2L);
+        } while (false);
+
+        ensure_equals("Expecting every version reclaimed", data::ProxyTestVersionedVO::instances, 0L);
+    }
+
+    template<> template<>
+    void object::test<6>(void)
+    {
+        set_test_name("testChangeTrackingProxy");
+
+        IFacade& facade = Facade::getInstance("ProxyTestKey6");
+        data::ProxyTestChangeTrackingProxy proxy;
+        facade.registerProxy(&proxy);
+
+        data::ProxyTestChangeListener listener;
+        View::getInstance("ProxyTestKey6").registerObserver("ProxyTestChanged",
+            createObserver(&data::ProxyTestChangeListener::handleChange, &listener));
+
+        proxy.beginChanges();
+        for (unsigned long i = 0; i < 1000; ++i)
+        {
+            proxy.setAge((int)i);
+            proxy.updateRecord(999 - i % 10);
+        }
+        proxy.beginChanges();
+        proxy.setName("nested");
+        proxy.commitChanges();
+        ensure_equals("Expecting no notification inside a transaction", listener.count, 0);
+        ensure("Expecting pending changes", proxy.hasChanges());
+        proxy.commitChanges();
+
+        ensure_equals("Expecting one notification for the transaction", listener.count, 1);
+        ensure_equals("Expecting notification type == proxy name", listener.type, proxy.getProxyName());
+        ensure_equals("Expecting name and age fields changed", listener.fields,
+                      (1UL << data::ProxyTestChangeTrackingProxy::NAME_FIELD) | (1UL << data::ProxyTestChangeTrackingProxy::AGE_FIELD));
+        ensure_equals("Expecting ten unique records", listener.records.size(), (std::size_t)10);
+        ensure_equals("Expecting records sorted", listener.records.front(), 990UL);
+        ensure("Expecting no pending changes after commit", !proxy.hasChanges());
+
+        ensure("Expecting flush without changes to send nothing", !proxy.flushChanges());
+        proxy.setName("tick");
+        proxy.setName("tock");
+        ensure("Expecting flush to send the pending changes", proxy.flushChanges());
+        ensure_equals("Expecting one notification for the tick", listener.count, 2);
+        ensure_equals("Expecting only name field changed", listener.fields,
+                      1UL << data::ProxyTestChangeTrackingProxy::NAME_FIELD);
+
+        bool bool_exception = false;
+        try
+        {
+            proxy.commitChanges();
+        }
+        catch (std::exception const&)
+        {
+            bool_exception = true;
+        }
+        ensure("Expecting commit without transaction to throw", bool_exception);
+
+        View::getInstance("ProxyTestKey6").removeObserver("ProxyTestChanged", &listener);
+        facade.removeProxy(proxy.getProxyName());
+        Facade::removeCore("ProxyTestKey6");
+    }
+
+    template<> template<>
+    void object::test<7>(void)
+    {
+        set_test_name("testCollectionProxy");
+
+        typedef data::ProxyTestCollectionRecord Record;
+        CollectionProxy<Record> proxy("ProxyTestCollection");
+        ensure_equals("Expecting an instruction set name", std::string(ColumnKernels::getInstructionSet()).empty(), false);
+
+        bool thrown = false;
+        try
+        {
+            proxy.minimum(&Record::price);
+        }
+        catch (std::exception const&)
+        {
+            thrown = true;
+        }
+        ensure("Expecting minimum of an empty column to throw", thrown);
+
+        // An odd count exercises the scalar tail of every kernel.
+        std::size_t const size = 1003;
+        proxy.reserve(size);
+        for (std::size_t i = 0; i < size; ++i)
+            proxy.addRecord(Record((long)i));
+        ensure_equals("Expecting all records", proxy.getRecordCount(), size);
+
+        double price_sum = 0.0;
+        float quantity_min = 1000.0f;
+        int volume_sum = 0;
+        int volume_max = -1000;
+        long id_sum = 0;
+        std::size_t volume_greater = 0;
+        std::size_t quantity_equal = 0;
+        std::vector<std::size_t> expected;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            Record record((long)i);
+            price_sum += record.price;
+            quantity_min = std::min(quantity_min, record.quantity);
+            volume_sum += record.volume;
+            volume_max = std::max(volume_max, record.volume);
+            id_sum += record.id;
+            if (record.volume > 10)
+                ++volume_greater;
+            if (record.quantity == 3.0f)
+                ++quantity_equal;
+            if (record.price <= 100.0)
+                expected.push_back(i);
+        }
+
+        ensure_equals("Expecting sum of double column", proxy.sum(&Record::price), price_sum);
+        ensure_equals("Expecting minimum of float column", proxy.minimum(&Record::quantity), quantity_min);
+        ensure_equals("Expecting sum of int column", proxy.sum(&Record::volume), volume_sum);
+        ensure_equals("Expecting maximum of int column", proxy.maximum(&Record::volume), volume_max);
+        ensure_equals("Expecting sum of long column", proxy.sum(&Record::id), id_sum);
+        ensure_equals("Expecting count of int column", proxy.count(&Record::volume, ColumnKernels::GREATER, 10), volume_greater);
+        ensure_equals("Expecting count of float column", proxy.count(&Record::quantity, ColumnKernels::EQUAL, 3.0f), quantity_equal);
+
+        std::vector<std::size_t> indices;
+        proxy.filter(&Record::price, ColumnKernels::LESS_EQUAL, 100.0, indices);
+        ensure("Expecting filtered indices of double column", indices == expected);
+
+        Record record = proxy.getRecord(500);
+        ensure_equals("Expecting record read back from columns", record.id, 500L);
+        ensure_equals("Expecting record price read back", record.price, 250.0);
+        ensure_equals("Expecting column of contiguous values", proxy.getColumn(&Record::id)[7], 7L);
+
+        proxy.removeRecord(0);
+        ensure_equals("Expecting one record removed", proxy.getRecordCount(), size - 1);
+        ensure_equals("Expecting sum without the removed record", proxy.sum(&Record::id), id_sum);
+        ensure_equals("Expecting records shifted", proxy.getRecord(0).id, 1L);
+    }
+
+    template<> template<>
+    void object::test<8>(void)
+    {
+        set_test_name("testCollectionProxyIndexes");
+
+        typedef data::ProxyTestCollectionRecord Record;
+        typedef CollectionProxy<Record> Collection;
+        Collection indexed("ProxyTestIndexed");
+        Collection scanned("ProxyTestScanned");
+        indexed.createIndex(&Record::volume);
+        for (long i = 0; i < 500; ++i)
+        {
+            indexed.addRecord(Record(i));
+            scanned.addRecord(Record(i));
+        }
+        // Indexes created on existing records are built from them.
+        indexed.createIndex(&Record::id, Collection::SORTED_INDEX);
+        ensure("Expecting hash index on volume", indexed.hasIndex(&Record::volume));
+        ensure("Expecting sorted index on id", indexed.hasIndex(&Record::id, Collection::SORTED_INDEX));
+        ensure("Expecting no sorted index on volume", !indexed.hasIndex(&Record::volume, Collection::SORTED_INDEX));
+
+        Record changed(7);
+        changed.volume = 1000;
+        indexed.setRecord(3, changed);
+        scanned.setRecord(3, changed);
+        indexed.removeRecord(10);
+        scanned.removeRecord(10);
+        indexed.removeRecordUnordered(20);
+        scanned.removeRecordUnordered(20);
+        indexed.removeRecordUnordered(indexed.getRecordCount() - 1);
+        scanned.removeRecordUnordered(scanned.getRecordCount() - 1);
+        indexed.addRecord(Record(42));
+        scanned.addRecord(Record(42));
+
+        std::vector<std::size_t> found;
+        std::vector<std::size_t> expected;
+        for (int volume = -50; volume <= 50; ++volume)
+        {
+            indexed.findRecords(&Record::volume, volume, found);
+            scanned.findRecords(&Record::volume, volume, expected);
+            ensure("Expecting hash index lookups to match a scan", found == expected);
+        }
+        ensure_equals("Expecting updated value indexed", indexed.findRecords(&Record::volume, 1000, found), (std::size_t)1);
+        ensure_equals("Expecting updated record found", found.front(), (std::size_t)3);
+
+        std::size_t index = 0;
+        ensure("Expecting duplicated id found", indexed.findRecord(&Record::id, 42L, index));
+        ensure_equals("Expecting lowest index for duplicated id", index, (std::size_t)41);
+        ensure("Expecting removed id not found", !indexed.findRecord(&Record::id, 10L, index));
+
+        indexed.findRecordsInRange(&Record::id, 100L, 200L, found);
+        scanned.findRecordsInRange(&Record::id, 100L, 200L, expected);
+        ensure_equals("Expecting range lookup size", found.size(), (std::size_t)100);
+        ensure("Expecting sorted index range lookups to match a scan", found == expected);
+
+        indexed.removeIndex(&Record::volume);
+        ensure("Expecting index removed", !indexed.hasIndex(&Record::volume));
+        indexed.clear();
+        ensure_equals("Expecting no record after clear", indexed.findRecords(&Record::id, 42L, found), (std::size_t)0);
+    }
+
+    template<> template<>
+    void object::test<9>(void)
+    {
+        set_test_name("testMappedFileProxy");
+
+        typedef data::ProxyTestCollectionRecord Record;
+        char const* path = "ProxyTestMappedFile.bin";
+        std::vector<Record> records;
+        for (long i = 0; i < 1000; ++i)
+            records.push_back(Record(i));
+        MappedFileProxy<Record>::writeFile(path, &records[0], records.size(), 7);
+
+        do
+        {
+            MappedFileProxy<Record> proxy("ProxyTestMappedFile", path, 7);
+            ensure("Expecting file loaded", proxy.isLoaded());
+            ensure_equals("Expecting all records", proxy.getRecordCount(), records.size());
+            ensure("Expecting data to point at the mapped records", proxy.getData() == proxy.getRecords());
+            ensure("Expecting records to be a view of the file", proxy.getRecords() != &records[0]);
+            Record const& record = proxy.getRecord(999);
+            ensure_equals("Expecting record id", record.id, 999L);
+            ensure_equals("Expecting record price", record.price, records[999].price);
+            ensure_equals("Expecting record volume", ((Record const*)proxy.getData())[500].volume, records[500].volume);
+
+            bool thrown = false;
+            try
+            {
+                proxy.getRecord(1000);
+            }
+            catch (std::exception const&)
+            {
+                thrown = true;
+            }
+            ensure("Expecting out of range record to throw", thrown);
+
+            proxy.unload();
+            ensure("Expecting file unloaded", !proxy.isLoaded());
+            ensure("Expecting no data after unload", proxy.getData() == NULL);
+        } while (false);
+
+        bool thrown = false;
+        try
+        {
+            MappedFileProxy<Record> proxy("ProxyTestMappedFile", path, 8);
+        }
+        catch (std::exception const&)
+        {
+            thrown = true;
+        }
+        ensure("Expecting record type mismatch to throw", thrown);
+
+        thrown = false;
+        try
+        {
+            MappedFileProxy<long> proxy("ProxyTestMappedFile", path);
+        }
+        catch (std::exception const&)
+        {
+            thrown = true;
+        }
+        ensure("Expecting record size mismatch to throw", thrown);
+
+        std::remove(path);
+    }
+
+    template<> template<>
+    void object::test<10>(void)
+    {
+        set_test_name("testEventSourcedProxy");
+
+        std::string path = "ProxyTestEvents";
+        long balance = 0;
+        do
+        {
+            data::ProxyTestEventSourcedProxy proxy(path);
+            proxy.open();
+            ensure_equals("Expecting empty state", proxy.getState().deposits, 0L);
+            for (long i = 1; i <= 57; ++i)
+            {
+                proxy.deposit(i);
+                balance += i;
+            }
+            ensure_equals("Expecting snapshot every 25 events", proxy.getSnapshotSequence(), (std::size_t)50);
+            ensure("Expecting segments before the snapshot deleted", std::ifstream(proxy.getSegmentPath(4).c_str()).fail());
+            ensure("Expecting segment of the snapshot kept", !std::ifstream(proxy.getSegmentPath(5).c_str()).fail());
+            ensure("Expecting temporary snapshot replaced", std::ifstream((proxy.getSnapshotPath() + ".tmp").c_str()).fail());
+        } while (false);
+
+        do
+        {
+            data::ProxyTestEventSourcedProxy proxy(path);
+            proxy.open();
+            ensure_equals("Expecting sequence recovered", proxy.getSequence(), (std::size_t)57);
+            ensure_equals("Expecting balance recovered", proxy.getState().balance, balance);
+            ensure_equals("Expecting deposits recovered", ((data::ProxyTestAccount const*)proxy.getData())->deposits, 57L);
+            proxy.close();
+
+            // A crash in the middle of an append leaves a partial event.
+            std::ofstream log(proxy.getSegmentPath(5).c_str(), std::ios::out | std::ios::binary | std::ios::app);
+            log.write("xy", 2);
+        } while (false);
+
+        do
+        {
+            data::ProxyTestEventSourcedProxy proxy(path);
+            proxy.open();
+            ensure_equals("Expecting partial event dropped", proxy.getSequence(), (std::size_t)57);
+            proxy.deposit(1000);
+            balance += 1000;
+        } while (false);
+
+        data::ProxyTestEventSourcedProxy proxy(path);
+        proxy.open();
+        ensure_equals("Expecting appended event after recovery", proxy.getState().balance, balance);
+        ensure_equals("Expecting sequence after recovery", proxy.getSequence(), (std::size_t)58);
+
+        proxy.close();
+        std::remove(proxy.getSnapshotPath().c_str());
+
+        // Without the snapshot, the events of the deleted segments are lost.
+        do
+        {
+            data::ProxyTestEventSourcedProxy lost(path);
+            bool thrown = false;
+            try
+            {
+                lost.open();
+            }
+            catch (std::runtime_error const&)
+            {
+                thrown = true;
+            }
+            ensure("Expecting open to fail when segments remain without snapshot", thrown);
+            ensure("Expecting no new segment 0", std::ifstream(lost.getSegmentPath(0).c_str()).fail());
+        } while (false);
+
+        for (std::size_t segment = 0; segment <= 5; ++segment)
+            std::remove(proxy.getSegmentPath(segment).c_str());
+    }
+
+    template<> template<>
+    void object::test<11>(void)
+    {
+        set_test_name("testDerivedProxy");
+
+        int one = 1, two = 2, minus_two = -2;
+        Proxy first("ProxyTestFirst", &one);
+        Proxy second("ProxyTestSecond", &two);
+        data::ProxyTestSumProxy sum(first, second);
+        data::ProxyTestSignProxy sign(sum);
+
+        ensure_equals("Expecting sign of the sum", sign.getValue(), 1);
+        ensure_equals("Expecting sum computed once", sum.getComputeCount(), (std::size_t)1);
+        ensure_equals("Expecting sum value", sum.getValue(), 3);
+        ensure_equals("Expecting sign value", *(int const*)sign.getData(), 1);
+
+        sign.getValue();
+        sum.getValue();
+        ensure_equals("Expecting no computation without changes", sum.getComputeCount(), (std::size_t)1);
+        ensure_equals("Expecting sign computed once", sign.getComputeCount(), (std::size_t)1);
+
+        long revision = first.getRevision();
+        first.setData(&two);
+        ensure("Expecting setData to change the revision", first.getRevision() != revision);
+        ensure_equals("Expecting sign unchanged", sign.getValue(), 1);
+        ensure_equals("Expecting sum computed again", sum.getComputeCount(), (std::size_t)2);
+        ensure_equals("Expecting sign computed again", sign.getComputeCount(), (std::size_t)2);
+        ensure_equals("Expecting new sum", sum.getValue(), 4);
+
+        first.setData(&one);
+        second.setData(&minus_two);
+        ensure_equals("Expecting sign of negative sum", sign.getValue(), -1);
+        revision = sum.getRevision();
+
+        // Same sum from other inputs: the sign is not computed again.
+        first.setData(&minus_two);
+        second.setData(&one);
+        ensure_equals("Expecting sign unchanged", sign.getValue(), -1);
+        ensure_equals("Expecting unchanged sum to keep its revision", sum.getRevision(), revision);
+        ensure_equals("Expecting sign not computed for an unchanged sum", sign.getComputeCount(), (std::size_t)3);
+
+        // A failed computation leaves the inputs dirty.
+        sum.fail = true;
+        first.setData(&two);
+        bool thrown = false;
+        try
+        {
+            sum.getValue();
+        }
+        catch (std::runtime_error const&)
+        {
+            thrown = true;
+        }
+        ensure("Expecting compute to throw", thrown);
+        sum.fail = false;
+        ensure_equals("Expecting sum computed after the failure", sum.getValue(), 3);
+    }
+
+    template<> template<>
+    void object::test<12>(void)
+    {
+        set_test_name("testAsyncProxy");
+
+        IFacade& facade = Facade::getInstance("ProxyTestKey12");
+        data::ProxyTestAsyncListener listener;
+        View::getInstance("ProxyTestKey12").registerObserver("ProxyTestLoaded",
+            createObserver(&data::ProxyTestAsyncListener::handleLoaded, &listener));
+        View::getInstance("ProxyTestKey12").registerObserver("ProxyTestFailed",
+            createObserver(&data::ProxyTestAsyncListener::handleFailed, &listener));
+
+        std::vector<data::ProxyTestAsyncProxy*> proxies;
+        for (int i = 0; i < 8; ++i)
+        {
+            std::ostringstream name;
+            name << "ProxyTestAsync" << i;
+            proxies.push_back(new data::ProxyTestAsyncProxy(name.str(), i == 7));
+            facade.registerProxy(proxies.back());
+            ensure("Expecting registration not to wait for the load", !proxies.back()->isLoaded());
+        }
+
+        for (std::size_t i = 0; i < proxies.size(); ++i)
+            ensure("Expecting load to finish", proxies[i]->waitLoad(5000));
+        ensure("Expecting loads to run in parallel", data::ProxyTestAsyncProxy::peak > 1);
+        ensure("Expecting no more loads than loader threads", data::ProxyTestAsyncProxy::peak <= (long)AsyncProxy::getPoolSize());
+        ensure_equals("Expecting one loaded notification per proxy", listener.loaded, 7L);
+        ensure_equals("Expecting one failed notification", listener.failed, 1L);
+        ensure_equals("Expecting loaded data", *(int const*)proxies[0]->getData(), 42);
+        ensure_equals("Expecting loaded state", proxies[0]->getLoadState(), AsyncProxy::LOADED);
+        ensure_equals("Expecting failed state", proxies[7]->getLoadState(), AsyncProxy::FAILED);
+        ensure_equals("Expecting load error", proxies[7]->getError(), std::string("Broken proxy data."));
+
+        ensure("Expecting reload to be queued", proxies[7]->startLoad());
+        ensure("Expecting no second queued load", !proxies[7]->startLoad());
+        for (std::size_t i = 0; i < proxies.size(); ++i)
+        {
+            facade.removeProxy(proxies[i]->getProxyName());
+            delete proxies[i];
+        }
+        View::getInstance("ProxyTestKey12").removeObserver("ProxyTestLoaded", &listener);
+        View::getInstance("ProxyTestKey12").removeObserver("ProxyTestFailed", &listener);
+        Facade::removeCore("ProxyTestKey12");
+    }
+
+    template<> template<>
+    void object::test<13>(void)
+    {
+        set_test_name("testProxySnapshot");
+
+        char const* path = "ProxyTestSnapshot.bin";
+        data::ProxyTestSerializableProxy first("ProxyTestSnapshotFirst");
+        data::ProxyTestSerializableProxy second("ProxyTestSnapshotSecond");
+        Proxy plain("ProxyTestSnapshotPlain");
+        for (long i = 0; i < 1000; ++i)
+            first.values.push_back(i * 3);
+        second.values.push_back(-7);
+
+        IModel& model = Model::getInstance("ProxyTestKey13");
+        model.registerProxy(&first);
+        model.registerProxy(&second);
+        model.registerProxy(&plain);
+        model.registerProxyFactory("ProxyTestSnapshotLazy", createProxyFactory(&data::createProxyTestSerializableProxy));
+        ensure_equals("Expecting serializable proxies saved", ProxySnapshot::save(model, path), (std::size_t)2);
+        ensure_equals("Expecting existing snapshot replaced", ProxySnapshot::save(model, path), (std::size_t)2);
+        ensure("Expecting pending proxy not built by save", model.removeProxy("ProxyTestSnapshotLazy") == NULL);
+        model.removeProxy(first.getProxyName());
+        model.removeProxy(second.getProxyName());
+        model.removeProxy(plain.getProxyName());
+
+        // Warm restart: one proxy is registered, the other is built from the snapshot.
+        data::ProxyTestSerializableProxy restored_first("ProxyTestSnapshotFirst");
+        model.registerProxy(&restored_first);
+        do
+        {
+            ProxySnapshot snapshot(path);
+            ensure("Expecting snapshot opened", snapshot.isOpen());
+            ensure_equals("Expecting two proxies in snapshot", snapshot.getCount(), (std::size_t)2);
+            snapshot.registerFactory(data::ProxyTestSerializableProxy::SERIAL_TYPE,
+                createProxyFactory(&data::createProxyTestSerializableProxy));
+            ensure_equals("Expecting two proxies restored", snapshot.restore(model), (std::size_t)2);
+        } while (false);
+
+        ensure("Expecting registered proxy restored in place", restored_first.values == first.values);
+        ensure("Expecting aligned image", restored_first.aligned);
+        ensure("Expecting revision changed by restore", restored_first.getRevision() != 0);
+        IProxy* proxy = model.tryRetrieveProxy("ProxyTestSnapshotSecond");
+        ensure("Expecting missing proxy registered by restore", proxy != NULL);
+        data::ProxyTestSerializableProxy* restored_second = dynamic_cast<data::ProxyTestSerializableProxy*>(proxy);
+        ensure("Expecting proxy built by the factory", restored_second != NULL);
+        ensure("Expecting factory built proxy restored", restored_second->values == second.values);
+        ensure("Expecting plain proxy not saved", !model.hasProxy("ProxyTestSnapshotPlain"));
+
+        model.removeProxy("ProxyTestSnapshotSecond");
+        Proxy impostor("ProxyTestSnapshotSecond");
+        model.registerProxy(&impostor);
+        bool thrown = false;
+        try
+        {
+            ProxySnapshot snapshot(path);
+            snapshot.restore(model);
+        }
+        catch (std::exception const&)
+        {
+            thrown = true;
+        }
+        ensure("Expecting restore into a proxy which is not serializable to throw", thrown);
+
+        delete restored_second;
+        std::remove(path);
+        Model::removeModel("ProxyTestKey13");
+    }
+
+    template<> template<>
+    void object::test<14>(void)
+    {
+        set_test_name("testCachingProxy");
+
+        typedef data::ProxyTestCacheBackend Backend;
+        CachingProxy<int, int> proxy("ProxyTestCaching",
+            createCacheLoader<int, int>(&Backend::load), 2, -1, 60000);
+
+        // Concurrent misses on a cold key: one load.
+        std::list<Thread*> threads;
+        for (std::size_t i = 0; i < 8; ++i)
+            threads.push_back(new Thread(createCommand(&Backend::get)));
+        Notification notification("ProxyTestCaching", &proxy);
+        for (std::list<Thread*>::iterator iter = threads.begin(); iter != threads.end(); ++iter)
+            (*iter)->start(notification);
+        for (std::list<Thread*>::iterator iter = threads.begin(); iter != threads.end(); ++iter)
+        {
+            (*iter)->join();
+            delete *iter;
+        }
+        ensure_equals("Expecting every caller to get the value", Backend::correct, 8L);
+        ensure_equals("Expecting one load for concurrent misses", Backend::loads, 1L);
+        ensure_equals("Expecting one miss", proxy.getMissCount(), (std::size_t)1);
+
+        // Negative caching.
+        int value = 0;
+        ensure("Expecting missing key", !proxy.get(-1, value));
+        ensure("Expecting missing key cached", !proxy.get(-1, value));
+        ensure_equals("Expecting missing key loaded once", Backend::loads, 2L);
+
+        // Least recently used key evicted beyond capacity.
+        ensure("Expecting value", proxy.get(1, value));
+        ensure_equals("Expecting loaded value", value, 10);
+        ensure("Expecting least recently used key evicted", !proxy.contains(7));
+        ensure("Expecting used key kept", proxy.contains(-1));
+        ensure("Expecting new key kept", proxy.contains(1));
+        ensure_equals("Expecting size bounded by capacity", proxy.getSize(), (std::size_t)2);
+
+        // Failed loads are not cached.
+        bool thrown = false;
+        try
+        {
+            proxy.get(13, value);
+        }
+        catch (std::exception const&)
+        {
+            thrown = true;
+        }
+        ensure("Expecting load failure thrown", thrown);
+        ensure("Expecting failure not cached", !proxy.contains(13));
+
+        ensure("Expecting invalidated key", proxy.invalidate(1));
+        long loads = Backend::loads;
+        ensure("Expecting value reloaded", proxy.get(1, value));
+        ensure_equals("Expecting invalidated key loaded again", Backend::loads, loads + 1);
+
+        // Expiry.
+        CachingProxy<int, int> expiring("ProxyTestExpiring",
+            createCacheLoader<int, int>(&Backend::load), 16, 30);
+        expiring.get(2, value);
+        expiring.get(2, value);
+        ensure_equals("Expecting fresh value cached", Backend::loads, loads + 2);
+        Thread::sleep(60);
+        ensure("Expecting expired value", !expiring.contains(2));
+        expiring.get(2, value);
+        ensure_equals("Expecting expired value loaded again", Backend::loads, loads + 3);
+    }
+
+    template<> template<>
+    void object::test<15>(void)
+    {
+        set_test_name("testCollectionProxyIndexKinds");
+
+        typedef data::ProxyTestCollectionRecord Record;
+        typedef CollectionProxy<Record> Collection;
+        Collection hashed("ProxyTestHashed");
+        Collection sorted("ProxyTestSorted");
+        hashed.createIndex(&Record::volume, Collection::HASH_INDEX);
+        sorted.createIndex(&Record::volume, Collection::SORTED_INDEX);
+        hashed.createIndex(&Record::id, Collection::HASH_INDEX);
+        sorted.createIndex(&Record::id, Collection::SORTED_INDEX);
+        for (long i = 0; i < 1000; ++i)
+        {
+            hashed.addRecord(Record(i % 300));
+            sorted.addRecord(Record(i % 300));
+        }
+        for (std::size_t i = 0; i < 100; ++i)
+        {
+            Record changed((long)(i * 7));
+            hashed.setRecord(i * 3, changed);
+            sorted.setRecord(i * 3, changed);
+        }
+        for (std::size_t i = 0; i < 50; ++i)
+        {
+            hashed.removeRecord(i * 5);
+            sorted.removeRecord(i * 5);
+            hashed.removeRecordUnordered(i * 11);
+            sorted.removeRecordUnordered(i * 11);
+        }
+
+        std::vector<std::size_t> found;
+        std::vector<std::size_t> expected;
+        for (int volume = -51; volume <= 51; ++volume)
+        {
+            ensure_equals("Expecting the same count by volume",
+                hashed.findRecords(&Record::volume, volume, found),
+                sorted.findRecords(&Record::volume, volume, expected));
+            ensure("Expecting the same records by volume", found == expected);
+        }
+        for (long id = -1; id <= 700; ++id)
+        {
+            ensure_equals("Expecting the same count by id",
+                hashed.findRecords(&Record::id, id, found),
+                sorted.findRecords(&Record::id, id, expected));
+            ensure("Expecting the same records by id", found == expected);
+        }
+        std::size_t hashed_index = 0;
+        std::size_t sorted_index = 0;
+        ensure("Expecting a record found by hash", hashed.findRecord(&Record::id, 42L, hashed_index));
+        ensure("Expecting a record found by sort", sorted.findRecord(&Record::id, 42L, sorted_index));
+        ensure_equals("Expecting the same first record", hashed_index, sorted_index);
+    }
 }
@@ -0,0 +1,88 @@
+//  ProxyTestAsyncProxy.hpp
+//  PureMVC_C++ Test suite
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PROXY_TEST_ASYNC_PROXY_HPP__)
+#define __PROXY_TEST_ASYNC_PROXY_HPP__
+
+#include <stdexcept>
+#include <PureMVC/PureMVC.hpp>
+
+namespace data
+{
+    using PureMVC::Interfaces::INotification;
+    using PureMVC::Patterns::AsyncProxy;
+
+    /**
+     * An AsyncProxy whose load takes a while, counting concurrent loads.
+     */
+    struct ProxyTestAsyncProxy: public AsyncProxy
+    {
+        static long volatile concurrent;
+        static long volatile peak;
+
+        int value;
+        bool fail;
+
+        ProxyTestAsyncProxy(std::string const& name, bool fail = false)
+            : AsyncProxy(name, "ProxyTestLoaded", "ProxyTestFailed")
+            , value(0)
+            , fail(fail)
+        { }
+
+        virtual void load(void)
+        {
+            long count = PureMVC::atomicIncrement(&concurrent);
+            long previous;
+            while ((previous = PureMVC::atomicLoad(&peak)) < count
+                   && PureMVC::atomicCompareExchange(&peak, count, previous) != previous)
+                ;
+            PureMVC::Thread::sleep(50);
+            PureMVC::atomicDecrement(&concurrent);
+            if (fail)
+                throw std::runtime_error("Broken proxy data.");
+            value = 42;
+            setData(&value);
+        }
+
+        ~ProxyTestAsyncProxy(void)
+        {
+            cancelLoad();
+        }
+    };
+
+    long volatile ProxyTestAsyncProxy::concurrent = 0;
+    long volatile ProxyTestAsyncProxy::peak = 0;
+
+    /**
+     * Observer counting completion notifications, sent from loader threads.
+     */
+    struct ProxyTestAsyncListener
+    {
+        long volatile loaded;
+        long volatile failed;
+
+        ProxyTestAsyncListener()
+            : loaded(0)
+            , failed(0)
+        { }
+
+        void handleLoaded(INotification const& notification)
+        {
+            AsyncProxy const* proxy = dynamic_cast<AsyncProxy const*>((PureMVC::Interfaces::IProxy const*)notification.getBody());
+            if (proxy != NULL && proxy->isLoaded())
+                PureMVC::atomicIncrement(&loaded);
+        }
+
+        void handleFailed(INotification const&)
+        {
+            PureMVC::atomicIncrement(&failed);
+        }
+    };
+}
+
+#endif /* __PROXY_TEST_ASYNC_PROXY_HPP__ */
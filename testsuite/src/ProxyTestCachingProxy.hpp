@@ -0,0 +1,55 @@
+//  ProxyTestCachingProxy.hpp
+//  PureMVC_C++ Test suite
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PROXY_TEST_CACHING_PROXY_HPP__)
+#define __PROXY_TEST_CACHING_PROXY_HPP__
+
+#include <stdexcept>
+#include <PureMVC/PureMVC.hpp>
+
+namespace data
+{
+    using PureMVC::Patterns::CachingProxy;
+    using PureMVC::Interfaces::INotification;
+
+    /**
+     * A slow backend: the value of a key is ten times the key, negative keys
+     * have no value and 13 fails.
+     */
+    struct ProxyTestCacheBackend
+    {
+        static long volatile loads;
+        static long volatile correct;
+
+        static bool load(int const& key, int& value)
+        {
+            PureMVC::atomicIncrement(&loads);
+            // widen the window for concurrent misses
+            PureMVC::Thread::sleep(20);
+            if (key == 13)
+                throw std::runtime_error("Backend failure.");
+            if (key < 0)
+                return false;
+            value = key * 10;
+            return true;
+        }
+
+        static void get(INotification const& notification)
+        {
+            CachingProxy<int, int>& proxy = *(CachingProxy<int, int>*)notification.getBody();
+            int value = 0;
+            if (proxy.get(7, value) && value == 70)
+                PureMVC::atomicIncrement(&correct);
+        }
+    };
+
+    long volatile ProxyTestCacheBackend::loads = 0;
+    long volatile ProxyTestCacheBackend::correct = 0;
+}
+
+#endif /* __PROXY_TEST_CACHING_PROXY_HPP__ */
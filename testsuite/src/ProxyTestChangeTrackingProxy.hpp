@@ -0,0 +1,78 @@
+//  ProxyTestChangeTrackingProxy.hpp
+//  PureMVC_C++ Test suite
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PROXY_TEST_CHANGE_TRACKING_PROXY_HPP__)
+#define __PROXY_TEST_CHANGE_TRACKING_PROXY_HPP__
+
+#include <PureMVC/PureMVC.hpp>
+
+namespace data
+{
+    using PureMVC::Interfaces::INotification;
+    using PureMVC::Patterns::ChangeTrackingProxy;
+
+    /**
+     * A ChangeTrackingProxy with two fields and a list of records.
+     */
+    struct ProxyTestChangeTrackingProxy: public ChangeTrackingProxy
+    {
+        enum { NAME_FIELD = 0, AGE_FIELD = 1 };
+
+        std::string name;
+        int age;
+
+        ProxyTestChangeTrackingProxy()
+            : ChangeTrackingProxy("ProxyTestChangeTrackingProxy", "ProxyTestChanged")
+            , age(0)
+        { }
+
+        void setName(std::string const& value)
+        {
+            name = value;
+            markChanged(NAME_FIELD);
+        }
+
+        void setAge(int value)
+        {
+            age = value;
+            markChanged(AGE_FIELD);
+        }
+
+        void updateRecord(unsigned long id)
+        {
+            markRecordChanged(id);
+        }
+    };
+
+    /**
+     * Observer keeping the last change set.
+     */
+    struct ProxyTestChangeListener
+    {
+        int count;
+        unsigned long fields;
+        std::vector<unsigned long> records;
+        std::string type;
+
+        ProxyTestChangeListener()
+            : count(0)
+            , fields(0)
+        { }
+
+        void handleChange(INotification const& notification)
+        {
+            ChangeTrackingProxy::ChangeSet const& change_set = *(ChangeTrackingProxy::ChangeSet const*)notification.getBody();
+            ++count;
+            fields = change_set.fields;
+            records = change_set.records;
+            type = notification.getType();
+        }
+    };
+}
+
+#endif /* __PROXY_TEST_CHANGE_TRACKING_PROXY_HPP__ */
@@ -0,0 +1,42 @@
+//  ProxyTestCollectionRecord.hpp
+//  PureMVC_C++ Test suite
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PROXY_TEST_COLLECTION_RECORD_HPP__)
+#define __PROXY_TEST_COLLECTION_RECORD_HPP__
+
+namespace data
+{
+    /**
+     * A record stored column by column in a CollectionProxy.
+     */
+    struct ProxyTestCollectionRecord
+    {
+        double price;
+        float quantity;
+        int volume;
+        long id;
+
+        explicit ProxyTestCollectionRecord(long value = 0)
+            : price(value * 0.5)
+            , quantity((float)(value % 17) - 8.0f)
+            , volume((int)((value * 37) % 101) - 50)
+            , id(value)
+        { }
+
+        template<typename _Visitor>
+        static void describe(_Visitor& visitor)
+        {
+            visitor(&ProxyTestCollectionRecord::price);
+            visitor(&ProxyTestCollectionRecord::quantity);
+            visitor(&ProxyTestCollectionRecord::volume);
+            visitor(&ProxyTestCollectionRecord::id);
+        }
+    };
+}
+
+#endif /* __PROXY_TEST_COLLECTION_RECORD_HPP__ */
@@ -0,0 +1,70 @@
+//  ProxyTestDerivedProxy.hpp
+//  PureMVC_C++ Test suite
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PROXY_TEST_DERIVED_PROXY_HPP__)
+#define __PROXY_TEST_DERIVED_PROXY_HPP__
+
+#include <PureMVC/PureMVC.hpp>
+
+namespace data
+{
+    using PureMVC::Patterns::Proxy;
+    using PureMVC::Patterns::DerivedProxy;
+
+    /**
+     * The sum of the integers held by two proxies.
+     */
+    struct ProxyTestSumProxy: public DerivedProxy<int>
+    {
+        Proxy const& first;
+        Proxy const& second;
+        bool fail;
+
+        ProxyTestSumProxy(Proxy const& first, Proxy const& second)
+            : DerivedProxy<int>("ProxyTestSumProxy")
+            , first(first)
+            , second(second)
+            , fail(false)
+        {
+            addInput(first);
+            addInput(second);
+        }
+
+    protected:
+        virtual void compute(int& value)
+        {
+            if (fail)
+                throw std::runtime_error("Cannot compute sum.");
+            value = *(int const*)first.getData() + *(int const*)second.getData();
+        }
+    };
+
+    /**
+     * The sign of a sum, derived from another derived proxy.
+     */
+    struct ProxyTestSignProxy: public DerivedProxy<int>
+    {
+        ProxyTestSumProxy& sum;
+
+        explicit ProxyTestSignProxy(ProxyTestSumProxy& sum)
+            : DerivedProxy<int>("ProxyTestSignProxy")
+            , sum(sum)
+        {
+            addInput(sum);
+        }
+
+    protected:
+        virtual void compute(int& value)
+        {
+            int total = sum.getValue();
+            value = total > 0 ? 1 : (total < 0 ? -1 : 0);
+        }
+    };
+}
+
+#endif /* __PROXY_TEST_DERIVED_PROXY_HPP__ */
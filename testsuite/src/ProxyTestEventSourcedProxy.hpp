@@ -0,0 +1,54 @@
+//  ProxyTestEventSourcedProxy.hpp
+//  PureMVC_C++ Test suite
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PROXY_TEST_EVENT_SOURCED_PROXY_HPP__)
+#define __PROXY_TEST_EVENT_SOURCED_PROXY_HPP__
+
+#include <PureMVC/PureMVC.hpp>
+
+namespace data
+{
+    using PureMVC::Patterns::EventSourcedProxy;
+
+    struct ProxyTestDeposit
+    {
+        long amount;
+    };
+
+    struct ProxyTestAccount
+    {
+        long balance;
+        long deposits;
+    };
+
+    /**
+     * An account rebuilt from its deposits.
+     */
+    struct ProxyTestEventSourcedProxy: public EventSourcedProxy<ProxyTestDeposit, ProxyTestAccount>
+    {
+        ProxyTestEventSourcedProxy(std::string const& path)
+            : EventSourcedProxy<ProxyTestDeposit, ProxyTestAccount>("ProxyTestEventSourcedProxy", path, 10, 25)
+        { }
+
+        void deposit(long amount)
+        {
+            ProxyTestDeposit event;
+            event.amount = amount;
+            append(event);
+        }
+
+    protected:
+        virtual void apply(ProxyTestAccount& state, ProxyTestDeposit const& event)
+        {
+            state.balance += event.amount;
+            ++state.deposits;
+        }
+    };
+}
+
+#endif /* __PROXY_TEST_EVENT_SOURCED_PROXY_HPP__ */
@@ -0,0 +1,67 @@
+//  ProxyTestSerializableProxy.hpp
+//  PureMVC_C++ Test suite
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PROXY_TEST_SERIALIZABLE_PROXY_HPP__)
+#define __PROXY_TEST_SERIALIZABLE_PROXY_HPP__
+
+#include <vector>
+#include <cstring>
+#include <PureMVC/PureMVC.hpp>
+
+namespace data
+{
+    using PureMVC::Interfaces::ISerializable;
+    using PureMVC::Patterns::Proxy;
+
+    /**
+     * A proxy saving its values to a snapshot.
+     */
+    struct ProxyTestSerializableProxy: public Proxy, public ISerializable
+    {
+        enum { SERIAL_TYPE = 11 };
+
+        std::vector<long> values;
+        bool aligned;
+
+        explicit ProxyTestSerializableProxy(std::string const& name)
+            : Proxy(name)
+            , aligned(false)
+        { }
+
+        virtual unsigned int getSerialType(void) const
+        {
+            return SERIAL_TYPE;
+        }
+
+        virtual std::size_t getSerializedSize(void) const
+        {
+            return values.size() * sizeof(long);
+        }
+
+        virtual void serialize(void* buffer) const
+        {
+            if (!values.empty())
+                std::memcpy(buffer, &values[0], values.size() * sizeof(long));
+        }
+
+        virtual void deserialize(void const* data, std::size_t size)
+        {
+            aligned = ((std::size_t)data % 8) == 0;
+            long const* begin = (long const*)data;
+            values.assign(begin, begin + size / sizeof(long));
+            setData(&values);
+        }
+    };
+
+    inline PureMVC::Interfaces::IProxy* createProxyTestSerializableProxy(std::string const& name)
+    {
+        return new ProxyTestSerializableProxy(name);
+    }
+}
+
+#endif /* __PROXY_TEST_SERIALIZABLE_PROXY_HPP__ */
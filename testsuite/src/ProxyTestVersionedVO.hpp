@@ -0,0 +1,54 @@
+//  ProxyTestVersionedVO.hpp
+//  PureMVC_C++ Test suite
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__PROXY_TEST_VERSIONED_VO_HPP__)
+#define __PROXY_TEST_VERSIONED_VO_HPP__
+
+#include <PureMVC/PureMVC.hpp>
+
+namespace data
+{
+    /**
+     * A value whose two fields must always be seen together,
+     * counting its live instances.
+     */
+    struct ProxyTestVersionedVO
+    {
+        static long volatile instances;
+        long first;
+        long second;
+
+        explicit ProxyTestVersionedVO(long value = 0)
+            : first(value)
+            , second(-value)
+        {
+            PureMVC::atomicIncrement(&instances);
+        }
+
+        ProxyTestVersionedVO(ProxyTestVersionedVO const& arg)
+            : first(arg.first)
+            , second(arg.second)
+        {
+            PureMVC::atomicIncrement(&instances);
+        }
+
+        bool isConsistent(void) const
+        {
+            return first == -second;
+        }
+
+        ~ProxyTestVersionedVO(void)
+        {
+            PureMVC::atomicDecrement(&instances);
+        }
+    };
+
+    long volatile ProxyTestVersionedVO::instances = 0;
+}
+
+#endif /* __PROXY_TEST_VERSIONED_VO_HPP__ */
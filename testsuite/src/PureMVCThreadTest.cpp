@@ -19,6 +19,24 @@ namespace data
 {
     struct PureMVCThreadTest
     { };
+
+    long volatile timer_test_count = 0;
+    long volatile timer_test_last = 0;
+
+    struct TimerTestAction {
+        static void execute(PureMVC::Interfaces::INotification const& notification) {
+            PureMVC::atomicExchange(&timer_test_last, *(int const*)notification.getBody());
+            PureMVC::atomicIncrement(&timer_test_count);
+        }
+    };
+
+    struct SlowTimerTestAction {
+        static void execute(PureMVC::Interfaces::INotification const& notification) {
+            (void)notification;
+            PureMVC::atomicIncrement(&timer_test_count);
+            PureMVC::Thread::sleep(50);
+        }
+    };
 }
 
 namespace testgroup
@@ -33,6 +51,10 @@ namespace tut
     using namespace testgroup;
 
     using PureMVC::Thread;
+    using PureMVC::Timer;
+    using PureMVC::Interfaces::ICommand;
+    using PureMVC::Patterns::createThrottledCommand;
+    using PureMVC::Patterns::createDebouncedCommand;
     using PureMVC::Interfaces::INotification;
     using PureMVC::Patterns::Notification;
     using PureMVC::Patterns::DelegateCommand;
@@ -220,4 +242,137 @@ namespace tut
 
         ensure_equals("Expecting value == 4", value, 4);
     }
+
+    template<> template<> 
+    void puremvc_thread_test_t::object::test<6>(void)
+    {
+        set_test_name("testTimerScheduleAndCancel");
+
+        DelegateCommand<void(*)(INotification const&)> command(data::TimerTestAction::execute);
+        data::timer_test_count = 0;
+        int value = 7;
+
+        Timer& timer = Timer::getInstance();
+        Timer::TimerId once = timer.schedule(command, new Notification("", &value), 20);
+        Timer::TimerId cancelled = timer.schedule(command, new Notification("", &value), 5000);
+        ensure("Expecting distinct timer ids", once != cancelled && once != 0);
+        ensure("Expecting cancel return true", timer.cancel(cancelled));
+        ensure("Expecting second cancel return false", !timer.cancel(cancelled));
+
+        Thread::sleep(300);
+        ensure_equals("Expecting one execution", data::timer_test_count, 1L);
+        ensure_equals("Expecting last == 7", data::timer_test_last, 7L);
+        ensure("Expecting fired timer cannot be cancelled", !timer.cancel(once));
+
+        data::timer_test_count = 0;
+        Timer::TimerId periodic = timer.schedule(command, new Notification("", &value), 10, 10);
+        Thread::sleep(300);
+        ensure("Expecting cancel periodic return true", timer.cancel(periodic));
+        long count = data::timer_test_count;
+        ensure("Expecting several periodic executions", count >= 3);
+        Thread::sleep(100);
+        ensure_equals("Expecting no execution after cancel", data::timer_test_count, count);
+        ensure_equals("Expecting no pending timer", timer.getPendingCount(), (std::size_t)0);
+    }
+
+    template<> template<> 
+    void puremvc_thread_test_t::object::test<7>(void)
+    {
+        set_test_name("testThrottledAndDebouncedCommand");
+
+        DelegateCommand<void(*)(INotification const&)> command(data::TimerTestAction::execute);
+
+        int values[10];
+        for (int i = 0; i < 10; ++i)
+            values[i] = i;
+
+        data::timer_test_count = 0;
+        ICommand* throttled = createThrottledCommand(&command, 2, 200);
+        for (int i = 0; i < 10; ++i)
+        {
+            Notification note("", &values[i]);
+            throttled->execute(note);
+        }
+        ensure_equals("Expecting 2 immediate executions", data::timer_test_count, 2L);
+        ensure_equals("Expecting last == 1", data::timer_test_last, 1L);
+        Thread::sleep(500);
+        ensure_equals("Expecting trailing execution", data::timer_test_count, 3L);
+        ensure_equals("Expecting last == 9", data::timer_test_last, 9L);
+        delete throttled;
+
+        data::timer_test_count = 0;
+        ICommand* debounced = createDebouncedCommand(&command, 50);
+        for (int i = 0; i < 10; ++i)
+        {
+            values[i] = i + 100;
+            Notification note("", &values[i]);
+            debounced->execute(note);
+        }
+        ensure_equals("Expecting no immediate execution", data::timer_test_count, 0L);
+        Thread::sleep(400);
+        ensure_equals("Expecting one execution", data::timer_test_count, 1L);
+        ensure_equals("Expecting last == 109", data::timer_test_last, 109L);
+        delete debounced;
+    }
+
+    template<> template<> 
+    void puremvc_thread_test_t::object::test<8>(void)
+    {
+        set_test_name("testTimerManyPendingTimers");
+
+        DelegateCommand<void(*)(INotification const&)> command(data::TimerTestAction::execute);
+        int value = 1;
+
+        Timer& timer = Timer::getInstance();
+        std::vector<Timer::TimerId> ids;
+        for (long i = 0; i < 200000; ++i)
+            ids.push_back(timer.schedule(command, new Notification("", &value), 60000 + i * 7));
+        ensure_equals("Expecting 200000 pending timers", timer.getPendingCount(), (std::size_t)200000);
+
+        for (std::size_t i = 0; i < ids.size(); ++i)
+            ensure("Expecting cancel return true", timer.cancel(ids[i]));
+        ensure_equals("Expecting no pending timer", timer.getPendingCount(), (std::size_t)0);
+
+        // the last cancelled entry is recycled first, but does not answer to the identifier of the timer it replaced
+        Timer::TimerId recycled = timer.schedule(command, new Notification("", &value), 60000);
+        ensure("Expecting recycled identifier differs", recycled != ids.back());
+        ensure("Expecting old identifier cannot be cancelled", !timer.cancel(ids.back()));
+        ensure_equals("Expecting recycled timer pending", timer.getPendingCount(), (std::size_t)1);
+        ensure("Expecting cancel return true", timer.cancel(recycled));
+    }
+
+    template<> template<>
+    void puremvc_thread_test_t::object::test<9>(void)
+    {
+        set_test_name("testTimerCancelAll");
+
+        DelegateCommand<void(*)(INotification const&)> command(data::TimerTestAction::execute);
+        DelegateCommand<void(*)(INotification const&)> other(data::TimerTestAction::execute);
+        DelegateCommand<void(*)(INotification const&)> slow(data::SlowTimerTestAction::execute);
+        data::timer_test_count = 0;
+        int value = 3;
+
+        // the idle timer thread is woken by a schedule
+        Timer& timer = Timer::getInstance();
+        Thread::sleep(50);
+        timer.schedule(command, new Notification("", &value), 5000);
+        timer.schedule(command, new Notification("", &value), 6000, 100);
+        timer.schedule(other, new Notification("", &value), 20);
+        ensure_equals("Expecting two timers cancelled", timer.cancelAll(command), (std::size_t)2);
+        ensure_equals("Expecting nothing left to cancel", timer.cancelAll(command), (std::size_t)0);
+        ensure_equals("Expecting the other timer pending", timer.getPendingCount(), (std::size_t)1);
+        Thread::sleep(300);
+        ensure_equals("Expecting the other timer executed", data::timer_test_count, 1L);
+
+        // cancelling an executing timer returns once its execution ends
+        data::timer_test_count = 0;
+        timer.schedule(slow, new Notification("", &value), 10, 10);
+        while (data::timer_test_count == 0)
+            Thread::sleep(1);
+        ensure_equals("Expecting the executing timer cancelled", timer.cancelAll(slow), (std::size_t)1);
+        long count = data::timer_test_count;
+        Thread::sleep(100);
+        ensure_equals("Expecting no execution after cancelAll", data::timer_test_count, count);
+        ensure_equals("Expecting no pending timer", timer.getPendingCount(), (std::size_t)0);
+    }
 }
@@ -11,6 +11,10 @@
 #pragma warning( disable : 4355 ) // The this pointer is valid only within nonstatic member functions. It cannot be used in the initializer list for a base class.ck(16)
 #endif
 
+#include <vector>
+#include <cstdio>
+#include <algorithm>
+#include <sstream>
 #include <tut/tut.hpp>
 #include <tut_reporter.h>
 #include <PureMVC/PureMVC.hpp>
@@ -24,6 +28,7 @@
 #include "ViewTestMediator4.hpp"
 #include "ViewTestMediator5.hpp"
 #include "ViewTestMediator6.hpp"
+#include "ViewTestStaticMediator.hpp"
 
 namespace data
 {
@@ -639,19 +644,15 @@ namespace tut
 
             // Reset again iterator
             iterator->reset();
-            // Move next to counter item
-            ensure("Expecting iterator->moveNext() == true", iterator->moveNext());
-#if !defined(PUREMVC_USES_TR1)
-            ensure_equals("Expecting iterator->getCurrent() == ViewTestMediator2", iterator->getCurrent(), data::ViewTestMediator2::NAME);
-#endif
-            ensure("Expecting iterator->moveNext() == true", iterator->moveNext());
-#if !defined(PUREMVC_USES_TR1)
-            ensure_equals( "Expecting iterator->getCurrent() == ViewTestMediator4", iterator->getCurrent(), data::ViewTestMediator4::NAME);
-#endif
-            ensure("Expecting iterator->moveNext() == true", iterator->moveNext());
-#if !defined(PUREMVC_USES_TR1)
-            ensure_equals( "Expecting iterator->getCurrent() == ViewTestMediator6", iterator->getCurrent(), data::ViewTestMediator6::NAME);
-#endif
+            // The names are hashed, collect them in order
+            std::vector<std::string> names;
+            while(iterator->moveNext())
+                names.push_back(iterator->getCurrent());
+            std::sort(names.begin(), names.end());
+            ensure_equals("Expecting 3 names", names.size(), (std::size_t)3);
+            ensure_equals("Expecting names[0] == ViewTestMediator2", names[0], data::ViewTestMediator2::NAME);
+            ensure_equals("Expecting names[1] == ViewTestMediator4", names[1], data::ViewTestMediator4::NAME);
+            ensure_equals("Expecting names[2] == ViewTestMediator6", names[2], data::ViewTestMediator6::NAME);
             ensure("Expecting iterator->moveNext() == false", iterator->moveNext() == false);
 
             bool bool_exception = false;
@@ -726,4 +727,141 @@ namespace tut
             iter = threads.begin();
         }
     }
+
+    template<> template<>
+    void object::test<15>(void)
+    {
+        set_test_name("testTryRetrieveMediator");
+
+        IView& view = View::getInstance("ViewTestKey15");
+
+        Mediator mediator("TryRetrieveMediator", this);
+        view.registerMediator(&mediator);
+
+        ensure("Expecting view.tryRetrieveMediator('TryRetrieveMediator') == &mediator",
+               view.tryRetrieveMediator("TryRetrieveMediator") == &mediator);
+        IView const& const_view = view;
+        ensure("Expecting const view.tryRetrieveMediator('TryRetrieveMediator') == &mediator",
+               const_view.tryRetrieveMediator("TryRetrieveMediator") == &mediator);
+        ensure("Expecting view.tryRetrieveMediator('Unknown') == NULL",
+               view.tryRetrieveMediator("Unknown") == NULL);
+
+        view.removeMediator("TryRetrieveMediator");
+        ensure("Expecting view.tryRetrieveMediator('TryRetrieveMediator') == NULL after removal",
+               view.tryRetrieveMediator("TryRetrieveMediator") == NULL);
+        View::removeView("ViewTestKey15");
+    }
+
+    template<> template<>
+    void object::test<16>(void)
+    {
+        set_test_name("testStaticNotificationInterests");
+
+        IView& view = View::getInstance("ViewTestKey16");
+
+        std::vector<data::ViewTestStaticMediator*> mediators;
+        for (int i = 0; i < 100; ++i)
+        {
+            std::ostringstream name;
+            name << "ViewTestStaticMediator" << i;
+            mediators.push_back(new data::ViewTestStaticMediator(name.str()));
+            view.registerMediator(mediators.back());
+        }
+
+        Notification first("ViewTestStaticNote1");
+        Notification second("ViewTestStaticNote2");
+        view.notifyObservers(first);
+        view.notifyObservers(second);
+        for (std::size_t i = 0; i < mediators.size(); ++i)
+            ensure_equals("Expecting both static interests notified", mediators[i]->handled, 2);
+
+        for (std::size_t i = 0; i < mediators.size(); ++i)
+            ensure("Expecting removed mediator", view.removeMediator(mediators[i]->getMediatorName()) == mediators[i]);
+        view.notifyObservers(first);
+        for (std::size_t i = 0; i < mediators.size(); ++i)
+        {
+            ensure_equals("Expecting no notification after removal", mediators[i]->handled, 2);
+            delete mediators[i];
+        }
+        ensure_equals("Expecting the interest list never built", data::ViewTestStaticMediator::listed, 0L);
+        View::removeView("ViewTestKey16");
+    }
+
+    template<> template<>
+    void object::test<17>(void)
+    {
+        set_test_name("testFlatHashMap");
+
+        typedef PureMVC::Core::FlatHashMap<int> map_t;
+        map_t map;
+        ensure("Expecting find in an empty map to fail", map.find("none") == map.end());
+
+        char name[32];
+        for (int i = 0; i < 1000; ++i)
+        {
+            sprintf(name, "Key%d", i);
+            ensure("Expecting insert to add the key", map.insert(map_t::value_type(name, i)).second);
+        }
+        ensure_equals("Expecting 1000 entries", map.size(), (std::size_t)1000);
+        ensure("Expecting a second insert to keep the key", !map.insert(map_t::value_type("Key7", -1)).second);
+        ensure_equals("Expecting the first value to be kept", map.find("Key7")->second, 7);
+
+        // erase every third key, moving entries and shifting slots
+        for (int i = 0; i < 1000; i += 3)
+        {
+            sprintf(name, "Key%d", i);
+            map.erase(map.find(std::string(name)));
+        }
+        ensure_equals("Expecting 666 entries", map.size(), (std::size_t)666);
+        for (int i = 0; i < 1000; ++i)
+        {
+            int length = sprintf(name, "Key%d", i);
+            // looked up without building a string
+            map_t::const_iterator result = map.find(name, (std::size_t)length);
+            if (i % 3 == 0)
+                ensure("Expecting the erased key to be missing", result == map.end());
+            else
+                ensure("Expecting the key to map to its value", result != map.end() && result->second == i);
+        }
+
+        map["Key0"] = 42;
+        ensure_equals("Expecting operator[] to insert", map.find("Key0")->second, 42);
+        std::size_t buckets = map.bucket_count();
+        map.reserve(10);
+        ensure_equals("Expecting reserve not to shrink", map.bucket_count(), buckets);
+        map.clear();
+        ensure("Expecting clear to empty the map", map.empty() && map.find("Key1") == map.end());
+    }
+
+    template<> template<>
+    void object::test<18>(void)
+    {
+        set_test_name("testObserverReservation");
+
+        data::ViewTestInheritance& view = data::ViewTestInheritance::getInstance();
+
+        std::vector<data::ViewTestStaticMediator*> mediators;
+        std::vector<PureMVC::Interfaces::IMediator*> registered;
+        for (int i = 0; i < 100; ++i)
+        {
+            std::ostringstream name;
+            name << "ViewTestReservedMediator" << i;
+            mediators.push_back(new data::ViewTestStaticMediator(name.str()));
+            registered.push_back(mediators.back());
+        }
+        view.registerMediators(&registered[0], registered.size());
+        // 200 observers share two names, the table is sized by names
+        ensure("Expecting the observer table sized by notification names", view.getObserverSlots() < 64);
+
+        Notification first("ViewTestStaticNote1");
+        Notification second("ViewTestStaticNote2");
+        view.notifyObservers(first);
+        view.notifyObservers(second);
+        for (std::size_t i = 0; i < mediators.size(); ++i)
+        {
+            ensure_equals("Expecting both static interests notified", mediators[i]->handled, 2);
+            view.removeMediator(mediators[i]->getMediatorName());
+            delete mediators[i];
+        }
+    }
 }
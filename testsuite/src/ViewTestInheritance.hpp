@@ -34,6 +34,11 @@ namespace data
                 new ViewTestInheritance();
             return *(dynamic_cast<ViewTestInheritance*>(&View::getInstance("ViewTestInheritance")));
         }
+
+        std::size_t getObserverSlots(void) const
+        {
+            return _observer_map.bucket_count();
+        }
     protected:
         void initializeView(void)
         {
@@ -0,0 +1,53 @@
+//  ViewTestStaticMediator.hpp
+//  PureMVC_C++ Test suite
+//
+//  PureMVC Port to C++ by Tang Khai Phuong <phuong.tang@puremvc.org>
+//  PureMVC - Copyright(c) 2006-2011 Futurescale, Inc., Some rights reserved.
+//  Your reuse is governed by the Creative Commons Attribution 3.0 License
+//
+
+#if !defined(__VIEW_TEST_STATIC_MEDIATOR_HPP__)
+#define __VIEW_TEST_STATIC_MEDIATOR_HPP__
+
+#include <string>
+#include <PureMVC/PureMVC.hpp>
+
+namespace data
+{
+    using PureMVC::Interfaces::INotification;
+    using PureMVC::Patterns::Mediator;
+
+    /**
+     * A Mediator declaring its interests as a static array.
+     */
+    struct ViewTestStaticMediator : public Mediator
+    {
+        static std::string const INTERESTS[2];
+        static long volatile listed;
+        int handled;
+
+        explicit ViewTestStaticMediator(std::string const& name)
+            :Mediator(name)
+            ,handled(0)
+        {
+            setNotificationInterests(INTERESTS);
+        }
+
+        virtual NotificationNames listNotificationInterests(void) const
+        {
+            PureMVC::atomicIncrement(&listed);
+            return Mediator::listNotificationInterests();
+        }
+
+        virtual void handleNotification(INotification const& notification)
+        {
+            (void)notification;
+            ++handled;
+        }
+    };
+
+    std::string const ViewTestStaticMediator::INTERESTS[2] = { "ViewTestStaticNote1", "ViewTestStaticNote2" };
+    long volatile ViewTestStaticMediator::listed = 0;
+}
+
+#endif /* __VIEW_TEST_STATIC_MEDIATOR_HPP__ */